@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// AES-CBC decryption benchmark for the PKG NP entries and the trophy EFSM files. Checks the
+// CBC kernel against the NIST SP 800-38A vectors, then measures the throughput of
+// Crypto::aesCbcCfb128DecryptEntry, aesCbcCfb128Decrypt and decryptEFSM on random data.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+
+#include "common/crypto.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr double MiB = 1024.0 * 1024.0;
+
+struct BenchOptions {
+    u32 trophy_files = 512;   // EFSM files of a large trophy set
+    u32 efsm_kib = 64;        // Size of one EFSM file
+    u32 np_entries = 4096;    // NP entries (0x400-0x403 are a few KiB each)
+    u32 np_entry_size = 4096; // Size of one NP entry
+    u32 runs = 5;
+};
+
+void PrintUsage() {
+    fmt::print("Usage: crypto_bench [options]\n"
+               "  --trophy-files <n>     EFSM files per trophy set (default 512)\n"
+               "  --efsm-kib <n>         size of one EFSM file in KiB (default 64)\n"
+               "  --np-entries <n>       number of NP entries (default 4096)\n"
+               "  --np-entry-size <n>    size of one NP entry in bytes (default 4096)\n"
+               "  --runs <n>             timed runs, the best one is reported (default 5)\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : ""; };
+
+        bool ok = true;
+        if (arg == "--trophy-files") {
+            ok = ParseNumber(next(), options.trophy_files) && options.trophy_files > 0;
+        } else if (arg == "--efsm-kib") {
+            ok = ParseNumber(next(), options.efsm_kib) && options.efsm_kib > 0;
+        } else if (arg == "--np-entries") {
+            ok = ParseNumber(next(), options.np_entries) && options.np_entries > 0;
+        } else if (arg == "--np-entry-size") {
+            ok = ParseNumber(next(), options.np_entry_size) && options.np_entry_size >= 16;
+        } else if (arg == "--runs") {
+            ok = ParseNumber(next(), options.runs) && options.runs > 0;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fmt::print(stderr, "Invalid argument: {}\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<u8> RandomBytes(size_t size, u32 seed) {
+    std::mt19937 rng(seed);
+    std::vector<u8> data(size);
+    std::generate(data.begin(), data.end(), [&] { return static_cast<u8>(rng()); });
+    return data;
+}
+
+// NIST SP 800-38A F.2.2, CBC-AES128.Decrypt
+bool CheckKnownAnswer(Crypto& crypto) {
+    constexpr std::array<u8, 32> ivkey = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e,
+        0x0f, 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf,
+        0x4f, 0x3c,
+    };
+    constexpr std::array<u8, 64> ciphertext = {
+        0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19,
+        0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76,
+        0x78, 0xb2, 0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22,
+        0x22, 0x95, 0x16, 0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30,
+        0x75, 0x86, 0xe1, 0xa7,
+    };
+    constexpr std::array<u8, 64> plaintext = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17,
+        0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf,
+        0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a,
+        0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b,
+        0xe6, 0x6c, 0x37, 0x10,
+    };
+
+    std::array<u8, 64> input = ciphertext;
+    std::array<u8, 64> output{};
+    crypto.aesCbcCfb128DecryptEntry(ivkey, input, output);
+    if (output != plaintext) {
+        fmt::print(stderr, "Known answer test failed\n");
+        return false;
+    }
+
+    // In place
+    crypto.aesCbcCfb128DecryptEntry(ivkey, input, input);
+    if (input != plaintext) {
+        fmt::print(stderr, "Known answer test failed in place\n");
+        return false;
+    }
+    return true;
+}
+
+// The eight-block path must agree with decrypting one block per call, chaining the IV by hand.
+bool CheckAgainstSingleBlocks(Crypto& crypto) {
+    constexpr size_t Size = 16 * 37; // Several 8-block batches and a remainder
+    auto ciphertext = RandomBytes(Size, 7);
+    auto ivkey_bytes = RandomBytes(32, 8);
+    std::array<u8, 32> ivkey;
+    std::copy(ivkey_bytes.begin(), ivkey_bytes.end(), ivkey.begin());
+
+    std::vector<u8> batched(Size);
+    crypto.aesCbcCfb128DecryptEntry(ivkey, ciphertext, batched);
+
+    std::vector<u8> single(Size);
+    std::array<u8, 32> chained = ivkey;
+    for (size_t offset = 0; offset < Size; offset += 16) {
+        crypto.aesCbcCfb128DecryptEntry(chained, std::span<u8>(ciphertext.data() + offset, 16),
+                                        std::span<u8>(single.data() + offset, 16));
+        std::copy_n(ciphertext.data() + offset, 16, chained.begin());
+    }
+    if (batched != single) {
+        fmt::print(stderr, "Batched decryption differs from single block decryption\n");
+        return false;
+    }
+    return true;
+}
+
+template <typename Func>
+double BestSeconds(u32 runs, Func&& func) {
+    double best = 1e30;
+    for (u32 run = 0; run < runs; ++run) {
+        const auto start = Clock::now();
+        func();
+        best = std::min(best, std::chrono::duration<double>(Clock::now() - start).count());
+    }
+    return best;
+}
+
+void Report(std::string_view name, u64 bytes, u64 calls, double seconds) {
+    fmt::print("{:<36} {:>9.1f} MiB/s  {:>8.1f} ns/call  ({:.1f} MiB in {} calls)\n", name,
+               bytes / MiB / std::max(seconds, 1e-9), seconds * 1e9 / std::max<u64>(calls, 1),
+               bytes / MiB, calls);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    Crypto crypto;
+    if (!CheckKnownAnswer(crypto) || !CheckAgainstSingleBlocks(crypto)) {
+        return EXIT_FAILURE;
+    }
+    fmt::print("Known answer and consistency checks passed\n");
+
+    // Trophy set: every EFSM file shares the trophy key and NP comm ID.
+    {
+        const size_t file_size = static_cast<size_t>(options.efsm_kib) * 1024;
+        auto data = RandomBytes(file_size * options.trophy_files, 1);
+        std::vector<u8> out(data.size());
+        std::array<u8, 16> trophy_key{0x21};
+        std::array<u8, 16> np_comm_id{'N', 'P', 'W', 'R', '0', '0', '0', '0', '1', '_', '0', '0'};
+        std::array<u8, 16> iv{};
+
+        const double seconds = BestSeconds(options.runs, [&] {
+            for (u32 i = 0; i < options.trophy_files; ++i) {
+                crypto.decryptEFSM(trophy_key, np_comm_id, iv,
+                                   std::span<u8>(data.data() + i * file_size, file_size),
+                                   std::span<u8>(out.data() + i * file_size, file_size));
+            }
+        });
+        Report("decryptEFSM (trophy set)", data.size(), options.trophy_files, seconds);
+    }
+
+    // NP entries: one ivkey per entry in a PKG, so the key schedule changes every call.
+    {
+        const size_t entry_size = options.np_entry_size;
+        auto data = RandomBytes(entry_size * options.np_entries, 2);
+        auto ivkeys = RandomBytes(32 * options.np_entries, 3);
+        std::vector<u8> out(data.size());
+
+        const double seconds = BestSeconds(options.runs, [&] {
+            for (u32 i = 0; i < options.np_entries; ++i) {
+                crypto.aesCbcCfb128DecryptEntry(
+                    std::span<const u8, 32>(ivkeys.data() + i * 32, 32),
+                    std::span<u8>(data.data() + i * entry_size, entry_size),
+                    std::span<u8>(out.data() + i * entry_size, entry_size));
+            }
+        });
+        Report("aesCbcCfb128DecryptEntry (NP data)", data.size(), options.np_entries, seconds);
+    }
+
+    // Image key: a fixed 256 byte block decrypted once per PKG.
+    {
+        constexpr u32 Calls = 100000;
+        auto data = RandomBytes(256, 4);
+        auto ivkey = RandomBytes(32, 5);
+        std::array<u8, 256> out{};
+
+        const double seconds = BestSeconds(options.runs, [&] {
+            for (u32 i = 0; i < Calls; ++i) {
+                crypto.aesCbcCfb128Decrypt(std::span<const u8, 32>(ivkey.data(), 32),
+                                           std::span<const u8, 256>(data.data(), 256), out);
+            }
+        });
+        Report("aesCbcCfb128Decrypt (image key)", u64{256} * Calls, Calls, seconds);
+    }
+    return EXIT_SUCCESS;
+}
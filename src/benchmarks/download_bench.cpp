@@ -0,0 +1,359 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Headless download benchmark. Serves a synthetic file from a local HTTP server stand-in that
+// supports Range requests and can cap the bandwidth of each connection, like a CDN does, then
+// drives FileDownload against it: one stream, parallel ranges, a dropped connection resumed
+// with Range, a download aborted and resumed by a new FileDownload, and a checksum mismatch.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QNetworkAccessManager>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <fmt/format.h>
+
+#include "qt_ui/file_download.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr double MiB = 1024.0 * 1024.0;
+
+struct BenchOptions {
+    u32 size_mib = 64;
+    u32 segments = 4;
+    u32 connection_mibps = 32; // Bandwidth of one connection, 0 for unlimited
+    u32 runs = 3;
+    u32 timeout_ms = 60000;
+};
+
+void PrintUsage() {
+    fmt::print("Usage: download_bench [options]\n"
+               "  --size-mib <n>         size of the served file (default 64)\n"
+               "  --segments <n>         parallel ranges of the segmented run (default 4)\n"
+               "  --connection-mibps <n> bandwidth of a connection, 0 for none (default 32)\n"
+               "  --runs <n>             timed runs, the best one is reported (default 3)\n"
+               "  --timeout-ms <n>       longest wait for a download (default 60000)\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : ""; };
+
+        bool ok = true;
+        if (arg == "--size-mib") {
+            ok = ParseNumber(next(), options.size_mib) && options.size_mib > 0;
+        } else if (arg == "--segments") {
+            ok = ParseNumber(next(), options.segments) && options.segments > 0;
+        } else if (arg == "--connection-mibps") {
+            ok = ParseNumber(next(), options.connection_mibps);
+        } else if (arg == "--runs") {
+            ok = ParseNumber(next(), options.runs) && options.runs > 0;
+        } else if (arg == "--timeout-ms") {
+            ok = ParseNumber(next(), options.timeout_ms) && options.timeout_ms > 0;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fmt::print(stderr, "Invalid argument: {}\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+double Milliseconds(Clock::duration time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+// HTTP/1.1 server for a single file, one request per connection.
+class MockHttpServer {
+public:
+    static constexpr qint64 ChunkSize = 64 * 1024;
+    static constexpr qint64 MaxQueued = 1024 * 1024;
+
+    MockHttpServer(QByteArray data, u32 connection_mibps)
+        : m_data{std::move(data)}, m_bytes_per_ms{connection_mibps * MiB / 1000} {
+        QObject::connect(&m_server, &QTcpServer::newConnection, [this] {
+            while (QTcpSocket* socket = m_server.nextPendingConnection()) {
+                Accept(socket);
+            }
+        });
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    QUrl GetUrl() const {
+        return QUrl(QString("http://127.0.0.1:%1/release.zip").arg(m_server.serverPort()));
+    }
+
+    /// The next connection is closed after sending this many bytes of the body.
+    void DropNextAfter(qint64 bytes) {
+        m_drop_after = bytes;
+    }
+
+    /// Body bytes sent since the last call
+    qint64 TakeBytesSent() {
+        return std::exchange(m_bytes_sent, 0);
+    }
+
+private:
+    struct Connection {
+        QTcpSocket* socket;
+        QByteArray request;
+        qint64 next = 0;
+        qint64 end = 0;
+        qint64 sent = 0;
+        qint64 drop_after = -1;
+        QElapsedTimer clock;
+        QTimer pacer;
+    };
+
+    void Accept(QTcpSocket* socket) {
+        auto connection = std::make_shared<Connection>();
+        connection->socket = socket;
+        QObject::connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, connection] {
+            connection->request += connection->socket->readAll();
+            if (connection->request.contains("\r\n\r\n") && connection->end == 0) {
+                Respond(connection);
+            }
+        });
+        // Keeps the connection alive as long as its socket
+        QObject::connect(socket, &QObject::destroyed, [connection] { connection->pacer.stop(); });
+    }
+
+    void Respond(const std::shared_ptr<Connection>& connection) {
+        const qint64 total = m_data.size();
+        qint64 first = 0;
+        qint64 last = total - 1;
+        bool partial = false;
+        for (const QByteArray& line : connection->request.split('\n')) {
+            const QByteArray header = line.trimmed();
+            if (header.toLower().startsWith("range: bytes=")) {
+                const QList<QByteArray> range = header.mid(13).split('-');
+                first = range[0].toLongLong();
+                if (range.size() > 1 && !range[1].isEmpty()) {
+                    last = std::min(range[1].toLongLong(), total - 1);
+                }
+                partial = true;
+            }
+        }
+
+        QByteArray head;
+        if (partial && first >= total) {
+            head = "HTTP/1.1 416 Range Not Satisfiable\r\nContent-Range: bytes */" +
+                   QByteArray::number(total) + "\r\n";
+            last = first - 1;
+        } else if (partial) {
+            head = "HTTP/1.1 206 Partial Content\r\nContent-Range: bytes " +
+                   QByteArray::number(first) + "-" + QByteArray::number(last) + "/" +
+                   QByteArray::number(total) + "\r\n";
+        } else {
+            head = "HTTP/1.1 200 OK\r\n";
+        }
+        head += "Content-Length: " + QByteArray::number(last - first + 1) +
+                "\r\nAccept-Ranges: bytes\r\nETag: \"bench\"\r\nConnection: close\r\n\r\n";
+
+        connection->socket->write(head);
+        connection->next = first;
+        connection->end = last + 1;
+        connection->drop_after = std::exchange(m_drop_after, -1);
+        connection->clock.start();
+        QObject::connect(connection->socket, &QTcpSocket::bytesWritten, connection->socket,
+                         [this, connection] { Pump(*connection); });
+        QObject::connect(&connection->pacer, &QTimer::timeout, connection->socket,
+                         [this, connection] { Pump(*connection); });
+        connection->pacer.start(1);
+        Pump(*connection);
+    }
+
+    void Pump(Connection& connection) {
+        QTcpSocket* socket = connection.socket;
+        if (connection.next >= connection.end) {
+            connection.pacer.stop();
+            socket->disconnectFromHost();
+            return;
+        }
+        if (socket->bytesToWrite() >= MaxQueued) {
+            return;
+        }
+        qint64 size = std::min(ChunkSize, connection.end - connection.next);
+        if (m_bytes_per_ms > 0) {
+            const qint64 allowed =
+                static_cast<qint64>(connection.clock.elapsed() * m_bytes_per_ms) - connection.sent;
+            size = std::min(size, allowed);
+        }
+        if (connection.drop_after >= 0) {
+            size = std::min(size, connection.drop_after - connection.sent);
+            if (size <= 0) {
+                connection.pacer.stop();
+                socket->abort();
+                return;
+            }
+        }
+        if (size <= 0) {
+            return;
+        }
+        socket->write(m_data.constData() + connection.next, size);
+        connection.next += size;
+        connection.sent += size;
+        m_bytes_sent += size;
+    }
+
+    QTcpServer m_server;
+    QByteArray m_data;
+    double m_bytes_per_ms;
+    qint64 m_drop_after = -1;
+    qint64 m_bytes_sent = 0;
+};
+
+struct Result {
+    bool finished = false;
+    QString error;
+    double ms = 0;
+};
+
+// Runs one download to its end, or until abort_at bytes when not negative.
+Result Download(QNetworkAccessManager& manager, const QUrl& url, const QString& path,
+                const FileDownload::Options& options, u32 timeout_ms, qint64 abort_at = -1) {
+    Result result;
+    FileDownload download(&manager);
+    QEventLoop loop;
+    QObject::connect(&download, &FileDownload::Finished, &loop, [&] {
+        result.finished = true;
+        loop.quit();
+    });
+    QObject::connect(&download, &FileDownload::Failed, &loop, [&](const QString& error) {
+        result.error = error;
+        loop.quit();
+    });
+    QObject::connect(&download, &FileDownload::Progress, &loop, [&](qint64 received, qint64) {
+        if (abort_at >= 0 && received >= abort_at) {
+            download.Abort();
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(timeout_ms, &loop, [&] {
+        result.error = QStringLiteral("timed out");
+        loop.quit();
+    });
+
+    const auto start = Clock::now();
+    download.Start(url, path, options);
+    if (download.IsRunning()) {
+        loop.exec();
+    }
+    result.ms = Milliseconds(Clock::now() - start);
+    return result;
+}
+
+bool SameFile(const QString& path, const QByteArray& data) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) && file.readAll() == data;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    const qint64 size = static_cast<qint64>(options.size_mib) * 1024 * 1024;
+    QByteArray data(size, Qt::Uninitialized);
+    for (qint64 i = 0; i < size; ++i) {
+        data[i] = static_cast<char>((i * 2654435761u) >> 13);
+    }
+    const QByteArray sha256 = QCryptographicHash::hash(data, QCryptographicHash::Sha256).toHex();
+
+    MockHttpServer server(data, options.connection_mibps);
+    QNetworkAccessManager manager;
+    QTemporaryDir dir;
+    const QString path = dir.filePath(QStringLiteral("release.zip"));
+
+    FileDownload::Options single{
+        .expected_size = size, .sha256 = sha256, .max_segments = 1, .retry_delay_ms = 10};
+    FileDownload::Options segmented = single;
+    segmented.max_segments = static_cast<int>(options.segments);
+    segmented.min_segment_size = 1024 * 1024;
+
+    const auto run = [&](std::string_view name, const FileDownload::Options& download_options) {
+        double best = 1e30;
+        for (u32 i = 0; i < options.runs; ++i) {
+            QFile::remove(path);
+            const Result result =
+                Download(manager, server.GetUrl(), path, download_options, options.timeout_ms);
+            if (!result.finished || !SameFile(path, data)) {
+                fmt::print(stderr, "{} failed: {}\n", name, result.error.toStdString());
+                return false;
+            }
+            best = std::min(best, result.ms);
+        }
+        server.TakeBytesSent();
+        fmt::print("{:<18} {:>9.2f} ms  {:>8.1f} MiB/s\n", name, best, size / MiB * 1000 / best);
+        return true;
+    };
+    if (!run("one stream", single) || !run("parallel ranges", segmented)) {
+        return EXIT_FAILURE;
+    }
+
+    // A connection dropped halfway is resumed with a Range request
+    QFile::remove(path);
+    server.DropNextAfter(size / 2);
+    Result result = Download(manager, server.GetUrl(), path, single, options.timeout_ms);
+    if (!result.finished || !SameFile(path, data)) {
+        fmt::print(stderr, "dropped connection failed: {}\n", result.error.toStdString());
+        return EXIT_FAILURE;
+    }
+    fmt::print("{:<18} {:>9.2f} ms  {:>8.1f} MiB sent for {:.1f} MiB\n", "dropped connection",
+               result.ms, server.TakeBytesSent() / MiB, size / MiB);
+
+    // An aborted download is resumed from its .part file by a new FileDownload
+    QFile::remove(path);
+    Download(manager, server.GetUrl(), path, segmented, options.timeout_ms, size / 2);
+    result = Download(manager, server.GetUrl(), path, segmented, options.timeout_ms);
+    if (!result.finished || !SameFile(path, data)) {
+        fmt::print(stderr, "aborted and resumed failed: {}\n", result.error.toStdString());
+        return EXIT_FAILURE;
+    }
+    fmt::print("{:<18} {:>9.2f} ms  {:>8.1f} MiB sent for {:.1f} MiB\n", "abort and resume",
+               result.ms, server.TakeBytesSent() / MiB, size / MiB);
+
+    // A corrupted download never replaces the file
+    QFile::remove(path);
+    FileDownload::Options wrong = segmented;
+    wrong.sha256 = QByteArray(64, '0');
+    result = Download(manager, server.GetUrl(), path, wrong, options.timeout_ms);
+    if (result.finished || QFile::exists(path) || QFile::exists(FileDownload::PartPath(path))) {
+        fmt::print(stderr, "checksum mismatch was not detected\n");
+        return EXIT_FAILURE;
+    }
+    fmt::print("{:<18} rejected: {}\n", "checksum mismatch", result.error.toStdString());
+    return EXIT_SUCCESS;
+}
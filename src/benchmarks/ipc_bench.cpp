@@ -0,0 +1,287 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Headless IPC benchmark. Drives IpcClient against mock_emulator and reports the latency from
+// launch to RUN, the time to upload memory patches, the log throughput from the emulator stdout
+// to LogEntrySent, the time from STOP to exit and the restart round trip. Needs neither the
+// emulator nor the GUI.
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+#include <fmt/format.h>
+
+#include "common/logging/backend.h"
+#include "core/ipc/ipc_client.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr double MiB = 1024.0 * 1024.0;
+
+struct BenchOptions {
+    QString emulator; // mock_emulator next to this executable by default
+    u32 patches = 1000;
+    u64 log_lines = 200000;
+    u32 line_size = 100;
+    u32 startup_ms = 0;
+    u32 runs = 5;
+    u32 timeout_ms = 30000;
+};
+
+void PrintUsage() {
+    fmt::print("Usage: ipc_bench [options]\n"
+               "  --emulator <path>      emulator to run (default mock_emulator next to this)\n"
+               "  --patches <n>          memory patches uploaded per run (default 1000)\n"
+               "  --log-lines <n>        log lines received per run (default 200000)\n"
+               "  --line-size <n>        length of a log line (default 100)\n"
+               "  --startup-ms <n>       boot time of the mock emulator (default 0)\n"
+               "  --runs <n>             timed runs, the best one is reported (default 5)\n"
+               "  --timeout-ms <n>       longest wait for the emulator (default 30000)\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : ""; };
+
+        bool ok = true;
+        if (arg == "--emulator") {
+            options.emulator = QString::fromLocal8Bit(next());
+            ok = !options.emulator.isEmpty();
+        } else if (arg == "--patches") {
+            ok = ParseNumber(next(), options.patches) && options.patches > 0;
+        } else if (arg == "--log-lines") {
+            ok = ParseNumber(next(), options.log_lines) && options.log_lines > 0;
+        } else if (arg == "--line-size") {
+            ok = ParseNumber(next(), options.line_size) && options.line_size > 0;
+        } else if (arg == "--startup-ms") {
+            ok = ParseNumber(next(), options.startup_ms);
+        } else if (arg == "--runs") {
+            ok = ParseNumber(next(), options.runs) && options.runs > 0;
+        } else if (arg == "--timeout-ms") {
+            ok = ParseNumber(next(), options.timeout_ms) && options.timeout_ms > 0;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fmt::print(stderr, "Invalid argument: {}\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+double Milliseconds(Clock::duration time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+// Runs the mock emulator through IpcClient and records when its callbacks and signals arrive.
+class IpcBench {
+public:
+    explicit IpcBench(const BenchOptions& options) : m_options{options} {
+        m_client.startGameFunc = [this] { events.runs.push_back(Clock::now()); };
+        m_client.gameClosedFunc = [this] { events.closed.push_back(Clock::now()); };
+        m_client.restartEmulatorFunc = [this] {
+            QStringList args;
+            for (const auto& arg : m_client.parsedArgs) {
+                args.append(QString::fromStdString(arg));
+            }
+            m_client.parsedArgs.clear();
+            Launch(args);
+        };
+        QObject::connect(&m_client, &IpcClient::LogEntrySent, [this](QString entry, QColor) {
+            if (entry.contains(QStringLiteral(" Spam: line "))) {
+                events.log_bytes += entry.size() + 1;
+                if (++events.log_lines == m_options.log_lines) {
+                    events.log_done = Clock::now();
+                }
+            } else if (entry.startsWith(QStringLiteral("[IPC] <Info> Mock: ack PATCH_MEMORY "))) {
+                ++events.patch_acks;
+                events.last_patch_ack = Clock::now();
+            }
+        });
+    }
+
+    /// Starts a session, the times recorded for the previous one are dropped.
+    void Start(QStringList args) {
+        events = {};
+        args.prepend(QStringLiteral("bench/eboot.bin"));
+        args.prepend(QStringLiteral("--game"));
+        events.start = Clock::now();
+        Launch(args);
+    }
+
+    /// Runs the event loop until done returns true. False on timeout.
+    bool WaitFor(const std::function<bool()>& done, std::string_view what) {
+        QElapsedTimer timer;
+        timer.start();
+        QEventLoop loop;
+        QTimer poll;
+        QObject::connect(&poll, &QTimer::timeout, &loop, [&] {
+            if (done() || timer.elapsed() > m_options.timeout_ms) {
+                loop.quit();
+            }
+        });
+        poll.start(1);
+        if (!done()) {
+            loop.exec();
+        }
+        if (!done()) {
+            fmt::print(stderr, "Timed out waiting for {}\n", what);
+            return false;
+        }
+        return true;
+    }
+
+    bool Stop() {
+        const size_t closed = events.closed.size();
+        m_client.stopEmulator();
+        return WaitFor([&] { return events.closed.size() > closed; }, "the emulator to exit");
+    }
+
+    IpcClient& GetClient() {
+        return m_client;
+    }
+
+    /// What the current session reported so far
+    struct Events {
+        Clock::time_point start;
+        std::vector<Clock::time_point> runs; ///< RUN sent, one per process
+        std::vector<Clock::time_point> closed;
+        u64 log_lines = 0;
+        u64 log_bytes = 0;
+        std::optional<Clock::time_point> log_done;
+        u32 patch_acks = 0;
+        Clock::time_point last_patch_ack;
+    } events;
+
+private:
+    void Launch(const QStringList& args) {
+        m_client.startEmulator(QFileInfo(m_options.emulator), args, QString());
+    }
+
+    const BenchOptions& m_options;
+    IpcClient m_client;
+};
+
+struct RunTimes {
+    double launch_ms = 1e30;
+    double patch_ms = 1e30;
+    double stop_ms = 1e30;
+    double log_ms = 1e30;
+    double log_mib = 0;
+    double restart_ms = 1e30;
+};
+
+bool RunOnce(IpcBench& bench, const BenchOptions& options, RunTimes& best) {
+    const QStringList startup{QStringLiteral("--startup-ms"), QString::number(options.startup_ms)};
+    const auto& events = bench.events;
+
+    // Launch to RUN, then the patch upload and STOP on the same session
+    bench.Start(startup);
+    if (!bench.WaitFor([&] { return !events.runs.empty(); }, "RUN")) {
+        return false;
+    }
+    best.launch_ms = std::min(best.launch_ms, Milliseconds(events.runs[0] - events.start));
+
+    const auto patch_start = Clock::now();
+    for (u32 i = 0; i < options.patches; ++i) {
+        bench.GetClient().sendMemoryPatches("Bench", fmt::format("{:#x}", 0x1000 + i * 4),
+                                            "90909090", "", "4", true, false);
+    }
+    if (!bench.WaitFor([&] { return events.patch_acks == options.patches; }, "the patches")) {
+        return false;
+    }
+    best.patch_ms = std::min(best.patch_ms, Milliseconds(events.last_patch_ack - patch_start));
+
+    const auto stop_start = Clock::now();
+    if (!bench.Stop()) {
+        return false;
+    }
+    best.stop_ms = std::min(best.stop_ms, Milliseconds(events.closed.back() - stop_start));
+
+    // Log throughput from RUN to the last line
+    bench.Start(startup + QStringList{QStringLiteral("--log-lines"),
+                                      QString::number(options.log_lines),
+                                      QStringLiteral("--line-size"),
+                                      QString::number(options.line_size)});
+    if (!bench.WaitFor([&] { return events.log_done.has_value(); }, "the log lines")) {
+        return false;
+    }
+    const double log_ms = Milliseconds(*events.log_done - events.runs[0]);
+    if (log_ms < best.log_ms) {
+        best.log_ms = log_ms;
+        best.log_mib = events.log_bytes / MiB;
+    }
+    if (!bench.Stop()) {
+        return false;
+    }
+
+    // Restart requested by the emulator, from its RUN to the RUN of the new process
+    bench.Start(startup + QStringList{QStringLiteral("--request-restart")});
+    if (!bench.WaitFor([&] { return events.runs.size() == 2; }, "the restart")) {
+        return false;
+    }
+    best.restart_ms = std::min(best.restart_ms, Milliseconds(events.runs[1] - events.runs[0]));
+    return bench.Stop();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+    if (options.emulator.isEmpty()) {
+#ifdef _WIN32
+        options.emulator = QCoreApplication::applicationDirPath() + "/mock_emulator.exe";
+#else
+        options.emulator = QCoreApplication::applicationDirPath() + "/mock_emulator";
+#endif
+    }
+    if (!QFileInfo::exists(options.emulator)) {
+        fmt::print(stderr, "Emulator not found: {}\n", options.emulator.toStdString());
+        return EXIT_FAILURE;
+    }
+
+    Common::Log::Initialize("ipc_bench.log");
+    Common::Log::Start();
+
+    IpcBench bench(options);
+    RunTimes best;
+    for (u32 run = 0; run < options.runs; ++run) {
+        if (!RunOnce(bench, options, best)) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    fmt::print("launch to RUN      {:>9.2f} ms\n", best.launch_ms);
+    fmt::print("patch upload       {:>9.2f} ms  {:>8.1f} us/patch  ({} patches)\n", best.patch_ms,
+               best.patch_ms * 1000 / options.patches, options.patches);
+    fmt::print("STOP to exit       {:>9.2f} ms\n", best.stop_ms);
+    fmt::print("log throughput     {:>9.0f} lines/s  {:>6.1f} MiB/s  ({} lines in {:.1f} ms)\n",
+               options.log_lines * 1000 / best.log_ms, best.log_mib * 1000 / best.log_ms,
+               options.log_lines, best.log_ms);
+    fmt::print("restart to RUN     {:>9.2f} ms\n", best.restart_ms);
+    return EXIT_SUCCESS;
+}
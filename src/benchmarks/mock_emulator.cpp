@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Stand-in for a shadPS4 build speaking the launcher IPC protocol, so IpcClient can be run and
+// benchmarked without the emulator. With SHADPS4_ENABLE_IPC=true it announces its capabilities
+// on stderr and waits for RUN, then logs to stdout at the configured rate. Every command read
+// from stdin is acknowledged with a log line "[IPC] <Info> Mock: ack <COMMAND> <count>".
+// Synthetic telemetry samples are streamed once the launcher sends SET_TELEMETRY.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fmt/format.h>
+
+#include "common/polyfill_thread.h"
+#include "common/types.h"
+#include "core/ipc/telemetry.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct MockOptions {
+    u32 startup_ms = 0;            // Simulated boot time before the handshake
+    u64 log_lines = 0;             // Lines logged after RUN
+    u32 log_rate = 0;              // Lines per second, 0 for as fast as possible
+    u32 line_size = 100;           // Length of a log line
+    bool request_restart = false;  // Asks for a restart after RUN, without this option
+    std::vector<std::string> args; // Sent back with the restart request
+};
+
+// Lines following each command, as written by IpcClient
+const std::unordered_map<std::string_view, u32> CommandArgs{
+    {"RUN", 0},
+    {"START", 0},
+    {"PAUSE", 0},
+    {"RESUME", 0},
+    {"STOP", 0},
+    {"TOGGLE_FULLSCREEN", 0},
+    {"ADJUST_VOLUME", 2},
+    {"SET_FSR", 1},
+    {"SET_RCAS", 1},
+    {"SET_RCAS_ATTENUATION", 1},
+    {"RELOAD_INPUTS", 1},
+    {"SET_ACTIVE_CONTROLLER", 1},
+    {"SET_TELEMETRY", 1},
+    {"PATCH_MEMORY", 9},
+    {"USB_LOAD_FIGURE", 3},
+    {"USB_REMOVE_FIGURE", 3},
+    {"USB_MOVE_FIGURE", 4},
+    {"USB_TEMP_REMOVE_FIGURE", 1},
+    {"USB_CANCEL_REMOVE_FIGURE", 1},
+};
+
+// Log lines written at once when there is a backlog
+constexpr u64 MaxBatchLines = 256;
+
+std::mutex output_mutex;
+
+void Write(std::FILE* stream, std::string_view text) {
+    std::scoped_lock lock{output_mutex};
+    std::fwrite(text.data(), 1, text.size(), stream);
+    std::fflush(stream);
+}
+
+void PrintUsage() {
+    fmt::print(stderr, "Usage: mock_emulator [options] [emulator arguments]\n"
+                       "  --startup-ms <n>       delay before the IPC handshake (default 0)\n"
+                       "  --log-lines <n>        lines logged after RUN (default 0)\n"
+                       "  --log-rate <n>         lines per second, 0 for unlimited (default 0)\n"
+                       "  --line-size <n>        length of a log line (default 100)\n"
+                       "  --request-restart      ask the launcher for a restart after RUN\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+// Unknown arguments, like --game, are kept for the restart request.
+bool ParseArgs(int argc, char* argv[], MockOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : ""; };
+
+        bool ok = true;
+        if (arg == "--startup-ms") {
+            ok = ParseNumber(next(), options.startup_ms);
+        } else if (arg == "--log-lines") {
+            ok = ParseNumber(next(), options.log_lines);
+        } else if (arg == "--log-rate") {
+            ok = ParseNumber(next(), options.log_rate);
+        } else if (arg == "--line-size") {
+            ok = ParseNumber(next(), options.line_size) && options.line_size > 0;
+        } else if (arg == "--request-restart") {
+            options.request_restart = true;
+            continue;
+        } else {
+            options.args.emplace_back(arg);
+            continue;
+        }
+
+        if (!ok) {
+            fmt::print(stderr, "Invalid argument: {}\n", arg);
+            return false;
+        }
+        options.args.emplace_back(arg);
+        options.args.emplace_back(argv[i]);
+    }
+    return true;
+}
+
+void LogSpam(std::stop_token stop_token, const MockOptions& options) {
+    static constexpr std::array<std::string_view, 4> Classes{"Kernel", "Render.Vulkan",
+                                                             "Lib.AudioOut", "Core.Linker"};
+    const auto start = Clock::now();
+    std::string batch;
+    u64 line = 0;
+    while (line < options.log_lines && !stop_token.stop_requested()) {
+        u64 due = options.log_lines;
+        if (options.log_rate != 0) {
+            const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            due = std::min(due, static_cast<u64>(elapsed * options.log_rate) + 1);
+        }
+        due = std::min(due, line + MaxBatchLines);
+        if (line == due) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+
+        batch.clear();
+        for (; line < due; ++line) {
+            const size_t begin = batch.size();
+            fmt::format_to(std::back_inserter(batch),
+                           "[{}] <{}> mock_emulator.cpp:{} Spam: line {} ",
+                           Classes[line % Classes.size()], line % 16 == 0 ? "Warning" : "Info",
+                           line % 1000, line);
+            if (batch.size() - begin < options.line_size) {
+                batch.append(options.line_size - (batch.size() - begin), 'x');
+            }
+            batch += '\n';
+        }
+        Write(stdout, batch);
+    }
+}
+
+std::string Base64(std::span<const u8> data) {
+    static constexpr std::string_view Alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string text;
+    for (size_t i = 0; i < data.size(); i += 3) {
+        const u32 rest = static_cast<u32>(std::min<size_t>(3, data.size() - i));
+        u32 bits = data[i] << 16;
+        bits |= rest > 1 ? data[i + 1] << 8 : 0;
+        bits |= rest > 2 ? data[i + 2] : 0;
+        for (u32 j = 0; j < 4; ++j) {
+            text += j <= rest ? Alphabet[(bits >> (18 - 6 * j)) & 0x3F] : '=';
+        }
+    }
+    return text;
+}
+
+// A game running around 60 FPS with a periodic stutter
+void Telemetry(std::stop_token stop_token, u32 interval_ms) {
+    const auto start = Clock::now();
+    for (u32 i = 0; !stop_token.stop_requested(); ++i) {
+        const double wave = std::sin(i * 0.1);
+        const bool stutter = i % 40 == 0;
+        TelemetrySample sample{
+            .time_ms = static_cast<u32>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                            Clock::now() - start)
+                                            .count()),
+            .fps = static_cast<float>(stutter ? 41.0 : 59.0 + wave),
+            .frame_time_p50 = 16.6f,
+            .frame_time_p95 = static_cast<float>(17.5 + wave),
+            .frame_time_p99 = static_cast<float>(stutter ? 48.0 : 19.0 + wave),
+            .cpu_thread_util = static_cast<u8>(55 + 10 * wave),
+            .gpu_thread_util = static_cast<u8>(70 + 15 * wave),
+            .reserved = 0,
+            .memory_mib = 2048 + i % 256,
+        };
+        std::array<u8, sizeof(TelemetrySample)> bytes;
+        std::memcpy(bytes.data(), &sample, sizeof(sample));
+        Write(stderr, fmt::format(";#TELEMETRY {} {}\n", TelemetryVersion, Base64(bytes)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MockOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.startup_ms));
+
+    std::jthread spam;
+    const auto start_spam = [&] {
+        spam = std::jthread([&](std::stop_token stop_token) { LogSpam(stop_token, options); });
+    };
+    const char* ipc_env = std::getenv("SHADPS4_ENABLE_IPC");
+    if (ipc_env != nullptr && std::string_view(ipc_env) == "true") {
+        Write(stderr, ";#IPC_ENABLED\n;ENABLE_MEMORY_PATCH\n;ENABLE_EMU_CONTROL\n"
+                      ";ENABLE_TELEMETRY\n;#IPC_END\n");
+    } else {
+        start_spam();
+    }
+
+    std::jthread telemetry;
+    std::unordered_map<std::string_view, u64> counts;
+    std::string command;
+    std::string arg;
+    while (std::getline(std::cin, command)) {
+        if (!command.empty() && command.back() == '\r') {
+            command.pop_back();
+        }
+        const auto it = CommandArgs.find(command);
+        if (it == CommandArgs.end()) {
+            Write(stdout, fmt::format("[IPC] <Error> Mock: unknown command {}\n", command));
+            continue;
+        }
+        for (u32 i = 0; i < it->second && std::getline(std::cin, arg); ++i) {
+        }
+        const u64 count = ++counts[it->first];
+        Write(stdout, fmt::format("[IPC] <Info> Mock: ack {} {}\n", it->first, count));
+
+        if (it->first == "RUN") {
+            if (!spam.joinable()) {
+                start_spam();
+            }
+            if (options.request_restart) {
+                std::string request = fmt::format(";RESTART\n;{}\n", options.args.size());
+                for (const std::string& restart_arg : options.args) {
+                    request += fmt::format(";{}\n", restart_arg);
+                }
+                Write(stderr, request);
+            }
+        } else if (it->first == "SET_TELEMETRY") {
+            u32 interval_ms = 0;
+            telemetry = {};
+            if (ParseNumber(arg, interval_ms) && interval_ms > 0) {
+                telemetry = std::jthread([interval_ms](std::stop_token stop_token) {
+                    Telemetry(stop_token, interval_ms);
+                });
+            }
+        } else if (it->first == "STOP") {
+            return EXIT_SUCCESS;
+        }
+    }
+
+    // Without a launcher on stdin, run until the log is written
+    if (spam.joinable()) {
+        spam.join();
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,251 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Headless PKG extraction benchmark. Generates a synthetic PKG and runs it through
+// PKG::Open -> PSF -> PKG::Extract -> PKG::ExtractFiles, reporting the time of every step and
+// the per-stage counters of PKGInstallStats. Needs no retail content, keys or GUI.
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fmt/format.h>
+
+#include "benchmarks/synthetic_pkg.h"
+#include "common/io_file.h"
+#include "core/file_format/pkg.h"
+#include "core/file_format/psf.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr double MiB = 1024.0 * 1024.0;
+
+struct BenchOptions {
+    Benchmark::SyntheticPkgOptions pkg;
+    std::filesystem::path work_dir = std::filesystem::temp_directory_path() / "pkg_extract_bench";
+    u32 threads = std::max(1u, std::thread::hardware_concurrency());
+    u32 runs = 3;
+    bool verify = true;
+    bool keep = false;
+};
+
+double Seconds(Clock::duration time) {
+    return std::chrono::duration<double>(time).count();
+}
+
+void PrintUsage() {
+    fmt::print("Usage: pkg_extract_bench [options]\n"
+               "  --size <MiB>            payload size (default 256)\n"
+               "  --files <n>             number of files (default 64)\n"
+               "  --dirs <n>              number of subdirectories (default 4)\n"
+               "  --compressibility <f>   0.0 (random) .. 1.0 (pattern) (default 0.5)\n"
+               "  --level <n>             libdeflate level used to build the PKG (default 6)\n"
+               "  --seed <n>              generator seed (default 1)\n"
+               "  --threads <n>           extraction workers (default: hardware threads)\n"
+               "  --runs <n>              extraction runs (default 3)\n"
+               "  --work <dir>            working directory (default: temp dir)\n"
+               "  --no-verify             skip checking the extracted files\n"
+               "  --keep                  keep the PKG and extracted files\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : ""; };
+
+        bool ok = true;
+        if (arg == "--size") {
+            u64 mib = 0;
+            ok = ParseNumber(next(), mib) && mib > 0;
+            options.pkg.payload_size = mib * 1024 * 1024;
+        } else if (arg == "--files") {
+            ok = ParseNumber(next(), options.pkg.file_count);
+        } else if (arg == "--dirs") {
+            ok = ParseNumber(next(), options.pkg.dir_count);
+        } else if (arg == "--compressibility") {
+            ok = ParseNumber(next(), options.pkg.compressibility) &&
+                 options.pkg.compressibility >= 0.0 && options.pkg.compressibility <= 1.0;
+        } else if (arg == "--level") {
+            ok = ParseNumber(next(), options.pkg.compression_level);
+        } else if (arg == "--seed") {
+            ok = ParseNumber(next(), options.pkg.seed);
+        } else if (arg == "--threads") {
+            ok = ParseNumber(next(), options.threads) && options.threads > 0;
+        } else if (arg == "--runs") {
+            ok = ParseNumber(next(), options.runs) && options.runs > 0;
+        } else if (arg == "--work") {
+            const auto dir = next();
+            ok = !dir.empty();
+            options.work_dir = std::filesystem::path(dir);
+        } else if (arg == "--no-verify") {
+            options.verify = false;
+        } else if (arg == "--keep") {
+            options.keep = true;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fmt::print(stderr, "Invalid argument: {}\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Same work split as the launcher: every worker pulls the next fsTable index.
+void ExtractAll(PKG& pkg, u32 threads) {
+    const int nfiles = static_cast<int>(pkg.GetNumberOfFiles());
+    std::atomic<int> next{0};
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+    for (u32 t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            for (int index = next++; index < nfiles; index = next++) {
+                pkg.ExtractFiles(index);
+            }
+        });
+    }
+}
+
+bool VerifyFiles(const std::filesystem::path& title_dir, const Benchmark::SyntheticPkg& synthetic) {
+    std::vector<u8> buffer(4 * 1024 * 1024);
+    for (const auto& file : synthetic.files) {
+        const auto path = title_dir / file.relative_path;
+        Common::FS::IOFile in(path, Common::FS::FileAccessMode::Read);
+        if (!in.IsOpen() || in.GetSize() != file.size) {
+            fmt::print(stderr, "Verify: {} is missing or has the wrong size\n", path.string());
+            return false;
+        }
+
+        u64 checksum = 0xcbf29ce484222325ULL;
+        for (u64 remaining = file.size; remaining > 0;) {
+            const size_t chunk = static_cast<size_t>(std::min<u64>(remaining, buffer.size()));
+            if (in.ReadRaw<u8>(buffer.data(), chunk) != chunk) {
+                fmt::print(stderr, "Verify: short read on {}\n", path.string());
+                return false;
+            }
+            checksum = Benchmark::Fnv1a64(buffer.data(), chunk, checksum);
+            remaining -= chunk;
+        }
+        if (checksum != file.checksum) {
+            fmt::print(stderr, "Verify: {} has wrong contents\n", path.string());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RunOnce(const BenchOptions& options, const std::filesystem::path& pkg_path,
+             const Benchmark::SyntheticPkg& synthetic, u32 run) {
+    const auto out_dir = options.work_dir / fmt::format("run{}", run);
+    const auto title_dir = out_dir / synthetic.title_id;
+    std::error_code ec;
+    std::filesystem::remove_all(out_dir, ec);
+    std::filesystem::create_directories(title_dir, ec);
+
+    std::string failreason;
+    PKG pkg;
+
+    const auto open_start = Clock::now();
+    if (!pkg.Open(pkg_path, failreason)) {
+        fmt::print(stderr, "PKG::Open failed: {}\n", failreason);
+        return false;
+    }
+    PSF psf;
+    if (!psf.Open(pkg.sfo) || !psf.GetString("TITLE_ID")) {
+        fmt::print(stderr, "param.sfo could not be read\n");
+        return false;
+    }
+
+    const auto metadata_start = Clock::now();
+    if (!pkg.Extract(pkg_path, title_dir, synthetic.ekpfs, failreason)) {
+        fmt::print(stderr, "PKG::Extract failed: {}\n", failreason);
+        return false;
+    }
+
+    const auto extract_start = Clock::now();
+    ExtractAll(pkg, options.threads);
+    const auto extract_end = Clock::now();
+
+    const double extract_s = Seconds(extract_end - extract_start);
+    fmt::print("run {}: open {:.1f} ms | metadata {:.1f} ms | extract {:.3f} s ({:.1f} MiB/s, "
+               "{} entries, {} threads)\n",
+               run, Seconds(metadata_start - open_start) * 1000.0,
+               Seconds(extract_start - metadata_start) * 1000.0, extract_s,
+               synthetic.payload_size / MiB / std::max(extract_s, 1e-9), pkg.GetNumberOfFiles(),
+               options.threads);
+    fmt::print("  {}\n", pkg.GetStats().Report(extract_end - extract_start));
+
+    if (pkg.GetStats().GetTotalBytes() != synthetic.payload_size) {
+        fmt::print(stderr, "PFS metadata reports {} bytes, expected {}\n",
+                   pkg.GetStats().GetTotalBytes(), synthetic.payload_size);
+        return false;
+    }
+    if (options.verify && !VerifyFiles(title_dir, synthetic)) {
+        return false;
+    }
+
+    if (!options.keep) {
+        std::filesystem::remove_all(out_dir, ec);
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.work_dir, ec);
+    const auto pkg_path = options.work_dir / "synthetic.pkg";
+
+    fmt::print("Generating {:.0f} MiB in {} files (compressibility {:.2f})...\n",
+               options.pkg.payload_size / MiB, options.pkg.file_count,
+               options.pkg.compressibility);
+
+    Benchmark::SyntheticPkg synthetic;
+    std::string failreason;
+    const auto generate_start = Clock::now();
+    if (!Benchmark::WriteSyntheticPkg(pkg_path, options.pkg, synthetic, failreason)) {
+        fmt::print(stderr, "Generating the PKG failed: {}\n", failreason);
+        return EXIT_FAILURE;
+    }
+    fmt::print("Generated {} in {:.2f} s: PFS image {:.1f} MiB, {} compressed / {} stored "
+               "blocks\n",
+               pkg_path.string(), Seconds(Clock::now() - generate_start),
+               synthetic.pfs_image_size / MiB, synthetic.compressed_blocks,
+               synthetic.stored_blocks);
+
+    bool ok = true;
+    for (u32 run = 1; run <= options.runs && ok; ++run) {
+        ok = RunOnce(options, pkg_path, synthetic, run);
+    }
+
+    if (!options.keep) {
+        std::filesystem::remove(pkg_path, ec);
+    }
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+    if (options.verify) {
+        fmt::print("All extracted files verified\n");
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,428 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <fmt/format.h>
+#include <libdeflate.h>
+
+#include "benchmarks/synthetic_pkg.h"
+#include "common/crypto.h"
+#include "common/io_file.h"
+#include "core/file_format/pfs.h"
+#include "core/file_format/pkg.h"
+#include "core/file_format/psf.h"
+
+namespace Benchmark {
+
+namespace {
+
+constexpr u64 PfsBlockSize = 0x10000;
+constexpr u64 XtsSectorSize = 0x1000;
+constexpr u64 InodeStride = 0xA8;
+constexpr u64 InodesPerBlock = PfsBlockSize / InodeStride;
+constexpr u64 PfscOffset = 0x20000; // first offset PKG::Extract probes for the PFSC magic
+constexpr u64 PfscMapOffset = 0x400;
+constexpr u64 SeedOffset = 0x370;
+constexpr u64 DirentReserve = 0x10; // keep room for the ino == 0 terminator
+constexpr u64 EncryptChunkSize = 0x100000;
+constexpr size_t WriteBufferSize = 8 * 1024 * 1024;
+constexpr s32 PfscMagic = 0x43534650;
+constexpr u32 PkgMagic = 0x7F434E54;
+constexpr u32 SfoEntryId = 0x1000;
+
+// Fixed content ID, PKG::Open takes the title ID from bytes 7..15.
+constexpr std::string_view ContentId = "UP9999-BENC00001_00-SYNTHETICPKG0000";
+constexpr std::string_view TitleId = "BENC00001";
+static_assert(ContentId.size() == 0x24);
+
+constexpr u64 AlignUp(u64 value, u64 align) {
+    return (value + align - 1) / align * align;
+}
+
+// Cheap deterministic generator, good enough to make blocks incompressible.
+class XorShift64 {
+public:
+    explicit XorShift64(u64 seed) : state(seed ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+    u64 Next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+private:
+    u64 state;
+};
+
+void FillBlock(std::span<u8> block, u64 valid_size, u64 seed, double compressibility) {
+    const u64 random_size =
+        std::min<u64>(valid_size, static_cast<u64>(valid_size * (1.0 - compressibility)));
+
+    XorShift64 rng(seed);
+    u64 pos = 0;
+    for (; pos + 8 <= random_size; pos += 8) {
+        const u64 value = rng.Next();
+        std::memcpy(block.data() + pos, &value, sizeof(value));
+    }
+    for (; pos < random_size; ++pos) {
+        block[pos] = static_cast<u8>(rng.Next());
+    }
+
+    static constexpr std::string_view Pattern = "shadLauncher4 synthetic payload ";
+    for (; pos < valid_size; ++pos) {
+        block[pos] = static_cast<u8>(Pattern[pos % Pattern.size()]);
+    }
+    std::fill(block.begin() + valid_size, block.end(), u8{0});
+}
+
+struct DirentBlocks {
+    std::vector<std::vector<u8>> blocks;
+    u64 used = PfsBlockSize; // forces a new block on the first Add
+
+    void StartBlock() {
+        blocks.emplace_back(PfsBlockSize, u8{0});
+        used = 0;
+    }
+
+    void Add(s32 ino, s32 type, std::string_view name) {
+        const u64 entsize = AlignUp(0x10 + name.size() + 1, 8);
+        if (used + entsize > PfsBlockSize - DirentReserve) {
+            StartBlock();
+        }
+        u8* dst = blocks.back().data() + used;
+        const s32 header[4] = {ino, type, static_cast<s32>(name.size()), static_cast<s32>(entsize)};
+        std::memcpy(dst, header, sizeof(header));
+        std::memcpy(dst + sizeof(header), name.data(), name.size());
+        used += entsize;
+    }
+};
+
+// Buffers the sequential image writes, IOFile::WriteRaw goes straight to the C runtime.
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const Common::FS::IOFile& file_) : file(file_) {
+        buffer.reserve(WriteBufferSize);
+    }
+
+    bool Write(const void* data, size_t size) {
+        const u8* src = static_cast<const u8*>(data);
+        buffer.insert(buffer.end(), src, src + size);
+        written += size;
+        return buffer.size() < WriteBufferSize || Flush();
+    }
+
+    bool Flush() {
+        const bool ok = file.WriteRaw<u8>(buffer.data(), buffer.size()) == buffer.size();
+        buffer.clear();
+        return ok;
+    }
+
+    u64 Written() const {
+        return written;
+    }
+
+private:
+    const Common::FS::IOFile& file;
+    std::vector<u8> buffer;
+    u64 written = 0;
+};
+
+std::vector<u8> BuildParamSfo() {
+    PSF psf;
+    psf.AddString("CATEGORY", "gd");
+    psf.AddString("CONTENT_ID", std::string(ContentId));
+    psf.AddString("TITLE", "Synthetic PKG Benchmark");
+    psf.AddString("TITLE_ID", std::string(TitleId));
+    psf.AddString("APP_VER", "01.00");
+    psf.AddString("VERSION", "01.00");
+    return psf.Encode();
+}
+
+} // namespace
+
+u64 Fnv1a64(const u8* data, size_t size, u64 hash) {
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool WriteSyntheticPkg(const std::filesystem::path& pkg_path, const SyntheticPkgOptions& options,
+                       SyntheticPkg& result, std::string& failreason) {
+    if (options.file_count == 0 || options.payload_size < options.file_count) {
+        failreason = "The payload needs at least one byte per file";
+        return false;
+    }
+
+    std::mt19937_64 rng(options.seed);
+    result = {};
+    result.title_id = std::string(TitleId);
+    for (auto& byte : result.ekpfs) {
+        byte = static_cast<u8>(rng());
+    }
+    std::array<u8, 16> pfs_seed;
+    for (auto& byte : pfs_seed) {
+        byte = static_cast<u8>(rng());
+    }
+
+    // File sizes vary by +-50% around the mean, the last file absorbs the rounding.
+    std::uniform_real_distribution<double> weight_dist(0.5, 1.5);
+    std::vector<double> weights(options.file_count);
+    double weight_sum = 0.0;
+    for (auto& weight : weights) {
+        weight = weight_dist(rng);
+        weight_sum += weight;
+    }
+
+    // Inodes: 0 super root, 1 flat_path_table, 2 uroot, then directories and files.
+    const u32 first_dir_ino = 3;
+    const u32 first_file_ino = first_dir_ino + options.dir_count;
+    const u32 inode_count = first_file_ino + options.file_count;
+
+    u64 assigned = 0;
+    for (u32 i = 0; i < options.file_count; ++i) {
+        if (assigned >= options.payload_size) {
+            failreason = "Too many files for the payload size";
+            return false;
+        }
+        auto& file = result.files.emplace_back();
+        file.size = i + 1 < options.file_count
+                        ? std::max<u64>(1, options.payload_size * (weights[i] / weight_sum))
+                        : options.payload_size - assigned;
+        assigned += file.size;
+
+        const u32 dir = i % (options.dir_count + 1); // 0 is the title root
+        const auto name = fmt::format("file{:05}.bin", i);
+        file.relative_path = dir == 0 ? std::filesystem::path(name)
+                                      : std::filesystem::path(fmt::format("dir{:03}", dir - 1)) /
+                                            name;
+    }
+    result.payload_size = options.payload_size;
+
+    // Directory entries. uroot lists the subdirectories and root files, every subdirectory
+    // gets its own dirent block(s) right after.
+    DirentBlocks dirents;
+    dirents.StartBlock();
+    dirents.Add(1, PFS_FILE, "flat_path_table");
+    dirents.Add(2, PFS_DIR, "uroot");
+
+    dirents.StartBlock();
+    dirents.Add(2, PFS_CURRENT_DIR, ".");
+    dirents.Add(2, PFS_PARENT_DIR, "..");
+    for (u32 d = 0; d < options.dir_count; ++d) {
+        dirents.Add(first_dir_ino + d, PFS_DIR, fmt::format("dir{:03}", d));
+    }
+    for (u32 i = 0; i < options.file_count; i += options.dir_count + 1) {
+        dirents.Add(first_file_ino + i, PFS_FILE, result.files[i].relative_path.string());
+    }
+    for (u32 d = 0; d < options.dir_count; ++d) {
+        dirents.StartBlock();
+        dirents.Add(first_dir_ino + d, PFS_CURRENT_DIR, ".");
+        dirents.Add(2, PFS_PARENT_DIR, "..");
+        for (u32 i = d + 1; i < options.file_count; i += options.dir_count + 1) {
+            dirents.Add(first_file_ino + i, PFS_FILE,
+                        result.files[i].relative_path.filename().string());
+        }
+    }
+
+    // Virtual block layout: super block, inode table, dirents, file data.
+    const u64 inode_blocks = AlignUp(inode_count * InodeStride, PfsBlockSize) / PfsBlockSize;
+    const u64 meta_blocks = 1 + inode_blocks + dirents.blocks.size();
+
+    std::vector<Inode> inodes(inode_count);
+    for (u32 ino = 0; ino < inode_count; ++ino) {
+        inodes[ino].Mode = (ino >= first_file_ino || ino == 1) ? InodeMode::file : InodeMode::dir;
+        inodes[ino].Nlink = 1;
+    }
+    u64 total_blocks = meta_blocks;
+    for (u32 i = 0; i < options.file_count; ++i) {
+        auto& inode = inodes[first_file_ino + i];
+        const u64 size = result.files[i].size;
+        inode.Flags = InodeFlags::compressed | InodeFlags::readonly;
+        inode.Size = static_cast<s64>(size);
+        inode.SizeCompressed = static_cast<s64>(size);
+        inode.loc = static_cast<u32>(total_blocks);
+        inode.Blocks = static_cast<u32>(AlignUp(size, PfsBlockSize) / PfsBlockSize);
+        total_blocks += inode.Blocks;
+    }
+
+    const u64 map_size = (total_blocks + 1) * sizeof(u64);
+    const u64 data_start = AlignUp(PfscMapOffset + map_size, PfsBlockSize);
+
+    // PKG layout: header, entry table, param.sfo, PFS image.
+    const std::vector<u8> sfo = BuildParamSfo();
+    const u64 entry_table_offset = sizeof(PKGHeader);
+    const u64 sfo_offset = AlignUp(entry_table_offset + sizeof(PKGEntry), 0x10);
+    const u64 image_offset = AlignUp(sfo_offset + sfo.size(), PfsBlockSize);
+
+    Common::FS::IOFile file(pkg_path, Common::FS::FileAccessMode::Write);
+    if (!file.IsOpen()) {
+        failreason = fmt::format("Could not create {}", pkg_path.string());
+        return false;
+    }
+
+    BufferedWriter writer(file);
+    {
+        std::vector<u8> head(image_offset + PfscOffset + data_start, u8{0});
+        std::memcpy(head.data() + image_offset + SeedOffset, pfs_seed.data(), pfs_seed.size());
+        writer.Write(head.data(), head.size());
+    }
+
+    libdeflate_compressor* compressor = libdeflate_alloc_compressor(options.compression_level);
+    std::vector<u64> sector_map;
+    sector_map.reserve(total_blocks + 1);
+    std::vector<u8> block(PfsBlockSize);
+    std::vector<u8> compressed(PfsBlockSize);
+
+    const auto emit_block = [&](std::span<const u8> inflated) {
+        sector_map.push_back(writer.Written() - image_offset - PfscOffset);
+        const size_t size = libdeflate_zlib_compress(compressor, inflated.data(), inflated.size(),
+                                                     compressed.data(), PfsBlockSize - 1);
+        if (size != 0) {
+            ++result.compressed_blocks;
+            return writer.Write(compressed.data(), size);
+        }
+        ++result.stored_blocks;
+        return writer.Write(inflated.data(), inflated.size());
+    };
+
+    bool ok = true;
+
+    // Super block, only the inode count is read back.
+    std::fill(block.begin(), block.end(), u8{0});
+    const s64 dinode_count = inode_count;
+    std::memcpy(block.data() + offsetof(PSFHeader_, dinode_count), &dinode_count,
+                sizeof(dinode_count));
+    ok &= emit_block(block);
+
+    for (u64 b = 0; b < inode_blocks; ++b) {
+        std::fill(block.begin(), block.end(), u8{0});
+        for (u64 n = 0; n < InodesPerBlock; ++n) {
+            const u64 ino = b * InodesPerBlock + n;
+            if (ino >= inode_count) {
+                break;
+            }
+            std::memcpy(block.data() + n * InodeStride, &inodes[ino], sizeof(Inode));
+        }
+        ok &= emit_block(block);
+    }
+
+    for (const auto& dirent_block : dirents.blocks) {
+        ok &= emit_block(dirent_block);
+    }
+    const u64 metadata_end = writer.Written() - image_offset;
+
+    for (u32 i = 0; i < options.file_count && ok; ++i) {
+        auto& synthetic = result.files[i];
+        u64 remaining = synthetic.size;
+        u64 checksum = 0xcbf29ce484222325ULL;
+        for (u64 b = 0; remaining > 0; ++b) {
+            const u64 valid = std::min(remaining, PfsBlockSize);
+            FillBlock(block, valid, (u64{options.seed} << 32) ^ (u64{i} << 20) ^ b,
+                      options.compressibility);
+            checksum = Fnv1a64(block.data(), valid, checksum);
+            ok &= emit_block(block);
+            remaining -= valid;
+        }
+        synthetic.checksum = checksum;
+    }
+    sector_map.push_back(writer.Written() - image_offset - PfscOffset);
+    libdeflate_free_compressor(compressor);
+
+    // Pad the image to whole XTS sectors.
+    const u64 image_size = AlignUp(writer.Written() - image_offset, XtsSectorSize);
+    {
+        const std::vector<u8> padding(image_offset + image_size - writer.Written(), u8{0});
+        ok &= writer.Write(padding.data(), padding.size());
+    }
+    ok &= writer.Flush();
+    if (!ok) {
+        failreason = "Failed to write the PFS image";
+        return false;
+    }
+    result.pfs_image_size = image_size;
+
+    // PFSC header and block map.
+    PFSCHdr pfsc{};
+    pfsc.magic = PfscMagic;
+    pfsc.unk8 = 6;
+    pfsc.block_sz = static_cast<s32>(PfsBlockSize);
+    pfsc.block_sz2 = static_cast<s64>(PfsBlockSize);
+    pfsc.block_offsets = static_cast<s64>(PfscMapOffset);
+    pfsc.data_start = data_start;
+    pfsc.data_length = static_cast<s64>(total_blocks * PfsBlockSize);
+    file.Seek(image_offset + PfscOffset);
+    file.WriteRaw<u8>(&pfsc, sizeof(pfsc));
+    file.Seek(image_offset + PfscOffset + PfscMapOffset);
+    file.WriteRaw<u64>(sector_map.data(), sector_map.size());
+
+    // PKG header, entry table and param.sfo.
+    PKGHeader header{};
+    header.magic = PkgMagic;
+    header.pkg_file_count = 1;
+    header.pkg_table_entry_count = 1;
+    header.pkg_table_entry_count_2 = 1;
+    header.pkg_table_entry_offset = static_cast<u32>(entry_table_offset);
+    header.pkg_body_offset = entry_table_offset;
+    header.pkg_body_size = image_offset - entry_table_offset;
+    header.pkg_content_offset = image_offset;
+    header.pkg_content_size = image_size;
+    std::memcpy(header.pkg_content_id, ContentId.data(), ContentId.size());
+    header.pfs_image_count = 1;
+    header.pfs_image_offset = image_offset;
+    header.pfs_image_size = image_size;
+    header.pkg_size = image_offset + image_size;
+    // PKG::Extract decrypts pfs_cache_size * 2 bytes up front to parse the metadata.
+    header.pfs_cache_size = static_cast<u32>(AlignUp(metadata_end, 2 * XtsSectorSize) / 2);
+
+    PKGEntry sfo_entry{};
+    sfo_entry.id = SfoEntryId;
+    sfo_entry.offset = static_cast<u32>(sfo_offset);
+    sfo_entry.size = static_cast<u32>(sfo.size());
+
+    file.Seek(0);
+    file.WriteRaw<u8>(&header, sizeof(header));
+    file.WriteRaw<u8>(&sfo_entry, sizeof(sfo_entry));
+    file.Seek(sfo_offset);
+    file.WriteRaw<u8>(sfo.data(), sfo.size());
+    file.Close();
+
+    // Encrypt everything past the PFS header in place, sector numbers are relative to the
+    // image like in PKG::ExtractFiles.
+    std::array<u8, 16> data_key;
+    std::array<u8, 16> tweak_key;
+    Crypto crypto;
+    crypto.PfsGenCryptoKey(result.ekpfs, pfs_seed, data_key, tweak_key);
+
+    Common::FS::IOFile image(pkg_path, Common::FS::FileAccessMode::ReadWrite);
+    if (!image.IsOpen()) {
+        failreason = fmt::format("Could not reopen {}", pkg_path.string());
+        return false;
+    }
+    std::vector<u8> plain(EncryptChunkSize);
+    std::vector<u8> cipher(EncryptChunkSize);
+    for (u64 pos = PfscOffset; pos < image_size; pos += EncryptChunkSize) {
+        const u64 chunk = std::min(EncryptChunkSize, image_size - pos);
+        const std::span<u8> plain_chunk(plain.data(), chunk);
+        const std::span<u8> cipher_chunk(cipher.data(), chunk);
+        if (!image.Seek(image_offset + pos) ||
+            image.ReadRaw<u8>(plain_chunk.data(), chunk) != chunk) {
+            failreason = "Failed to read back the PFS image";
+            return false;
+        }
+        crypto.encryptPFS(data_key, tweak_key, plain_chunk, cipher_chunk, pos / XtsSectorSize);
+        image.Seek(image_offset + pos);
+        if (image.WriteRaw<u8>(cipher_chunk.data(), chunk) != chunk) {
+            failreason = "Failed to write the encrypted PFS image";
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace Benchmark
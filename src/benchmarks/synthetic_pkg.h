@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "common/types.h"
+
+namespace Benchmark {
+
+struct SyntheticPkgOptions {
+    u64 payload_size = 256ULL * 1024 * 1024; ///< Total size of the generated files
+    u32 file_count = 64;
+    u32 dir_count = 4;
+    /// Share of every 64 KiB block that is filled with a repeating pattern instead of random
+    /// bytes, 0.0 produces incompressible blocks that are stored raw.
+    double compressibility = 0.5;
+    u32 seed = 1;
+    int compression_level = 6;
+};
+
+struct SyntheticFile {
+    std::filesystem::path relative_path; ///< Relative to the extracted title folder
+    u64 size = 0;
+    u64 checksum = 0; ///< FNV-1a 64 of the contents
+};
+
+struct SyntheticPkg {
+    std::string title_id;
+    std::array<u8, 32> ekpfs{}; ///< Test key, the PKG carries no RSA wrapped key entries
+    u64 payload_size = 0;
+    u64 pfs_image_size = 0;
+    u64 compressed_blocks = 0;
+    u64 stored_blocks = 0;
+    std::vector<SyntheticFile> files;
+};
+
+/**
+ * Writes a PKG with a single unencrypted param.sfo entry and a PFS image holding a random
+ * file tree. The image is PFSC compressed with libdeflate and AES-XTS encrypted with keys
+ * derived from a generated EKPFS, so it goes through the same path as retail content once the
+ * EKPFS is handed to PKG::Extract.
+ */
+bool WriteSyntheticPkg(const std::filesystem::path& pkg_path, const SyntheticPkgOptions& options,
+                       SyntheticPkg& result, std::string& failreason);
+
+u64 Fnv1a64(const u8* data, size_t size, u64 hash = 0xcbf29ce484222325ULL);
+
+} // namespace Benchmark
@@ -0,0 +1,310 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Trophy extraction benchmark. Generates a library of synthetic titles, each with a npbind.dat
+// and a trophy00.trp of PNG icons and ESFM files, and runs TRP::Extract over all of them: once
+// from scratch and once more with every set up to date. The extracted XML is checked against
+// decrypting the ESFM entries one by one. Needs no retail content or keys.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+
+#include "common/crypto.h"
+#include "common/io_file.h"
+#include "common/key_manager.h"
+#include "core/file_format/npbind.h"
+#include "core/file_format/trp.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr double MiB = 1024.0 * 1024.0;
+constexpr std::array<u8, 16> TrophyKey{0x21, 0x43, 0x65, 0x87};
+
+struct BenchOptions {
+    u32 titles = 200;   // A large library
+    u32 trophies = 50;  // Icons per trophy set
+    u32 esfm_files = 4; // TROP.ESFM and the TROP_xx.ESFM of a few languages
+    u32 icon_kib = 24;
+    u32 esfm_kib = 96;
+    std::filesystem::path work_dir = std::filesystem::temp_directory_path() / "trp_bench";
+    bool keep = false;
+};
+
+double Seconds(Clock::duration time) {
+    return std::chrono::duration<double>(time).count();
+}
+
+void PrintUsage() {
+    fmt::print("Usage: trp_bench [options]\n"
+               "  --titles <n>        titles in the library (default 200)\n"
+               "  --trophies <n>      trophy icons per set (default 50)\n"
+               "  --esfm-files <n>    ESFM files per set (default 4)\n"
+               "  --icon-kib <n>      size of one icon in KiB (default 24)\n"
+               "  --esfm-kib <n>      size of one ESFM file in KiB (default 96)\n"
+               "  --work <dir>        working directory (default: temp dir)\n"
+               "  --keep              keep the generated and extracted files\n");
+}
+
+template <typename T>
+bool ParseNumber(std::string_view text, T& value) {
+    const auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc{} && ptr == text.data() + text.size();
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto next = [&]() -> std::string_view { return i + 1 < argc ? argv[++i] : ""; };
+
+        bool ok = true;
+        if (arg == "--titles") {
+            ok = ParseNumber(next(), options.titles) && options.titles > 0;
+        } else if (arg == "--trophies") {
+            ok = ParseNumber(next(), options.trophies) && options.trophies <= 1000;
+        } else if (arg == "--esfm-files") {
+            ok = ParseNumber(next(), options.esfm_files) && options.esfm_files <= 100;
+        } else if (arg == "--icon-kib") {
+            ok = ParseNumber(next(), options.icon_kib) && options.icon_kib > 0;
+        } else if (arg == "--esfm-kib") {
+            ok = ParseNumber(next(), options.esfm_kib) && options.esfm_kib > 0;
+        } else if (arg == "--work") {
+            const auto dir = next();
+            ok = !dir.empty();
+            options.work_dir = std::filesystem::path(dir);
+        } else if (arg == "--keep") {
+            options.keep = true;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            fmt::print(stderr, "Invalid argument: {}\n", arg);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+void Append(std::vector<u8>& out, const T& object) {
+    const auto* bytes = reinterpret_cast<const u8*>(&object);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+std::array<u8, 12> NpCommId(u32 title) {
+    const std::string id = fmt::format("NPWR{:05}_00", title);
+    std::array<u8, 12> out;
+    std::memcpy(out.data(), id.data(), out.size());
+    return out;
+}
+
+// One body, npcommid first, in the layout NPBindFile::Load parses.
+std::vector<u8> MakeNpBind(u32 title) {
+    std::vector<u8> out;
+    NpBindHeader header{};
+    header.magic = NPBIND_MAGIC;
+    header.version = 1;
+    header.entry_size = 0x180;
+    header.num_entries = 1;
+    Append(out, header);
+
+    const auto entry = [&](u16 type, std::span<const u8> data) {
+        u16_be value;
+        Append(out, value = type);
+        Append(out, value = static_cast<u16>(data.size()));
+        out.insert(out.end(), data.begin(), data.end());
+    };
+    const auto np_comm_id = NpCommId(title);
+    entry(0x0010, np_comm_id);
+    entry(0x0011, std::array<u8, 12>{});
+    entry(0x0012, std::array<u8, 176>{});
+    entry(0x0013, std::array<u8, 16>{});
+    out.resize(out.size() + 0x98 + 20); // Body padding and digest
+    header.file_size = out.size();
+    std::memcpy(out.data(), &header, sizeof(header));
+    return out;
+}
+
+std::vector<u8> MakeTrp(const BenchOptions& options, u32 title, std::mt19937& rng) {
+    struct Entry {
+        std::string name;
+        u32 flag;
+        size_t size;
+    };
+    std::vector<Entry> entries;
+    for (u32 i = 0; i < options.trophies; ++i) {
+        entries.push_back({fmt::format("TROP{:03}.PNG", i), 0, options.icon_kib * 1024u});
+    }
+    for (u32 i = 0; i < options.esfm_files; ++i) {
+        // An IV, then whole blocks of ciphertext
+        const std::string name = i == 0 ? "TROP.ESFM" : fmt::format("TROP_{:02}.ESFM", i);
+        entries.push_back({name, 3, 16 + options.esfm_kib * 1024u});
+    }
+
+    const u64 data_start = sizeof(TrpHeader) + entries.size() * sizeof(TrpEntry);
+    u64 file_size = data_start;
+    for (const auto& entry : entries) {
+        file_size += entry.size;
+    }
+
+    std::vector<u8> out;
+    out.reserve(file_size);
+    TrpHeader header{};
+    header.magic = 0xDCA24D00;
+    header.version = 2;
+    header.file_size = file_size;
+    header.entry_num = static_cast<u32>(entries.size());
+    header.entry_size = sizeof(TrpEntry);
+    std::memcpy(header.digest, &title, sizeof(title)); // Unique per title, like a real digest
+    Append(out, header);
+
+    u64 pos = data_start;
+    for (const auto& entry : entries) {
+        TrpEntry raw{};
+        std::memcpy(raw.entry_name, entry.name.data(), entry.name.size());
+        raw.entry_pos = pos;
+        raw.entry_len = entry.size;
+        raw.flag = entry.flag;
+        Append(out, raw);
+        pos += entry.size;
+    }
+    for (const auto& entry : entries) {
+        for (size_t i = 0; i < entry.size; ++i) {
+            out.push_back(static_cast<u8>(rng()));
+        }
+    }
+    return out;
+}
+
+// The extracted XML has to match decrypting every ESFM entry on its own.
+bool Verify(u32 title, const std::vector<u8>& trp, const std::filesystem::path& set_dir) {
+    Crypto crypto;
+    std::array<u8, 16> key = TrophyKey;
+    std::array<u8, 16> np_comm_id{};
+    const auto id = NpCommId(title);
+    std::copy(id.begin(), id.end(), np_comm_id.begin());
+
+    TrpHeader header;
+    std::memcpy(&header, trp.data(), sizeof(header));
+    for (u32 i = 0; i < header.entry_num; ++i) {
+        TrpEntry entry;
+        std::memcpy(&entry, trp.data() + sizeof(TrpHeader) + i * sizeof(TrpEntry), sizeof(entry));
+        const std::string name(entry.entry_name, strnlen(entry.entry_name, 32));
+        const u8* data = trp.data() + entry.entry_pos;
+        if (entry.flag == 0) {
+            if (!std::filesystem::exists(set_dir / "Icons" / name)) {
+                fmt::print(stderr, "Verify: icon {} is missing\n", name);
+                return false;
+            }
+            continue;
+        }
+
+        std::array<u8, 16> iv;
+        std::copy_n(data, iv.size(), iv.begin());
+        std::vector<u8> expected(data + 16, data + entry.entry_len);
+        crypto.decryptEFSM(key, np_comm_id, iv, expected, expected);
+        const auto last = std::find(expected.rbegin(), expected.rend(), '>');
+        expected.resize(last == expected.rend() ? expected.size() : last.base() - expected.begin());
+
+        const std::string xml_name = name.substr(0, name.find("ESFM")) + "XML";
+        Common::FS::IOFile in(set_dir / "Xml" / xml_name, Common::FS::FileAccessMode::Read);
+        std::vector<u8> actual(in.IsOpen() ? in.GetSize() : 0);
+        if (!in.IsOpen() || in.ReadRaw<u8>(actual.data(), actual.size()) != actual.size() ||
+            actual != expected) {
+            fmt::print(stderr, "Verify: {} differs from the reference decryption\n", xml_name);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    auto keys = KeyManager::GetInstance()->GetAllKeys();
+    keys.TrophyKeySet.ReleaseTrophyKey.assign(TrophyKey.begin(), TrophyKey.end());
+    KeyManager::GetInstance()->SetAllKeys(keys);
+
+    const auto library = options.work_dir / "library";
+    const auto output = options.work_dir / "TrophyFiles";
+    std::error_code ec;
+    std::filesystem::remove_all(options.work_dir, ec);
+
+    std::mt19937 rng(1);
+    std::vector<u8> first_trp;
+    u64 total_bytes = 0;
+    for (u32 title = 0; title < options.titles; ++title) {
+        const auto sce_sys = library / fmt::format("CUSA{:05}", title) / "sce_sys";
+        std::filesystem::create_directories(sce_sys / "trophy");
+        const auto trp = MakeTrp(options, title, rng);
+        Common::FS::IOFile::WriteBytes(sce_sys / "npbind.dat", MakeNpBind(title));
+        Common::FS::IOFile::WriteBytes(sce_sys / "trophy" / "trophy00.trp", trp);
+        total_bytes += trp.size();
+        if (title == 0) {
+            first_trp = trp;
+        }
+    }
+    fmt::print("{} titles, {:.1f} MiB of trophy files\n", options.titles, total_bytes / MiB);
+
+    // Same path as the trophy viewer: npbind.dat parsed once per title, then every set
+    const auto extract_all = [&](u32& skipped) {
+        skipped = 0;
+        for (u32 title = 0; title < options.titles; ++title) {
+            const std::string title_id = fmt::format("CUSA{:05}", title);
+            NPBindFile npbind;
+            npbind.Load(library / title_id / "sce_sys" / "npbind.dat");
+            TRP trp;
+            if (!trp.Extract(library / title_id, npbind, output / title_id)) {
+                fmt::print(stderr, "Extraction of {} failed\n", title_id);
+                return false;
+            }
+            skipped += trp.GetSkippedCount();
+        }
+        return true;
+    };
+
+    u32 skipped = 0;
+    auto start = Clock::now();
+    if (!extract_all(skipped)) {
+        return EXIT_FAILURE;
+    }
+    const double cold = Seconds(Clock::now() - start);
+    fmt::print("{:<24} {:>8.3f} s  {:>9.1f} MiB/s  {:>8.2f} ms/title\n", "Extract", cold,
+               total_bytes / MiB / std::max(cold, 1e-9), cold * 1e3 / options.titles);
+
+    if (!Verify(0, first_trp, output / "CUSA00000" / "trophy00")) {
+        return EXIT_FAILURE;
+    }
+
+    start = Clock::now();
+    if (!extract_all(skipped)) {
+        return EXIT_FAILURE;
+    }
+    const double warm = Seconds(Clock::now() - start);
+    fmt::print("{:<24} {:>8.3f} s  {:>9} sets skipped   {:>8.2f} ms/title\n",
+               "Extract (up to date)", warm, skipped, warm * 1e3 / options.titles);
+    if (skipped != options.titles) {
+        fmt::print(stderr, "Expected every trophy set to be skipped\n");
+        return EXIT_FAILURE;
+    }
+
+    if (!options.keep) {
+        std::filesystem::remove_all(options.work_dir, ec);
+    }
+    return EXIT_SUCCESS;
+}
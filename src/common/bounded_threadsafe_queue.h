@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -46,6 +48,13 @@ public:
         Pop<PopMode::WaitWithStopToken>(t, stop_token);
     }
 
+    /// Returns false if nothing was pushed within rel_time or a stop was requested.
+    template <typename Rep, typename Period>
+    bool PopWaitFor(T& t, const std::chrono::duration<Rep, Period>& rel_time,
+                    std::stop_token stop_token) {
+        return Pop<PopMode::WaitForWithStopToken>(t, stop_token, rel_time);
+    }
+
     T PopWait() {
         T t;
         Pop<PopMode::Wait>(t);
@@ -69,6 +78,7 @@ private:
         Try,
         Wait,
         WaitWithStopToken,
+        WaitForWithStopToken,
         Count,
     };
 
@@ -108,7 +118,8 @@ private:
     }
 
     template <PopMode Mode>
-    bool Pop(T& t, [[maybe_unused]] std::stop_token stop_token = {}) {
+    bool Pop(T& t, [[maybe_unused]] std::stop_token stop_token = {},
+             [[maybe_unused]] std::chrono::nanoseconds rel_time = {}) {
         const std::size_t read_index = m_read_index.load(std::memory_order::relaxed);
 
         if constexpr (Mode == PopMode::Try) {
@@ -131,6 +142,16 @@ private:
             if (stop_token.stop_requested()) {
                 return false;
             }
+        } else if constexpr (Mode == PopMode::WaitForWithStopToken) {
+            // Wait until the queue is not empty or the time runs out.
+            std::unique_lock lock{consumer_cv_mutex};
+            if (!Common::CondvarWaitFor(consumer_cv, lock, stop_token, rel_time,
+                                        [this, read_index] {
+                                            return read_index !=
+                                                   m_write_index.load(std::memory_order::acquire);
+                                        })) {
+                return false;
+            }
         } else {
             static_assert(Mode < PopMode::Count, "Invalid PopMode.");
         }
@@ -189,6 +210,12 @@ public:
         spsc_queue.PopWait(t, stop_token);
     }
 
+    template <typename Rep, typename Period>
+    bool PopWaitFor(T& t, const std::chrono::duration<Rep, Period>& rel_time,
+                    std::stop_token stop_token) {
+        return spsc_queue.PopWaitFor(t, rel_time, stop_token);
+    }
+
     T PopWait() {
         return spsc_queue.PopWait();
     }
@@ -1,13 +1,26 @@
 ﻿// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef _WIN32
 #include <Windows.h>
 #include <bcrypt.h>
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
 #include "crypto.h"
-#include "key_manager.h"
 #include "picosha2.h"
+#ifdef _WIN32
+#include "key_manager.h"
+#endif
 
+#ifdef _WIN32
 template <typename TKeyset>
 static BCRYPT_KEY_HANDLE ImportRsaPrivateKey(const TKeyset& keyset) {
     BCRYPT_ALG_HANDLE alg = nullptr;
@@ -85,6 +98,14 @@ void Crypto::RSA2048Decrypt(std::span<u8, 32> dec_key, std::span<const u8, 256>
 
     std::copy_n(plaintext.begin(), dec_key.size(), dec_key.begin());
 }
+#else
+void Crypto::RSA2048Decrypt(std::span<u8, 32> dec_key, std::span<const u8, 256> ciphertext,
+                            bool is_dk3) {
+    // Only the CNG backend implements RSA. The AES/XTS paths below are portable, which is
+    // enough for content that ships its EKPFS in clear (see PKG::Extract with a preset key).
+    throw std::runtime_error("RSA decryption is only supported on Windows");
+}
+#endif
 
 inline void xtsMult(__m128i& tweak) {
     // Shift tweak left by 1 bit (128-bit)
@@ -225,6 +246,87 @@ __attribute__((target("aes"))) inline void aes128_decrypt_block(const u8 in[16],
     _mm_storeu_si128(reinterpret_cast<__m128i*>(out), block);
 }
 
+// CBC decryption has no dependency between blocks (only the final XOR needs the previous
+// ciphertext), so eight blocks go through the AES rounds together to hide the aesdec latency.
+// All ciphertext of a batch is loaded before anything is stored, which makes in == out safe.
+__attribute__((target("aes"))) static void aes128_cbc_decrypt(const AES128Key& rk, __m128i iv,
+                                                              const u8* in, u8* out,
+                                                              size_t num_blocks) {
+    constexpr size_t LANES = 8;
+    const auto load = [](const u8* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    };
+    const auto store = [](u8* p, __m128i v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    };
+
+    size_t i = 0;
+    for (; i + LANES <= num_blocks; i += LANES) {
+        const u8* src = in + i * 16;
+        const __m128i c0 = load(src + 0 * 16), c1 = load(src + 1 * 16);
+        const __m128i c2 = load(src + 2 * 16), c3 = load(src + 3 * 16);
+        const __m128i c4 = load(src + 4 * 16), c5 = load(src + 5 * 16);
+        const __m128i c6 = load(src + 6 * 16), c7 = load(src + 7 * 16);
+
+        __m128i k = rk.roundKeys[0];
+        __m128i b0 = _mm_xor_si128(c0, k), b1 = _mm_xor_si128(c1, k);
+        __m128i b2 = _mm_xor_si128(c2, k), b3 = _mm_xor_si128(c3, k);
+        __m128i b4 = _mm_xor_si128(c4, k), b5 = _mm_xor_si128(c5, k);
+        __m128i b6 = _mm_xor_si128(c6, k), b7 = _mm_xor_si128(c7, k);
+        for (int r = 1; r < 10; ++r) {
+            k = rk.roundKeys[r];
+            b0 = _mm_aesdec_si128(b0, k);
+            b1 = _mm_aesdec_si128(b1, k);
+            b2 = _mm_aesdec_si128(b2, k);
+            b3 = _mm_aesdec_si128(b3, k);
+            b4 = _mm_aesdec_si128(b4, k);
+            b5 = _mm_aesdec_si128(b5, k);
+            b6 = _mm_aesdec_si128(b6, k);
+            b7 = _mm_aesdec_si128(b7, k);
+        }
+        k = rk.roundKeys[10];
+
+        u8* dst = out + i * 16;
+        store(dst + 0 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b0, k), iv));
+        store(dst + 1 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b1, k), c0));
+        store(dst + 2 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b2, k), c1));
+        store(dst + 3 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b3, k), c2));
+        store(dst + 4 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b4, k), c3));
+        store(dst + 5 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b5, k), c4));
+        store(dst + 6 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b6, k), c5));
+        store(dst + 7 * 16, _mm_xor_si128(_mm_aesdeclast_si128(b7, k), c6));
+        iv = c7;
+    }
+    for (; i < num_blocks; ++i) {
+        const __m128i c = load(in + i * 16);
+        __m128i b = _mm_xor_si128(c, rk.roundKeys[0]);
+        for (int r = 1; r < 10; ++r) {
+            b = _mm_aesdec_si128(b, rk.roundKeys[r]);
+        }
+        store(out + i * 16, _mm_xor_si128(_mm_aesdeclast_si128(b, rk.roundKeys[10]), iv));
+        iv = c;
+    }
+}
+
+// The EFSM files of a trophy set share one key. The expanded decryption schedule of the last key
+// is kept per thread so repeated calls skip the key setup. NP entries derive a key per entry and
+// set it up directly.
+struct CbcKeyCache {
+    std::array<u8, 32> id{};
+    bool valid = false;
+    AES128Key dec;
+
+    template <typename MakeKey>
+    const AES128Key& Get(std::span<const u8> key_id, MakeKey&& make_key) {
+        if (!valid || !std::equal(key_id.begin(), key_id.end(), id.begin())) {
+            make_key(dec);
+            std::copy(key_id.begin(), key_id.end(), id.begin());
+            valid = true;
+        }
+        return dec;
+    }
+};
+
 inline bool cpu_supports_avx2() {
     int info[4] = {0, 0, 0, 0};
 
@@ -359,65 +461,66 @@ __attribute__((target("aes"))) void Crypto::decryptPFS_AVX2(std::span<const u8,
     }
 }
 
+__attribute__((target("aes"))) void Crypto::encryptPFS(std::span<const u8, 16> dataKey,
+                                                       std::span<const u8, 16> tweakKey,
+                                                       std::span<const u8> src_image,
+                                                       std::span<u8> dst_image, u64 sector_start) {
+    if (src_image.size() != dst_image.size())
+        throw std::runtime_error("src and dst sizes must match");
+
+    AES128Key aesTweakEncKey, aesDataEncKey;
+    aes128_set_encrypt_key(tweakKey.data(), aesTweakEncKey);
+    aes128_set_encrypt_key(dataKey.data(), aesDataEncKey);
+
+    constexpr size_t SECTOR_SIZE = 0x1000;
+    constexpr size_t BLOCK_SIZE = 16;
+
+    size_t total_sectors = src_image.size() / SECTOR_SIZE;
+
+    for (size_t s = 0; s < total_sectors; ++s) {
+        u64 current_sector = sector_start + s;
+        __m128i tweak = _mm_set_epi64x(0, current_sector);
+        aes128_encrypt_block(reinterpret_cast<u8*>(&tweak), reinterpret_cast<u8*>(&tweak),
+                             aesTweakEncKey);
+
+        for (size_t block_offset = 0; block_offset < SECTOR_SIZE; block_offset += BLOCK_SIZE) {
+            size_t pos = s * SECTOR_SIZE + block_offset;
+
+            __m128i block =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src_image.data() + pos));
+            block = xtsXorBlock(block, tweak);
+            aes128_encrypt_block(reinterpret_cast<u8*>(&block), reinterpret_cast<u8*>(&block),
+                                 aesDataEncKey);
+            block = xtsXorBlock(block, tweak);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_image.data() + pos), block);
+
+            xtsMult(tweak);
+        }
+    }
+}
+
 __attribute__((target("aes"))) void Crypto::aesCbcCfb128DecryptEntry(std::span<const u8, 32> ivkey,
                                                                      std::span<u8> ciphertext,
                                                                      std::span<u8> decrypted) {
     constexpr size_t BLOCK_SIZE = 16;
-    constexpr size_t KEY_SIZE = 16;
 
     // Validate inputs
     if (ciphertext.size() != decrypted.size()) {
         throw std::runtime_error("Ciphertext and decrypted buffer sizes must match");
     }
 
-    /*printf("ivkey.size() = %zu\n", ivkey.size());
-    printf("ivkey.data() = %p\n", (void*)ivkey.data());
-    printf("ciphertext.size() = %zu\n", ciphertext.size());
-    printf("decrypted.size() = %zu\n", decrypted.size());*/
-
-    if (!ivkey.data()) {
-        throw std::runtime_error("ivkey.data() is NULL!");
-    }
-
-    if (ivkey.size() < 32) {
-        throw std::runtime_error("ivkey too small: " + std::to_string(ivkey.size()));
-    }
-
-    std::array<u8, 16> key;
-    std::array<u8, 16> iv;
-
-    std::memcpy(key.data(), ivkey.data() + 16, 16);
-    std::memcpy(iv.data(), ivkey.data(), 16);
-
-    // Setup AES
+    // Key is the upper half of ivkey, IV the lower half
     AES128Key aesEncKey, aesDecKey;
-    aes128_set_encrypt_key(key.data(), aesEncKey);
+    aes128_set_encrypt_key(ivkey.data() + BLOCK_SIZE, aesEncKey);
     aes128_set_decrypt_key(aesEncKey, aesDecKey);
 
-    // CBC decryption
-    __m128i prevCipherBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv.data()));
-
-    for (size_t offset = 0; offset < ciphertext.size(); offset += BLOCK_SIZE) {
-        const u8* cipher_ptr = ciphertext.data() + offset;
-        u8* decrypted_ptr = decrypted.data() + offset;
-
-        // Load ciphertext
-        __m128i cipherBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cipher_ptr));
-
-        // Decrypt
-        alignas(16) u8 decryptedBlock[BLOCK_SIZE];
-        aes128_decrypt_block(cipher_ptr, decryptedBlock, aesDecKey);
+    const size_t num_blocks = ciphertext.size() / BLOCK_SIZE;
+    aes128_cbc_decrypt(aesDecKey, _mm_loadu_si128(reinterpret_cast<const __m128i*>(ivkey.data())),
+                       ciphertext.data(), decrypted.data(), num_blocks);
 
-        // XOR with previous block
-        __m128i plainBlock = _mm_xor_si128(
-            _mm_load_si128(reinterpret_cast<const __m128i*>(decryptedBlock)), prevCipherBlock);
-
-        // Store result
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(decrypted_ptr), plainBlock);
-
-        // Update previous block
-        prevCipherBlock = cipherBlock;
-    }
+    // CBC without padding cannot decrypt a trailing partial block, pass it through
+    const size_t tail = num_blocks * BLOCK_SIZE;
+    std::memmove(decrypted.data() + tail, ciphertext.data() + tail, ciphertext.size() - tail);
 }
 
 __attribute__((target("aes"))) void Crypto::aesCbcCfb128Decrypt(std::span<const u8, 32> ivkey,
@@ -426,42 +529,13 @@ __attribute__((target("aes"))) void Crypto::aesCbcCfb128Decrypt(std::span<const
     constexpr size_t BLOCK_SIZE = 16;
     constexpr size_t NUM_BLOCKS = 256 / BLOCK_SIZE;
 
-    // Extract key and IV
-    alignas(16) u8 key[BLOCK_SIZE];
-    alignas(16) u8 iv[BLOCK_SIZE];
-
-    std::memcpy(key, ivkey.data() + BLOCK_SIZE, BLOCK_SIZE);
-    std::memcpy(iv, ivkey.data(), BLOCK_SIZE);
-
-    // Setup AES keys
+    // Setup AES keys (upper half of ivkey), the IV is the lower half
     AES128Key aesEncKey, aesDecKey;
-    aes128_set_encrypt_key(key, aesEncKey);
+    aes128_set_encrypt_key(ivkey.data() + BLOCK_SIZE, aesEncKey);
     aes128_set_decrypt_key(aesEncKey, aesDecKey);
 
-    // CBC chaining value
-    __m128i prevCipherBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
-
-    for (size_t i = 0; i < NUM_BLOCKS; ++i) {
-        const u8* cptr = ciphertext.data() + i * BLOCK_SIZE;
-        u8* dptr = decrypted.data() + i * BLOCK_SIZE;
-
-        // Load ciphertext block
-        __m128i cipherBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cptr));
-
-        // AES-128 decrypt
-        alignas(16) u8 decryptedBlock[BLOCK_SIZE];
-        aes128_decrypt_block(cptr, decryptedBlock, aesDecKey);
-
-        // CBC XOR
-        __m128i plainBlock = _mm_xor_si128(
-            _mm_load_si128(reinterpret_cast<const __m128i*>(decryptedBlock)), prevCipherBlock);
-
-        // Store plaintext
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(dptr), plainBlock);
-
-        // Update chaining value
-        prevCipherBlock = cipherBlock;
-    }
+    aes128_cbc_decrypt(aesDecKey, _mm_loadu_si128(reinterpret_cast<const __m128i*>(ivkey.data())),
+                       ciphertext.data(), decrypted.data(), NUM_BLOCKS);
 }
 
 inline void ivKeyHASH256_software(std::span<const u8, 64> cipher_input,
@@ -545,44 +619,25 @@ __attribute__((target("aes"))) void Crypto::decryptEFSM(std::span<u8, 16> trophy
         throw std::runtime_error("Invalid ciphertext/decrypted sizes");
     }
 
-    // Step 1: Encrypt NPcommID with trophyKey (ECB since IV is zero)
-    AES128Key trophyEncKey;
-    aes128_set_encrypt_key(trophyKey.data(), trophyEncKey);
-
-    alignas(16) std::array<u8, BLOCK_SIZE> trpKey;
-    aes128_encrypt_block(NPcommID.data(), trpKey.data(), trophyEncKey);
-
-    // Step 2: Setup decryption for trpKey
-    AES128Key trpEncKey, trpDecKey;
-    aes128_set_encrypt_key(trpKey.data(), trpEncKey);
-    aes128_set_decrypt_key(trpEncKey, trpDecKey);
-
-    // CBC decryption
-    __m128i prevCipherBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(efsmIv.data()));
+    // The CBC key is NPcommID encrypted with trophyKey (ECB since IV is zero)
+    std::array<u8, 2 * BLOCK_SIZE> key_id;
+    std::copy(trophyKey.begin(), trophyKey.end(), key_id.begin());
+    std::copy(NPcommID.begin(), NPcommID.end(), key_id.begin() + BLOCK_SIZE);
 
-    size_t num_blocks = ciphertext.size() / BLOCK_SIZE;
+    thread_local CbcKeyCache key_cache;
+    const AES128Key& trpDecKey = key_cache.Get(key_id, [&](AES128Key& dec) {
+        AES128Key trophyEncKey;
+        aes128_set_encrypt_key(trophyKey.data(), trophyEncKey);
 
-    for (size_t i = 0; i < num_blocks; ++i) {
-        size_t offset = i * BLOCK_SIZE;
-        const u8* cipher_ptr = ciphertext.data() + offset;
-        u8* decrypted_ptr = decrypted.data() + offset;
+        alignas(16) std::array<u8, BLOCK_SIZE> trpKey;
+        aes128_encrypt_block(NPcommID.data(), trpKey.data(), trophyEncKey);
 
-        // Load ciphertext
-        __m128i cipherBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cipher_ptr));
+        AES128Key trpEncKey;
+        aes128_set_encrypt_key(trpKey.data(), trpEncKey);
+        aes128_set_decrypt_key(trpEncKey, dec);
+    });
 
-        // Use your aes128_decrypt_block function
-        alignas(16) u8 decryptedBlockBytes[BLOCK_SIZE];
-        aes128_decrypt_block(cipher_ptr, decryptedBlockBytes, trpDecKey);
-
-        // XOR with previous block
-        __m128i decryptedBlock =
-            _mm_load_si128(reinterpret_cast<const __m128i*>(decryptedBlockBytes));
-        __m128i plainBlock = _mm_xor_si128(decryptedBlock, prevCipherBlock);
-
-        // Store result
-        _mm_storeu_si128(reinterpret_cast<__m128i*>(decrypted_ptr), plainBlock);
-
-        // Update previous block
-        prevCipherBlock = cipherBlock;
-    }
-}
\ No newline at end of file
+    // A trailing partial block is left untouched, as before
+    aes128_cbc_decrypt(trpDecKey, _mm_loadu_si128(reinterpret_cast<const __m128i*>(efsmIv.data())),
+                       ciphertext.data(), decrypted.data(), ciphertext.size() / BLOCK_SIZE);
+}
@@ -25,4 +25,7 @@ public:
                         std::span<const u8> src_image, std::span<u8> dst_image, u64 sector);
     void decryptPFS_AVX2(std::span<const u8, 16> dataKey, std::span<const u8, 16> tweakKey,
                          std::span<const u8> src_image, std::span<u8> dst_image, u64 sector);
+    // Inverse of decryptPFS, used to build synthetic PFS images.
+    void encryptPFS(std::span<const u8, 16> dataKey, std::span<const u8, 16> tweakKey,
+                    std::span<const u8> src_image, std::span<u8> dst_image, u64 sector);
 };
@@ -170,6 +170,7 @@ IOFile::IOFile(IOFile&& other) noexcept {
     std::swap(file_access_mode, other.file_access_mode);
     std::swap(file_type, other.file_type);
     std::swap(file, other.file);
+    std::swap(file_mapping, other.file_mapping);
 }
 
 IOFile& IOFile::operator=(IOFile&& other) noexcept {
@@ -177,6 +178,7 @@ IOFile& IOFile::operator=(IOFile&& other) noexcept {
     std::swap(file_access_mode, other.file_access_mode);
     std::swap(file_type, other.file_type);
     std::swap(file, other.file);
+    std::swap(file_mapping, other.file_mapping);
     return *this;
 }
 
@@ -233,6 +235,7 @@ void IOFile::Close() {
         CloseHandle(std::bit_cast<HANDLE>(file_mapping));
     }
 #endif
+    file_mapping = 0;
 }
 
 void IOFile::Unlink() {
@@ -253,11 +256,9 @@ void IOFile::Unlink() {
     NtSetInformationFile(hfile, &iosb, &disposition, sizeof(disposition),
                          FileDispositionInformation);
 #else
-    if (unlink(file_path.c_str()) != 0) {
-        const auto ec = std::error_code{errno, std::generic_category()};
-        LOG_ERROR(Common_Filesystem, "Failed to unlink the file at path={}, ec_message={}",
-                  PathToUTF8String(file_path), ec.message());
-    }
+    // Logging is not linked into this file (see the includes above), failures are ignored
+    // like on Windows.
+    unlink(file_path.c_str());
 #endif
 }
 
@@ -1,9 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <memory>
+#include <thread>
+#include <unordered_map>
+#include "common/mapped_file.h"
 #include "log_analyzer.h"
 #include "logging/log.h"
 
@@ -11,15 +14,187 @@ namespace LogAnalyzer {
 
 std::vector<std::unique_ptr<Entry>> entries;
 
-inline std::string trim(std::string const& str) {
+inline std::string_view trim(std::string_view str) {
     auto start = std::ranges::find_if_not(str.begin(), str.end(),
                                           [](unsigned char c) { return std::isspace(c); });
     auto end = std::ranges::find_if_not(str.rbegin(), str.rend(), [](unsigned char c) {
                    return std::isspace(c);
                }).base();
-    return (start < end) ? std::string(start, end) : std::string();
+    return (start < end) ? std::string_view(start, end) : std::string_view();
 }
 
+namespace {
+
+// Logs are split in chunks of at least this size, one per thread.
+constexpr size_t MinChunkSize = 4 * 1024 * 1024;
+
+// Matches of every entry in one chunk of the log, in line order.
+struct ChunkResult {
+    std::vector<int> counts;
+    std::vector<std::vector<string>> data;
+};
+
+// "[Class] <Level> " at the start of a log line or pattern, empty if there is none.
+std::string_view GetHead(std::string_view text) {
+    if (text.empty() || text[0] != '[') {
+        return {};
+    }
+    const size_t class_end = text.find("] <");
+    if (class_end == text.npos) {
+        return {};
+    }
+    const size_t level_end = text.find("> ", class_end + 3);
+    if (level_end == text.npos) {
+        return {};
+    }
+    return text.substr(0, level_end + 2);
+}
+
+bool HasWildcard(std::string_view text) {
+    return text.find_first_of("#@*+^") != text.npos;
+}
+
+/**
+ * The suite compiled for matching many lines. Entries are grouped by the fixed "[Class] <Level> "
+ * head of their pattern and then by the source file after the optional thread name, so a line is
+ * only matched against the entries that can match it. Most lines of a big log have a head no
+ * entry uses and cost one hash lookup.
+ */
+class SuiteMatcher {
+public:
+    explicit SuiteMatcher(const std::vector<std::unique_ptr<Entry>>& suite) : suite{suite} {
+        for (size_t i = 0; i < suite.size(); ++i) {
+            const std::string_view pattern = suite[i]->pattern;
+            const std::string_view head = GetHead(pattern);
+            if (head.empty() || HasWildcard(head)) {
+                unprefixed.push_back(i);
+                continue;
+            }
+
+            HeadGroup& group = heads[head];
+            const std::string_view rest = pattern.substr(head.size());
+            const size_t file_end = rest.find(':');
+            const std::string_view file =
+                file_end == rest.npos ? std::string_view{} : rest.substr(0, file_end);
+            if (!file.starts_with("^ ") || file.size() == 2 || HasWildcard(file.substr(1))) {
+                group.others.push_back(i);
+                continue;
+            }
+            const auto it = std::ranges::find(group.files, file.substr(2), &FileGroup::file);
+            if (it != group.files.end()) {
+                it->entries.push_back(i);
+            } else {
+                group.files.push_back({file.substr(2), {i}});
+            }
+        }
+    }
+
+    void ProcessLine(std::string_view line, ChunkResult& result) const {
+        for (const size_t i : unprefixed) {
+            Match(i, line, result);
+        }
+
+        const std::string_view head = GetHead(line);
+        if (head.empty()) {
+            return;
+        }
+        const auto group = heads.find(head);
+        if (group == heads.end()) {
+            return;
+        }
+        for (const size_t i : group->second.others) {
+            Match(i, line, result);
+        }
+
+        // Same thread name skipping as the ^ of a pattern
+        size_t file_begin = head.size();
+        if (file_begin < line.size() && line[file_begin] == '(') {
+            const size_t thread_end = line.find(')', file_begin);
+            if (thread_end == line.npos || thread_end + 1 >= line.size() ||
+                line[thread_end + 1] != ' ') {
+                return;
+            }
+            file_begin = thread_end + 2;
+        }
+        const size_t file_end = line.find(':', file_begin);
+        if (file_end == line.npos) {
+            return;
+        }
+        const std::string_view file = line.substr(file_begin, file_end - file_begin);
+        for (const FileGroup& file_group : group->second.files) {
+            if (file_group.file == file) {
+                for (const size_t i : file_group.entries) {
+                    Match(i, line, result);
+                }
+            }
+        }
+    }
+
+private:
+    struct FileGroup {
+        std::string_view file;
+        std::vector<size_t> entries;
+    };
+    struct HeadGroup {
+        std::vector<FileGroup> files; ///< Entries of the form "[Class] <Level> ^ file:..."
+        std::vector<size_t> others;
+    };
+
+    void Match(size_t index, std::string_view line, ChunkResult& result) const {
+        const Entry& entry = *suite[index];
+        if ((!entry.is_multiple_occurrence && result.counts[index] != 0) ||
+            line.size() < entry.minimum_line_length) {
+            return;
+        }
+        optional<string> data;
+        if (entry.Match(line, data)) {
+            result.counts[index]++;
+            if (data) {
+                result.data[index].push_back(std::move(*data));
+            }
+        }
+    }
+
+    const std::vector<std::unique_ptr<Entry>>& suite;
+    std::unordered_map<std::string_view, HeadGroup> heads;
+    std::vector<size_t> unprefixed;
+};
+
+void ScanChunk(std::string_view chunk, const SuiteMatcher& matcher, ChunkResult& result) {
+    size_t line_begin = 0;
+    while (line_begin < chunk.size()) {
+        const void* newline =
+            std::memchr(chunk.data() + line_begin, '\n', chunk.size() - line_begin);
+        const size_t line_end =
+            newline ? static_cast<const char*>(newline) - chunk.data() : chunk.size();
+        matcher.ProcessLine(trim(chunk.substr(line_begin, line_end - line_begin)), result);
+        line_begin = line_end + 1;
+    }
+}
+
+// Splits the log at line boundaries into one chunk per thread.
+std::vector<std::string_view> SplitChunks(std::string_view log) {
+    const size_t max_chunks = std::max<size_t>(1, log.size() / MinChunkSize);
+    const size_t num_chunks =
+        std::clamp<size_t>(std::thread::hardware_concurrency(), 1, max_chunks);
+
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    for (size_t i = 1; i <= num_chunks && begin < log.size(); ++i) {
+        size_t end = log.size();
+        if (i != num_chunks) {
+            const size_t target = std::max(begin, log.size() / num_chunks * i);
+            const void* newline = std::memchr(log.data() + target, '\n', log.size() - target);
+            end = newline ? static_cast<const char*>(newline) - log.data() + 1 : log.size();
+        }
+        chunks.push_back(log.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+} // namespace
+
 void LoadSuiteFromInput(std::istream& data) {
     entry_id_counter = 1;
     std::string line;
@@ -36,7 +211,7 @@ void LoadSuiteFromInput(std::istream& data) {
         std::getline(iss, type, ',');
         std::string params;
         while (std::getline(iss, params, ',')) {
-            std::string p = trim(params);
+            const std::string_view p = trim(params);
             if (p == "multiple")
                 multiple = true;
             else if (p == "singular")
@@ -105,7 +280,7 @@ void ResetEntries() {
     }
 }
 
-bool DetectLogTypeAndSetupEntries(std::filesystem::path const& path) {
+bool DetectLogTypeAndSetupEntries(std::string_view first_line) {
     entries.clear();
     enum LogType {
         Release,
@@ -113,14 +288,7 @@ bool DetectLogTypeAndSetupEntries(std::filesystem::path const& path) {
         Old,
     };
     LogType type;
-    std::ifstream log(path);
-    if (!log.is_open()) {
-        return false;
-    }
     bool is_valid = true;
-    std::string first_line;
-    std::getline(log, first_line);
-    first_line = trim(first_line);
     Entry version_test =
         Entry("[Loader] <Info> ^ emulator.cpp:# Run: Starting shadps4 emulator +", "", "");
     version_test.ProcessLine(first_line);
@@ -145,21 +313,47 @@ bool DetectLogTypeAndSetupEntries(std::filesystem::path const& path) {
 }
 
 bool ProcessFile(std::filesystem::path const& path) {
-    bool is_valid_file = DetectLogTypeAndSetupEntries(path);
-    std::ifstream log(path);
-    std::string linebuf;
-    if (log.is_open()) {
-        while (std::getline(log, linebuf)) {
-            linebuf = trim(linebuf);
-            for (auto& entry : entries) {
-                entry->ProcessLine(linebuf);
+    entries.clear();
+    Common::FS::MappedFile file(path);
+    if (!file.IsOpen()) {
+        return false;
+    }
+    const std::string_view log(reinterpret_cast<const char*>(file.Data().data()),
+                               file.Data().size());
+    const size_t first_line_end = std::min(log.find('\n'), log.size());
+    if (!DetectLogTypeAndSetupEntries(trim(log.substr(0, first_line_end)))) {
+        return false;
+    }
+
+    const SuiteMatcher matcher(entries);
+    const std::vector<std::string_view> chunks = SplitChunks(log);
+    std::vector<ChunkResult> results(chunks.size());
+    for (ChunkResult& result : results) {
+        result.counts.resize(entries.size());
+        result.data.resize(entries.size());
+    }
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(chunks.size() - 1);
+        for (size_t i = 1; i < chunks.size(); ++i) {
+            workers.emplace_back([&, i] { ScanChunk(chunks[i], matcher, results[i]); });
+        }
+        ScanChunk(chunks[0], matcher, results[0]);
+    }
+
+    // Merged in line order, an entry that matches once keeps its first match
+    for (ChunkResult& result : results) {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            Entry& entry = *entries[i];
+            if (result.counts[i] == 0 ||
+                (!entry.is_multiple_occurrence && entry.occurrence_count != 0)) {
+                continue;
             }
+            entry.occurrence_count += result.counts[i];
+            std::ranges::move(result.data[i], std::back_inserter(entry.parsed_data));
         }
-        log.close();
-        return true;
-    } else {
-        return false;
     }
+    return true;
 }
 
 optional<string> CheckResults(std::string const& game_id) {
@@ -81,14 +81,26 @@ public:
                        p.size())) {}
     virtual ~Entry() = default;
 
-    virtual void ProcessLine(std::string const& line) {
+    virtual void ProcessLine(std::string_view line) {
         if ((!is_multiple_occurrence && occurrence_count != 0) ||
             line.size() < minimum_line_length) {
             return;
         }
+        optional<string> data;
+        if (Match(line, data)) {
+            occurrence_count++;
+            if (data) {
+                parsed_data.push_back(std::move(*data));
+            }
+        }
+    }
+
+    // Matches a line against the pattern without touching the entry, so chunks of a log can be
+    // matched in parallel. data is set to what the pattern captured, if anything.
+    bool Match(std::string_view line, optional<string>& data) const {
         auto line_it = line.begin();
         auto pattern_it = pattern.begin();
-        std::stringstream in("");
+        string in;
         int chars_to_discard = 0;
         while (pattern_it != pattern.end()) {
             if (*pattern_it == '#') {
@@ -96,8 +108,8 @@ public:
                     line_it++;
                 }
             } else if (*pattern_it == '@') {
-                if (in.str().size() != 0) {
-                    in << " ";
+                if (in.size() != 0) {
+                    in += ' ';
                 }
                 if (pattern_it + 1 != pattern.end() && *(pattern_it + 1) == '{') {
                     while (*pattern_it != '}') {
@@ -106,36 +118,34 @@ public:
                     }
                     chars_to_discard -= 2;
                     while (line_it != line.end() && (*line_it != ' ' || chars_to_discard != 0)) {
-                        in << *line_it++;
+                        in += *line_it++;
                     }
                 } else if (pattern_it + 1 != pattern.end() && *(pattern_it + 1) == '(') {
                     char discard_symbol = *(pattern_it + 2);
                     while (line_it != line.end() && *line_it != discard_symbol) {
-                        in << *line_it++;
+                        in += *line_it++;
                     }
                     pattern_it += 3;
                 } else {
                     while (line_it != line.end() && (*line_it != ' ' || chars_to_discard != 0)) {
-                        in << *line_it++;
+                        in += *line_it++;
                     }
                 }
             } else if (*pattern_it == '*') {
                 // break early as hitting this means that everything before was
                 // correct and everything after we don't care about
-                occurrence_count++;
-                if (in.str().size() > 0)
-                    parsed_data.push_back(in.str().substr(0, in.str().size() - chars_to_discard));
-                return;
+                if (in.size() > 0)
+                    data = in.substr(0, in.size() - chars_to_discard);
+                return true;
             } else if (*pattern_it == '+') {
-                if (in.str().size() != 0) {
-                    in << " ";
+                if (in.size() != 0) {
+                    in += ' ';
                 }
-                occurrence_count++;
-                in << string(line_it, line.end());
-                parsed_data.push_back(in.str().substr(0, in.str().size() - chars_to_discard));
-                return;
+                in.append(line_it, line.end());
+                data = in.substr(0, in.size() - chars_to_discard);
+                return true;
             } else if (*pattern_it == '^') {
-                if (*line_it == '(') { // thread logging present
+                if (line_it != line.end() && *line_it == '(') { // thread logging present
                     while (line_it + 1 != line.end() && *line_it != ')') {
                         ++line_it;
                     }
@@ -145,27 +155,28 @@ public:
                 }
             } else {
                 if (line_it == line.end() || *pattern_it != *line_it++) {
-                    return;
+                    return false;
                 }
             }
             pattern_it++;
         }
-        if (line_it == line.end()) {
-            if (in.str().size() > 0) {
-                if (chars_to_discard > 0) {
-                    // check if the discarded part actually fits
-                    auto rev_line_it = line.rbegin();
-                    auto rev_pattern_it = pattern.rbegin() + 1;
-                    while (*rev_pattern_it != '{') {
-                        if (*rev_pattern_it++ != *rev_line_it++) {
-                            return;
-                        }
+        if (line_it != line.end()) {
+            return false;
+        }
+        if (in.size() > 0) {
+            if (chars_to_discard > 0) {
+                // check if the discarded part actually fits
+                auto rev_line_it = line.rbegin();
+                auto rev_pattern_it = pattern.rbegin() + 1;
+                while (*rev_pattern_it != '{') {
+                    if (*rev_pattern_it++ != *rev_line_it++) {
+                        return false;
                     }
                 }
-                parsed_data.push_back(in.str().substr(0, in.str().size() - chars_to_discard));
             }
-            occurrence_count++;
+            data = in.substr(0, in.size() - chars_to_discard);
         }
+        return true;
     }
     virtual void Reset() {
         parsed_data.clear();
@@ -4,10 +4,18 @@
 // History:
 //   2026-01-02  Copied from shadPS4 Emulator Project (v0.13.0)
 //   2026-01-26  We always use sync mode and no filters applied
+//   2026-10-18  Async mode with batched writes once the backend thread is started
+//   2026-10-18  Binary log mode with deferred formatting
+//   2026-10-18  Filter levels published to the atomic table the logging macros check
+//   2026-10-18  Rotating, compressed log segments instead of stopping at 100 MB
 
 #include <chrono>
+#include <cstdio>
 #include <filesystem>
+#include <optional>
+#include <span>
 #include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -20,8 +28,10 @@
 // #include "common/debug.h"
 #include "common/io_file.h"
 #include "common/logging/backend.h"
+#include "common/logging/binary_log.h"
 #include "common/logging/log.h"
 #include "common/logging/log_entry.h"
+#include "common/logging/log_segments.h"
 #include "common/logging/text_formatter.h"
 #include "common/path_util.h"
 #include "common/string_util.h"
@@ -31,6 +41,8 @@ namespace Common::Log {
 
 using namespace Common::FS;
 
+std::array<std::atomic<Level>, static_cast<std::size_t>(Class::Count)> Detail::class_levels{};
+
 namespace {
 
 /**
@@ -48,45 +60,72 @@ public:
         }
     }
 
+    void WriteBatch(std::span<const Entry> entries, std::string& buffer) {
+        if (!enabled.load(std::memory_order_relaxed)) {
+            return;
+        }
+#ifdef _WIN32
+        // Colors are console attributes here, not part of the text
+        for (const Entry& entry : entries) {
+            PrintColoredMessage(entry);
+        }
+#else
+        buffer.clear();
+        for (const Entry& entry : entries) {
+            AppendColoredLogMessage(buffer, entry);
+        }
+        std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+#endif
+    }
+
     void Flush() {
-        // stderr shouldn't be buffered
+        std::fflush(stdout);
     }
 
     void SetEnabled(bool enabled_) {
         enabled = enabled_;
     }
 
+    bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
 private:
     std::atomic_bool enabled{true};
 };
 
 /**
- * Backend that writes to a file passed into the constructor
+ * Backend that writes to a rotating log, see RotatingLogFile
  */
 class FileBackend {
 public:
-    explicit FileBackend(const std::filesystem::path& filename, bool should_append = false)
-        : file{filename, should_append ? FS::FileAccessMode::Append : FS::FileAccessMode::Create,
-               FS::FileType::TextFile} {}
+    explicit FileBackend(const std::filesystem::path& filename, bool should_append,
+                         u64 segment_size, u64 total_size_limit)
+        : file{filename, should_append, segment_size, total_size_limit} {}
 
     ~FileBackend() = default;
 
     void Write(const Entry& entry) {
-        if (!enabled) {
-            return;
+        file.Write(FormatLogMessage(entry).append(1, '\n'), entry.timestamp, entry.timestamp);
+        if (entry.log_level >= Level::Error) {
+            file.Flush();
         }
+    }
 
-        bytes_written += file.WriteString(FormatLogMessage(entry).append(1, '\n'));
+    /// Writes the entries with a single write. Flushes if one of them is an error.
+    void WriteBatch(std::span<const Entry> entries, std::string& buffer) {
+        if (entries.empty()) {
+            return;
+        }
 
-        // Prevent logs from exceeding a set maximum size in the event that log entries are spammed.
-        const auto write_limit = 100_MB;
-        const bool write_limit_exceeded = bytes_written > write_limit;
-        if (entry.log_level >= Level::Error || write_limit_exceeded) {
-            if (write_limit_exceeded) {
-                // Stop writing after the write limit is exceeded.
-                // Don't close the file so we can print a stacktrace if necessary
-                enabled = false;
-            }
+        buffer.clear();
+        bool has_error = false;
+        for (const Entry& entry : entries) {
+            AppendLogMessage(buffer, entry);
+            has_error |= entry.log_level >= Level::Error;
+        }
+        file.Write(buffer, entries.front().timestamp, entries.back().timestamp);
+        if (has_error) {
             file.Flush();
         }
     }
@@ -95,10 +134,12 @@ public:
         file.Flush();
     }
 
+    void SetLimits(u64 segment_size, u64 total_size_limit) {
+        file.SetLimits(segment_size, total_size_limit);
+    }
+
 private:
-    Common::FS::IOFile file;
-    bool enabled = true;
-    std::size_t bytes_written = 0;
+    RotatingLogFile file;
 };
 
 /**
@@ -116,6 +157,12 @@ public:
 #endif
     }
 
+    void WriteBatch(std::span<const Entry> entries, std::string&) {
+        for (const Entry& entry : entries) {
+            Write(entry);
+        }
+    }
+
     void Flush() {}
 
     void EnableForStacktrace() {}
@@ -123,6 +170,14 @@ public:
 
 bool initialization_in_progress_suppress_logging = true;
 
+/// Makes the levels of the filter visible to IsLogEnabled.
+void PublishFilter(const Filter& filter) {
+    for (std::size_t i = 0; i < Detail::class_levels.size(); ++i) {
+        Detail::class_levels[i].store(filter.GetClassLevel(static_cast<Class>(i)),
+                                      std::memory_order_relaxed);
+    }
+}
+
 /**
  * Static state as a singleton.
  */
@@ -173,6 +228,18 @@ public:
         should_append = true;
     }
 
+    static void SetBinary() {
+        binary = true;
+    }
+
+    static void SetRotation(u64 segment_size_, u64 total_size_limit_) {
+        segment_size = segment_size_;
+        total_size_limit = total_size_limit_;
+        if (instance && instance->file_backend) {
+            instance->file_backend->SetLimits(segment_size_, total_size_limit_);
+        }
+    }
+
     Impl(const Impl&) = delete;
     Impl& operator=(const Impl&) = delete;
 
@@ -180,7 +247,7 @@ public:
     Impl& operator=(Impl&&) = delete;
 
     void SetGlobalFilter(const Filter& f) {
-        filter = f;
+        PublishFilter(f);
     }
 
     void SetColorConsoleBackendEnabled(bool enabled) {
@@ -189,11 +256,17 @@ public:
 
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const fmt::format_args& args) {
-        if (!filter.CheckMessage(log_class, log_level) /* || !Config::getLoggingEnabled()*/) {
+        // The logging macros check this already, this covers direct calls
+        if (!IsLogEnabled(log_class, log_level) /* || !Config::getLoggingEnabled()*/) {
+            return;
+        }
+
+        if (binary_writer) {
+            PushBinaryEntry(log_class, log_level, filename, line_num, function, format, args);
             return;
         }
 
-        const auto message = fmt::vformat(format, args);
+        auto message = fmt::vformat(format, args);
 
         // Propagate important log messages to the profiler
         /*if (IsProfilerConnected()) {
@@ -217,7 +290,7 @@ public:
         using std::chrono::microseconds;
         using std::chrono::steady_clock;
 
-        const Entry entry = {
+        Entry entry = {
             .timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin),
             .log_class = log_class,
             .log_level = log_level,
@@ -226,55 +299,226 @@ public:
             .function = function,
             .message = std::move(message),
         };
-        // if (Config::getLogType() == "async") {
-        //     message_queue.EmplaceWait(entry);
-        // } else {
-        ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
-        std::fflush(stdout);
-        //}
+        if (async_enabled.load(std::memory_order_acquire)) {
+            // Blocks while the queue is full, when messages come in faster than they're written
+            message_queue.EmplaceWait(std::move(entry));
+        } else {
+            ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
+            std::fflush(stdout);
+        }
     }
 
 private:
-    Impl(const std::filesystem::path& file_backend_filename, const Filter& filter_)
-        : filter{filter_}, file_backend{file_backend_filename, should_append} {}
+    /// Entries formatted into one buffer and written with a single write per backend
+    static constexpr std::size_t MaxBatchEntries = 256;
+    /// How long written entries may stay in the stdio and file buffers
+    static constexpr std::chrono::milliseconds FlushInterval{500};
+
+    /// Byte capacity of the ring binary messages are queued in
+    static constexpr std::size_t BinaryRingSize = 1_MB;
+
+    Impl(const std::filesystem::path& file_backend_filename, const Filter& filter) {
+        PublishFilter(filter);
+        if (binary) {
+            auto path = file_backend_filename;
+            path.replace_extension(BinaryLogExtension);
+            binary_writer.emplace(path, should_append);
+            binary_ring = std::make_unique<BinaryLogRing>(BinaryRingSize);
+            // Formatting for the console would undo the savings
+            color_console_backend.SetEnabled(false);
+        } else {
+            file_backend.emplace(file_backend_filename, should_append, segment_size,
+                                 total_size_limit);
+        }
+    }
 
-    ~Impl() = default;
+    ~Impl() {
+        StopBackendThread();
+    }
 
     void StartBackendThread() {
+        if (backend_thread.joinable()) {
+            return;
+        }
         backend_thread = std::jthread([this](std::stop_token stop_token) {
             Common::SetCurrentThreadName("shadPS4:Log");
-            Entry entry;
-            const auto write_logs = [this, &entry]() {
-                ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
-            };
-            while (!stop_token.stop_requested()) {
-                message_queue.PopWait(entry, stop_token);
-                if (entry.filename != nullptr) {
-                    write_logs();
+            if (binary_writer) {
+                RunBinaryBackend(stop_token);
+            } else {
+                RunTextBackend(stop_token);
+            }
+        });
+        async_enabled.store(true, std::memory_order_release);
+    }
+
+    void RunTextBackend(std::stop_token stop_token) {
+        std::vector<Entry> batch;
+        batch.reserve(MaxBatchEntries);
+        Entry entry;
+        bool unflushed = false;
+        auto last_flush = std::chrono::steady_clock::now();
+
+        while (!stop_token.stop_requested()) {
+            if (!message_queue.PopWaitFor(entry, FlushInterval, stop_token)) {
+                // Nothing new, make what was written so far visible
+                if (unflushed) {
+                    FlushBackends();
+                    unflushed = false;
+                    last_flush = std::chrono::steady_clock::now();
                 }
+                continue;
+            }
+
+            batch.push_back(std::move(entry));
+            while (batch.size() < MaxBatchEntries && message_queue.TryPop(entry)) {
+                batch.push_back(std::move(entry));
             }
-            // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a
-            // case where a system is repeatedly spamming logs even on close.
-            int max_logs_to_write = filter.IsDebug() ? std::numeric_limits<s32>::max() : 100;
-            while (max_logs_to_write-- && message_queue.TryPop(entry)) {
-                write_logs();
+            WriteBatch(batch);
+            batch.clear();
+            unflushed = true;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (now - last_flush >= FlushInterval) {
+                FlushBackends();
+                unflushed = false;
+                last_flush = now;
             }
-        });
+        }
+
+        WriteQueued();
+    }
+
+    void RunBinaryBackend(std::stop_token stop_token) {
+        std::vector<u8> records;
+        bool unflushed = false;
+        auto last_flush = std::chrono::steady_clock::now();
+
+        while (!stop_token.stop_requested()) {
+            records.clear();
+            if (!binary_ring->PopWaitFor(records, FlushInterval, stop_token)) {
+                if (unflushed) {
+                    FlushBackends();
+                    unflushed = false;
+                    last_flush = std::chrono::steady_clock::now();
+                }
+                continue;
+            }
+
+            bool has_error = false;
+            {
+                std::scoped_lock lock{binary_mutex};
+                has_error = binary_writer->Write(records);
+            }
+            unflushed = true;
+
+            const auto now = std::chrono::steady_clock::now();
+            if (has_error || now - last_flush >= FlushInterval) {
+                FlushBackends();
+                unflushed = false;
+                last_flush = now;
+            }
+        }
+
+        WriteQueued();
+    }
+
+    /// Writes what is left in the queue. It's bounded and new messages are written synchronously
+    /// by now, so this ends even if something keeps spamming logs on close.
+    void WriteQueued() {
+        if (binary_ring) {
+            std::vector<u8> records;
+            while (binary_ring->TryPop(records)) {
+            }
+            std::scoped_lock lock{binary_mutex};
+            binary_writer->Write(records);
+            return;
+        }
+
+        std::vector<Entry> batch;
+        batch.reserve(MaxBatchEntries);
+        Entry entry;
+        while (message_queue.TryPop(entry)) {
+            batch.push_back(std::move(entry));
+            if (batch.size() == MaxBatchEntries) {
+                WriteBatch(batch);
+                batch.clear();
+            }
+        }
+        WriteBatch(batch);
+    }
+
+    void PushBinaryEntry(Class log_class, Level log_level, const char* filename,
+                         unsigned int line_num, const char* function, const char* format,
+                         const fmt::format_args& args) {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        using std::chrono::steady_clock;
+
+        const auto timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin);
+        thread_local std::vector<u8> record;
+        record.clear();
+        EncodeBinaryLogMessage(record, timestamp, log_class, log_level, filename, line_num,
+                               function, format, args);
+
+        if (async_enabled.load(std::memory_order_acquire)) {
+            binary_ring->Push(record, log_level >= Level::Error);
+        } else {
+            std::scoped_lock lock{binary_mutex};
+            binary_writer->Write(record);
+            binary_writer->Flush();
+        }
+
+        if (color_console_backend.IsEnabled()) {
+            const Entry entry = {
+                .timestamp = timestamp,
+                .log_class = log_class,
+                .log_level = log_level,
+                .filename = filename,
+                .line_num = line_num,
+                .function = function,
+                .message = fmt::vformat(format, args),
+            };
+            color_console_backend.Write(entry);
+            std::fflush(stdout);
+        }
     }
 
     void StopBackendThread() {
+        // Messages logged from now on are written synchronously again
+        async_enabled.store(false, std::memory_order_release);
         backend_thread.request_stop();
         if (backend_thread.joinable()) {
             backend_thread.join();
         }
 
+        // A thread that saw the backend running just before the switch may have queued its
+        // message after the backend thread drained the queue
+        WriteQueued();
+        FlushBackends();
+    }
+
+    void WriteBatch(std::span<const Entry> entries) {
+        if (entries.empty()) {
+            return;
+        }
+        ForEachBackend(
+            [this, entries](auto& backend) { backend.WriteBatch(entries, batch_buffer); });
+    }
+
+    void FlushBackends() {
         ForEachBackend([](auto& backend) { backend.Flush(); });
+        if (binary_writer) {
+            std::scoped_lock lock{binary_mutex};
+            binary_writer->Flush();
+        }
     }
 
     void ForEachBackend(auto lambda) {
         // lambda(debugger_backend);
         lambda(color_console_backend);
-        lambda(file_backend);
+        if (file_backend) {
+            lambda(*file_backend);
+        }
     }
 
     static void Deleter(Impl* ptr) {
@@ -283,13 +527,20 @@ private:
 
     static inline std::unique_ptr<Impl, decltype(&Deleter)> instance{nullptr, Deleter};
     static inline bool should_append{false};
+    static inline bool binary{false};
+    static inline u64 segment_size{DefaultLogSegmentSize};
+    static inline u64 total_size_limit{DefaultLogTotalSizeLimit};
 
-    Filter filter;
     DebuggerBackend debugger_backend{};
     ColorConsoleBackend color_console_backend{};
-    FileBackend file_backend;
+    std::optional<FileBackend> file_backend;
+    std::optional<BinaryLogWriter> binary_writer;
+    std::unique_ptr<BinaryLogRing> binary_ring;
+    std::mutex binary_mutex; ///< Guards binary_writer, written by the backend thread once started
 
     MPSCQueue<Entry> message_queue{};
+    std::atomic_bool async_enabled{false};
+    std::string batch_buffer; ///< Only used by the backend thread
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
     std::jthread backend_thread;
 };
@@ -328,6 +579,14 @@ void SetAppend() {
     Impl::SetAppend();
 }
 
+void SetBinary() {
+    Impl::SetBinary();
+}
+
+void SetRotation(u64 segment_size, u64 total_size_limit) {
+    Impl::SetRotation(segment_size, total_size_limit);
+}
+
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
                        const fmt::format_args& args) {
@@ -8,6 +8,7 @@
 
 #include <string_view>
 #include "common/logging/filter.h"
+#include "common/types.h"
 
 namespace Common::Log {
 
@@ -34,4 +35,15 @@ void SetColorConsoleBackendEnabled(bool enabled);
 
 void SetAppend();
 
+/// Writes a binary log with deferred formatting (.blog) instead of a text log and turns the
+/// console output off. Must be called before Initialize.
+void SetBinary();
+
+constexpr u64 DefaultLogSegmentSize = 16_MB;
+constexpr u64 DefaultLogTotalSizeLimit = 128_MB;
+
+/// Sets the size at which the log file is rotated and the total size kept of the current and the
+/// compressed older segments. Can be called at any time.
+void SetRotation(u64 segment_size, u64 total_size_limit);
+
 } // namespace Common::Log
@@ -0,0 +1,494 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <fmt/args.h>
+
+#include "common/assert.h"
+#include "common/logging/binary_log.h"
+#include "common/logging/text_formatter.h"
+
+namespace Common::Log {
+
+namespace {
+
+enum class RecordType : u8 {
+    String = 1,
+    Message = 2,
+};
+
+enum class ArgType : u8 {
+    Int,
+    UInt,
+    Double,
+    Bool,
+    Char,
+    String,
+    Pointer,
+    Float,
+};
+
+constexpr std::size_t RecordHeaderSize = sizeof(u8) + sizeof(u32);
+
+/// Offsets of the addresses in a message payload
+constexpr std::size_t FilenameOffset = sizeof(u64) + sizeof(u8) * 2 + sizeof(u32);
+constexpr std::size_t FunctionOffset = FilenameOffset + sizeof(u64);
+constexpr std::size_t FormatOffset = FunctionOffset + sizeof(u64);
+constexpr std::size_t LevelOffset = sizeof(u64) + sizeof(u8);
+
+/// Keeps a single message from taking a large part of the ring
+constexpr std::size_t MaxStringArgSize = 16_KB;
+
+/// Format string of messages that had to be formatted when they were logged
+constexpr const char* PreformattedFormat = "{}";
+
+template <typename T>
+void Put(std::vector<u8>& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const std::size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+void PutString(std::vector<u8>& out, std::string_view value) {
+    value = value.substr(0, MaxStringArgSize);
+    Put(out, static_cast<u32>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+template <typename T>
+bool Get(std::span<const u8> data, std::size_t& offset, T& value) {
+    if (data.size() - offset < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+u64 AddressOf(const char* string) {
+    return reinterpret_cast<u64>(string);
+}
+
+/// Serializes one argument. Returns false for types that need their formatter.
+struct ArgEncoder {
+    std::vector<u8>& out;
+
+    template <typename T>
+    bool operator()(T value) {
+        using Type = std::remove_cvref_t<T>;
+        if constexpr (std::is_same_v<Type, bool>) {
+            Put(out, ArgType::Bool);
+            Put(out, static_cast<u8>(value));
+        } else if constexpr (std::is_same_v<Type, char>) {
+            Put(out, ArgType::Char);
+            Put(out, value);
+        } else if constexpr (std::is_same_v<Type, int> || std::is_same_v<Type, long long>) {
+            Put(out, ArgType::Int);
+            Put(out, static_cast<s64>(value));
+        } else if constexpr (std::is_same_v<Type, unsigned> ||
+                             std::is_same_v<Type, unsigned long long>) {
+            Put(out, ArgType::UInt);
+            Put(out, static_cast<u64>(value));
+        } else if constexpr (std::is_same_v<Type, float>) {
+            // Kept apart from double, {} of a float prints its shortest float representation
+            Put(out, ArgType::Float);
+            Put(out, value);
+        } else if constexpr (std::is_same_v<Type, double>) {
+            Put(out, ArgType::Double);
+            Put(out, value);
+        } else if constexpr (std::is_same_v<Type, const char*>) {
+            Put(out, ArgType::String);
+            PutString(out, value ? std::string_view{value} : std::string_view{});
+        } else if constexpr (std::is_same_v<Type, fmt::basic_string_view<char>>) {
+            Put(out, ArgType::String);
+            PutString(out, std::string_view{value.data(), value.size()});
+        } else if constexpr (std::is_same_v<Type, const void*>) {
+            Put(out, ArgType::Pointer);
+            Put(out, reinterpret_cast<u64>(value));
+        } else {
+            // 128-bit integers, long double and custom formatters
+            return false;
+        }
+        return true;
+    }
+};
+
+bool EncodeArg(std::vector<u8>& out, const fmt::basic_format_arg<fmt::format_context>& arg) {
+#if FMT_VERSION >= 110000
+    return arg.visit(ArgEncoder{out});
+#else
+    return fmt::visit_format_arg(ArgEncoder{out}, arg);
+#endif
+}
+
+bool DecodeArg(std::span<const u8> data, std::size_t& offset,
+               fmt::dynamic_format_arg_store<fmt::format_context>& store) {
+    ArgType type{};
+    if (!Get(data, offset, type)) {
+        return false;
+    }
+
+    switch (type) {
+    case ArgType::Int: {
+        s64 value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(value);
+        return true;
+    }
+    case ArgType::UInt: {
+        u64 value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(value);
+        return true;
+    }
+    case ArgType::Float: {
+        float value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(value);
+        return true;
+    }
+    case ArgType::Double: {
+        double value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(value);
+        return true;
+    }
+    case ArgType::Bool: {
+        u8 value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(value != 0);
+        return true;
+    }
+    case ArgType::Char: {
+        char value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(value);
+        return true;
+    }
+    case ArgType::String: {
+        u32 size{};
+        if (!Get(data, offset, size) || data.size() - offset < size) {
+            return false;
+        }
+        store.push_back(
+            std::string(reinterpret_cast<const char*>(data.data() + offset), size));
+        offset += size;
+        return true;
+    }
+    case ArgType::Pointer: {
+        u64 value{};
+        if (!Get(data, offset, value)) {
+            return false;
+        }
+        store.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(value)));
+        return true;
+    }
+    }
+    return false;
+}
+
+} // namespace
+
+void EncodeBinaryLogMessage(std::vector<u8>& out, std::chrono::microseconds timestamp,
+                            Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function, const char* format,
+                            const fmt::format_args& args) {
+    // Enough for the fixed fields and a few numbers, strings grow it as needed
+    out.reserve(out.size() + 128);
+    const std::size_t record_start = out.size();
+    Put(out, RecordType::Message);
+    Put(out, u32{0}); // Patched below
+    const std::size_t payload_start = out.size();
+
+    Put(out, static_cast<u64>(timestamp.count()));
+    Put(out, log_class);
+    Put(out, log_level);
+    Put(out, static_cast<u32>(line_num));
+    Put(out, AddressOf(filename));
+    Put(out, AddressOf(function));
+    const std::size_t format_offset = out.size();
+    Put(out, AddressOf(format));
+    const std::size_t count_offset = out.size();
+    Put(out, u8{0});
+
+    u8 count = 0;
+    bool deferred = true;
+    for (int i = 0;; ++i) {
+        const auto arg = args.get(i);
+        if (!arg) {
+            break;
+        }
+        if (count == std::numeric_limits<u8>::max() || !EncodeArg(out, arg)) {
+            deferred = false;
+            break;
+        }
+        ++count;
+    }
+
+    if (!deferred) {
+        // Format now and store the text as the only argument
+        out.resize(count_offset);
+        Put(out, u8{1});
+        Put(out, ArgType::String);
+        PutString(out, fmt::vformat(format, args));
+        const u64 preformatted = AddressOf(PreformattedFormat);
+        std::memcpy(out.data() + format_offset, &preformatted, sizeof(preformatted));
+    } else {
+        out[count_offset] = count;
+    }
+
+    const u32 payload_size = static_cast<u32>(out.size() - payload_start);
+    std::memcpy(out.data() + record_start + sizeof(u8), &payload_size, sizeof(payload_size));
+}
+
+BinaryLogRing::BinaryLogRing(std::size_t capacity) : m_buffer(capacity) {
+    ASSERT((capacity & (capacity - 1)) == 0);
+}
+
+void BinaryLogRing::Push(std::span<const u8> record, bool urgent) {
+    const std::size_t capacity = m_buffer.size();
+    if (record.size() > capacity) {
+        return;
+    }
+
+    bool wake = urgent;
+    {
+        std::unique_lock lock{m_mutex};
+        m_not_full.wait(lock, [&] { return capacity - (m_write - m_read) >= record.size(); });
+
+        const std::size_t position = m_write & (capacity - 1);
+        const std::size_t first = std::min(record.size(), capacity - position);
+        std::memcpy(m_buffer.data() + position, record.data(), first);
+        std::memcpy(m_buffer.data(), record.data() + first, record.size() - first);
+        m_write += record.size();
+        // Otherwise the consumer picks the records up when its wait times out
+        wake |= m_write - m_read >= capacity / 4;
+    }
+    if (wake) {
+        m_not_empty.notify_one();
+    }
+}
+
+bool BinaryLogRing::PopWaitFor(std::vector<u8>& out, std::chrono::milliseconds rel_time,
+                               std::stop_token stop_token) {
+    {
+        std::unique_lock lock{m_mutex};
+        if (!Common::CondvarWaitFor(m_not_empty, lock, stop_token, rel_time,
+                                    [this] { return m_write != m_read; })) {
+            return false;
+        }
+        PopLocked(out);
+    }
+    m_not_full.notify_all();
+    return true;
+}
+
+bool BinaryLogRing::TryPop(std::vector<u8>& out) {
+    {
+        std::scoped_lock lock{m_mutex};
+        if (m_write == m_read) {
+            return false;
+        }
+        PopLocked(out);
+    }
+    m_not_full.notify_all();
+    return true;
+}
+
+void BinaryLogRing::PopLocked(std::vector<u8>& out) {
+    const std::size_t capacity = m_buffer.size();
+    const std::size_t size = m_write - m_read;
+    const std::size_t position = m_read & (capacity - 1);
+    const std::size_t first = std::min(size, capacity - position);
+
+    const std::size_t offset = out.size();
+    out.resize(offset + size);
+    std::memcpy(out.data() + offset, m_buffer.data() + position, first);
+    std::memcpy(out.data() + offset + first, m_buffer.data(), size - first);
+    m_read = m_write;
+}
+
+BinaryLogWriter::BinaryLogWriter(const std::filesystem::path& path, bool append)
+    : m_file{path, append ? FS::FileAccessMode::Append : FS::FileAccessMode::Create} {
+    if (m_file.IsOpen() && m_file.GetSize() == 0) {
+        m_file.WriteObject(BinaryLogMagic);
+        m_file.WriteObject(BinaryLogVersion);
+    }
+}
+
+bool BinaryLogWriter::Write(std::span<const u8> records) {
+    m_buffer.clear();
+    bool has_error = false;
+
+    std::size_t offset = 0;
+    while (offset < records.size()) {
+        std::size_t payload = offset + sizeof(u8);
+        u32 size{};
+        if (!Get(records, payload, size) || records.size() - payload < size) {
+            break;
+        }
+
+        const std::span<const u8> message = records.subspan(payload, size);
+        for (const std::size_t address_offset : {FilenameOffset, FunctionOffset, FormatOffset}) {
+            std::size_t cursor = address_offset;
+            u64 address{};
+            if (Get(message, cursor, address) && !m_known_strings.contains(address)) {
+                AddString(address);
+            }
+        }
+        Level level{};
+        std::size_t level_offset = LevelOffset;
+        has_error |= Get(message, level_offset, level) && level >= Level::Error;
+
+        const std::size_t record_size = RecordHeaderSize + size;
+        m_buffer.insert(m_buffer.end(), records.begin() + offset,
+                        records.begin() + offset + record_size);
+        offset += record_size;
+    }
+
+    m_file.WriteSpan(std::span<const u8>{m_buffer});
+    return has_error;
+}
+
+void BinaryLogWriter::Flush() {
+    m_file.Flush();
+}
+
+void BinaryLogWriter::AddString(u64 address) {
+    m_known_strings.insert(address);
+
+    // Messages only refer to string literals, which live as long as the program
+    const char* string = reinterpret_cast<const char*>(static_cast<uintptr_t>(address));
+    const std::string_view text = string ? std::string_view{string} : std::string_view{};
+
+    Put(m_buffer, RecordType::String);
+    Put(m_buffer, static_cast<u32>(sizeof(u64) + text.size()));
+    Put(m_buffer, address);
+    m_buffer.insert(m_buffer.end(), text.begin(), text.end());
+}
+
+BinaryLogDecoder::BinaryLogDecoder(const std::filesystem::path& path) {
+    FS::IOFile file{path, FS::FileAccessMode::Read};
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    m_data.resize(file.GetSize());
+    if (file.ReadSpan(std::span<u8>{m_data}) != m_data.size()) {
+        return;
+    }
+
+    u32 magic{};
+    u32 version{};
+    if (!Get(std::span<const u8>{m_data}, m_offset, magic) ||
+        !Get(std::span<const u8>{m_data}, m_offset, version) || magic != BinaryLogMagic ||
+        version == 0 || version > BinaryLogVersion) {
+        return;
+    }
+    m_valid = true;
+}
+
+bool BinaryLogDecoder::Next(Entry& entry) {
+    if (!m_valid) {
+        return false;
+    }
+
+    const std::span<const u8> data{m_data};
+    while (m_offset < data.size()) {
+        std::size_t cursor = m_offset;
+        RecordType type{};
+        u32 size{};
+        if (!Get(data, cursor, type) || !Get(data, cursor, size) || data.size() - cursor < size) {
+            return false;
+        }
+        const std::span<const u8> payload = data.subspan(cursor, size);
+        m_offset = cursor + size;
+
+        if (type == RecordType::String) {
+            std::size_t offset = 0;
+            u64 address{};
+            if (Get(payload, offset, address)) {
+                m_strings.insert_or_assign(
+                    address, std::string(reinterpret_cast<const char*>(payload.data() + offset),
+                                         payload.size() - offset));
+            }
+            continue;
+        }
+        if (type != RecordType::Message) {
+            continue;
+        }
+
+        std::size_t offset = 0;
+        u64 timestamp{};
+        u32 line{};
+        u64 filename{};
+        u64 function{};
+        u64 format{};
+        u8 count{};
+        if (!Get(payload, offset, timestamp) || !Get(payload, offset, entry.log_class) ||
+            !Get(payload, offset, entry.log_level) || !Get(payload, offset, line) ||
+            !Get(payload, offset, filename) || !Get(payload, offset, function) ||
+            !Get(payload, offset, format) || !Get(payload, offset, count)) {
+            continue;
+        }
+
+        fmt::dynamic_format_arg_store<fmt::format_context> store;
+        bool args_valid = true;
+        for (u8 i = 0; i < count && args_valid; ++i) {
+            args_valid = DecodeArg(payload, offset, store);
+        }
+
+        entry.timestamp = std::chrono::microseconds{timestamp};
+        entry.line_num = line;
+        entry.filename = GetString(filename);
+        entry.function = GetString(function);
+        const char* format_string = GetString(format);
+        try {
+            entry.message = args_valid ? fmt::vformat(format_string, store)
+                                       : fmt::format("{} (truncated arguments)", format_string);
+        } catch (const fmt::format_error& error) {
+            entry.message = fmt::format("{} (format error: {})", format_string, error.what());
+        }
+        return true;
+    }
+    return false;
+}
+
+std::optional<std::string> BinaryLogDecoder::DecodeToText(const std::filesystem::path& path) {
+    BinaryLogDecoder decoder{path};
+    if (!decoder.IsValid()) {
+        return std::nullopt;
+    }
+
+    std::string text;
+    Entry entry;
+    while (decoder.Next(entry)) {
+        AppendLogMessage(text, entry);
+    }
+    return text;
+}
+
+const char* BinaryLogDecoder::GetString(u64 address) const {
+    if (const auto it = m_strings.find(address); it != m_strings.end()) {
+        return it->second.c_str();
+    }
+    return "?";
+}
+
+} // namespace Common::Log
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "common/io_file.h"
+#include "common/logging/log_entry.h"
+#include "common/polyfill_thread.h"
+
+namespace Common::Log {
+
+/**
+ * Binary log (.blog) with deferred formatting.
+ *
+ * A message is stored as the addresses of its format string, file name and function, which are
+ * all string literals, followed by its serialized arguments. The writer emits the text of an
+ * address the first time it sees it, so a file can be rendered later by BinaryLogDecoder without
+ * the program that wrote it.
+ *
+ * File: header, then records of [u8 type][u32 payload size][payload].
+ *   String:  u64 address, the characters
+ *   Message: u64 timestamp (us), u8 class, u8 level, u32 line, u64 file name address,
+ *            u64 function address, u64 format address, u8 argument count, the arguments
+ *   Argument: u8 type, then i64 / u64 / f64 / u8 bool / u8 char / u32 size + characters / u64
+ *             / f32
+ */
+constexpr u32 BinaryLogMagic = 0x474F4C42; // "BLOG"
+constexpr u32 BinaryLogVersion = 2; ///< 2 added float arguments, version 1 files still decode
+constexpr std::string_view BinaryLogExtension = ".blog";
+
+/// Serializes a message into a message record. Arguments without a built-in fmt type (like
+/// enums with a formatter) and long doubles are formatted right away, as the whole message.
+void EncodeBinaryLogMessage(std::vector<u8>& out, std::chrono::microseconds timestamp,
+                            Class log_class, Level log_level, const char* filename,
+                            unsigned int line_num, const char* function, const char* format,
+                            const fmt::format_args& args);
+
+/// Bounded byte ring the logging threads push message records into.
+class BinaryLogRing {
+public:
+    explicit BinaryLogRing(std::size_t capacity);
+
+    /// Copies a record into the ring. Blocks while there isn't enough free space. The consumer is
+    /// woken up for urgent records or once the ring is a quarter full.
+    void Push(std::span<const u8> record, bool urgent);
+
+    /// Appends everything in the ring to out. Returns false if it stayed empty for rel_time or a
+    /// stop was requested.
+    bool PopWaitFor(std::vector<u8>& out, std::chrono::milliseconds rel_time,
+                    std::stop_token stop_token);
+    bool TryPop(std::vector<u8>& out);
+
+private:
+    void PopLocked(std::vector<u8>& out);
+
+    std::vector<u8> m_buffer;
+    std::size_t m_read = 0;  ///< Total bytes popped
+    std::size_t m_write = 0; ///< Total bytes pushed
+    std::mutex m_mutex;
+    std::condition_variable_any m_not_empty;
+    std::condition_variable m_not_full;
+};
+
+/// Writes message records to a .blog file, adding the string records they refer to.
+class BinaryLogWriter {
+public:
+    BinaryLogWriter(const std::filesystem::path& path, bool append);
+
+    /// Writes whole message records. Returns true if one of them is an error or worse.
+    bool Write(std::span<const u8> records);
+    void Flush();
+
+private:
+    void AddString(u64 address);
+
+    Common::FS::IOFile m_file;
+    std::unordered_set<u64> m_known_strings;
+    std::vector<u8> m_buffer;
+};
+
+/// Renders the messages of a .blog file.
+class BinaryLogDecoder {
+public:
+    explicit BinaryLogDecoder(const std::filesystem::path& path);
+
+    /// False if the file couldn't be read or isn't a binary log.
+    bool IsValid() const {
+        return m_valid;
+    }
+
+    /// Decodes the next message. The strings the entry points to stay valid until the next
+    /// call. Returns false at the end of the file or at a truncated record.
+    bool Next(Entry& entry);
+
+    /// Decodes a whole file into the text the text file backend would have written.
+    static std::optional<std::string> DecodeToText(const std::filesystem::path& path);
+
+private:
+    const char* GetString(u64 address) const;
+
+    std::vector<u8> m_data;
+    std::size_t m_offset = 0;
+    bool m_valid = false;
+    std::unordered_map<u64, std::string> m_strings;
+};
+
+} // namespace Common::Log
@@ -3,18 +3,42 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 // History:
 //   2026-01-02  Copied from shadPS4 Emulator Project (v0.13.0)
+//   2026-10-18  Compile time minimum level, filter checked before the arguments are evaluated
 
 #pragma once
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <string_view>
 
 #include "common/logging/formatter.h"
 #include "common/logging/types.h"
 
+// Lowest level that is compiled in, set through the LOG_MIN_LEVEL CMake option
+#ifndef LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define LOG_MIN_LEVEL Trace
+#else
+#define LOG_MIN_LEVEL Debug
+#endif
+#endif
+
 namespace Common::Log {
 
+constexpr Level MinLevel = Level::LOG_MIN_LEVEL;
+
+namespace Detail {
+/// Minimum level of every class, published by the global filter.
+extern std::array<std::atomic<Level>, static_cast<std::size_t>(Class::Count)> class_levels;
+} // namespace Detail
+
+/// Returns true if the global filter lets messages of this class and level through.
+inline bool IsLogEnabled(Class log_class, Level log_level) {
+    return log_level >= Detail::class_levels[static_cast<std::size_t>(log_class)].load(
+                            std::memory_order_relaxed);
+}
+
 constexpr const char* TrimSourcePath(std::string_view source) {
     const auto rfind = [source](const std::string_view match) {
         return source.rfind(match) == source.npos ? 0 : (source.rfind(match) + match.size());
@@ -38,36 +62,27 @@ void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsig
 } // namespace Common::Log
 
 // Define the fmt lib macros
+// The level check comes first so the arguments of a filtered out message are never evaluated.
 #define LOG_GENERIC(log_class, log_level, ...)                                                     \
-    Common::Log::FmtLogMessage(log_class, log_level, Common::Log::TrimSourcePath(__FILE__),        \
-                               __LINE__, __func__, __VA_ARGS__)
+    do {                                                                                           \
+        if (Common::Log::IsLogEnabled(log_class, log_level)) {                                     \
+            Common::Log::FmtLogMessage(log_class, log_level,                                       \
+                                       Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,  \
+                                       __VA_ARGS__);                                               \
+        }                                                                                          \
+    } while (0)
 
-#ifdef _DEBUG
-#define LOG_TRACE(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Trace,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
-#else
-#define LOG_TRACE(log_class, fmt, ...) (void(0))
-#endif
+#define LOG_AT_LEVEL(log_class, log_level, ...)                                                    \
+    do {                                                                                           \
+        if constexpr (Common::Log::Level::log_level >= Common::Log::MinLevel) {                    \
+            LOG_GENERIC(Common::Log::Class::log_class, Common::Log::Level::log_level,              \
+                        __VA_ARGS__);                                                              \
+        }                                                                                          \
+    } while (0)
 
-#define LOG_DEBUG(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Debug,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
-#define LOG_INFO(log_class, ...)                                                                   \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Info,            \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
-#define LOG_WARNING(log_class, ...)                                                                \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Warning,         \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
-#define LOG_ERROR(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Error,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
-#define LOG_CRITICAL(log_class, ...)                                                               \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Critical,        \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+#define LOG_TRACE(log_class, ...) LOG_AT_LEVEL(log_class, Trace, __VA_ARGS__)
+#define LOG_DEBUG(log_class, ...) LOG_AT_LEVEL(log_class, Debug, __VA_ARGS__)
+#define LOG_INFO(log_class, ...) LOG_AT_LEVEL(log_class, Info, __VA_ARGS__)
+#define LOG_WARNING(log_class, ...) LOG_AT_LEVEL(log_class, Warning, __VA_ARGS__)
+#define LOG_ERROR(log_class, ...) LOG_AT_LEVEL(log_class, Error, __VA_ARGS__)
+#define LOG_CRITICAL(log_class, ...) LOG_AT_LEVEL(log_class, Critical, __VA_ARGS__)
@@ -22,7 +22,7 @@ struct Entry {
     Level log_level{};
     const char* filename = nullptr;
     u32 line_num = 0;
-    std::string function;
+    const char* function = nullptr;
     std::string message;
 };
 
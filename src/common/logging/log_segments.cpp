@@ -0,0 +1,381 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <libdeflate.h>
+#include <fmt/format.h>
+
+#include "common/logging/log_segments.h"
+
+namespace Common::Log {
+
+namespace {
+constexpr u32 IndexMagic = 0x5849534C; // "LSIX"
+constexpr u32 IndexVersion = 1;
+constexpr int CompressionLevel = 6;
+
+s64 NowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+std::filesystem::path GetIndexPath(const std::filesystem::path& log_path) {
+    auto path = log_path;
+    path.replace_extension(".index");
+    return path;
+}
+
+std::optional<std::vector<u8>> ReadWholeFile(const std::filesystem::path& path) {
+    Common::FS::IOFile file(path, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        return std::nullopt;
+    }
+    std::vector<u8> data(file.GetSize());
+    if (file.ReadSpan(std::span<u8>(data)) != data.size()) {
+        return std::nullopt;
+    }
+    return data;
+}
+} // namespace
+
+LogSegmentIndex::LogSegmentIndex(const std::filesystem::path& log_path) : m_log_path{log_path} {
+    Common::FS::IOFile file(GetIndexPath(log_path), Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    u32 magic{};
+    u32 version{};
+    u32 count{};
+    if (!file.ReadObject(magic) || !file.ReadObject(version) || !file.ReadObject(count) ||
+        magic != IndexMagic || version != IndexVersion) {
+        return;
+    }
+    for (u32 i = 0; i < count; ++i) {
+        LogSegment segment;
+        u8 compressed{};
+        u8 active{};
+        if (!file.ReadObject(segment.sequence) || !file.ReadObject(segment.session) ||
+            !file.ReadObject(segment.first_time) || !file.ReadObject(segment.last_time) ||
+            !file.ReadObject(segment.size) || !file.ReadObject(segment.stored_size) ||
+            !file.ReadObject(compressed) || !file.ReadObject(active)) {
+            m_segments.clear();
+            return;
+        }
+        segment.compressed = compressed != 0;
+        segment.active = active != 0;
+        m_segments.push_back(segment);
+    }
+    m_valid = true;
+}
+
+const LogSegment* LogSegmentIndex::Find(std::chrono::system_clock::time_point time) const {
+    const s64 micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    const auto it = std::ranges::find_if(m_segments, [micros](const LogSegment& segment) {
+        return segment.active || (segment.size != 0 && micros <= segment.last_time);
+    });
+    return it != m_segments.end() ? &*it : nullptr;
+}
+
+std::filesystem::path LogSegmentIndex::GetSegmentPath(const LogSegment& segment) const {
+    if (segment.active) {
+        return m_log_path;
+    }
+    auto path = m_log_path;
+    path.replace_extension(fmt::format(".{}", segment.sequence));
+    path += m_log_path.extension();
+    if (segment.compressed) {
+        path += ".gz";
+    }
+    return path;
+}
+
+std::optional<std::string> LogSegmentIndex::Read(const LogSegment& segment) const {
+    const auto data = ReadWholeFile(GetSegmentPath(segment));
+    if (!data) {
+        return std::nullopt;
+    }
+    if (!segment.compressed) {
+        return std::string(data->begin(), data->end());
+    }
+
+    libdeflate_decompressor* decompressor = libdeflate_alloc_decompressor();
+    if (!decompressor) {
+        return std::nullopt;
+    }
+    std::string text(segment.size, '\0');
+    size_t text_size = 0;
+    const libdeflate_result result = libdeflate_gzip_decompress(
+        decompressor, data->data(), data->size(), text.data(), text.size(), &text_size);
+    libdeflate_free_decompressor(decompressor);
+    if (result != LIBDEFLATE_SUCCESS) {
+        return std::nullopt;
+    }
+    text.resize(text_size);
+    return text;
+}
+
+bool LogSegmentIndex::Save() const {
+    const auto index_path = GetIndexPath(m_log_path);
+    auto temp_path = index_path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile file(temp_path, Common::FS::FileAccessMode::Write);
+        if (!file.IsOpen()) {
+            return false;
+        }
+        file.WriteObject(IndexMagic);
+        file.WriteObject(IndexVersion);
+        file.WriteObject(static_cast<u32>(m_segments.size()));
+        for (const LogSegment& segment : m_segments) {
+            file.WriteObject(segment.sequence);
+            file.WriteObject(segment.session);
+            file.WriteObject(segment.first_time);
+            file.WriteObject(segment.last_time);
+            file.WriteObject(segment.size);
+            file.WriteObject(segment.stored_size);
+            file.WriteObject(static_cast<u8>(segment.compressed));
+            file.WriteObject(static_cast<u8>(segment.active));
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, index_path, ec);
+    return !ec;
+}
+
+RotatingLogFile::RotatingLogFile(const std::filesystem::path& path, bool append,
+                                 u64 segment_size, u64 total_size_limit)
+    : m_path{path}, m_session{NowMicros()}, m_segment_size{segment_size},
+      m_total_size_limit{total_size_limit}, m_index{path} {
+    auto& segments = m_index.m_segments;
+    u64 next_sequence = segments.empty() ? 0 : segments.back().sequence + 1;
+
+    std::error_code ec;
+    const u64 leftover_size = std::filesystem::file_size(path, ec);
+    const bool has_leftover = !ec && leftover_size != 0;
+    if (!segments.empty() && segments.back().active) {
+        LogSegment& leftover = segments.back();
+        if (append && has_leftover) {
+            // Keep writing to it
+            next_sequence = leftover.sequence;
+            m_active_first = leftover.first_time;
+            m_active_last = leftover.last_time;
+            segments.pop_back();
+        } else if (has_leftover) {
+            // Closed like any other segment, instead of being overwritten
+            leftover.active = false;
+            leftover.size = leftover.stored_size = leftover_size;
+            std::filesystem::rename(path, m_index.GetSegmentPath(leftover), ec);
+            if (ec) {
+                segments.pop_back();
+            }
+        } else {
+            segments.pop_back();
+        }
+    }
+    for (const LogSegment& segment : segments) {
+        if (!segment.compressed) {
+            m_queue.push_back(segment.sequence);
+        }
+    }
+
+    OpenActive(append);
+    segments.push_back({.sequence = next_sequence, .session = m_session, .active = true});
+    UpdateActiveLocked();
+    TrimLocked();
+    m_index.Save();
+
+    m_thread = std::jthread([this](std::stop_token stop_token) { Run(stop_token); });
+}
+
+RotatingLogFile::~RotatingLogFile() {
+    m_thread.request_stop();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_file.Close();
+
+    std::scoped_lock lock{m_mutex};
+    UpdateActiveLocked();
+    m_index.Save();
+}
+
+void RotatingLogFile::SetLimits(u64 segment_size, u64 total_size_limit) {
+    m_segment_size.store(segment_size, std::memory_order_relaxed);
+    m_total_size_limit.store(total_size_limit, std::memory_order_relaxed);
+}
+
+void RotatingLogFile::Write(std::string_view text, std::chrono::microseconds first,
+                            std::chrono::microseconds last) {
+    std::scoped_lock lock{m_write_mutex};
+    const u64 rotate_size = std::max(m_segment_size.load(std::memory_order_relaxed), m_retry_size);
+    if (m_active_size != 0 && m_active_size + text.size() > rotate_size) {
+        Rotate();
+    }
+    if (!m_file.IsOpen()) {
+        return;
+    }
+
+    m_active_size += m_file.WriteString(text);
+    if (!m_active_first) {
+        m_active_first = m_session + first.count();
+    }
+    m_active_last = m_session + last.count();
+}
+
+void RotatingLogFile::Flush() {
+    std::scoped_lock lock{m_write_mutex};
+    m_file.Flush();
+}
+
+void RotatingLogFile::OpenActive(bool append) {
+    std::error_code ec;
+    const u64 size = append ? std::filesystem::file_size(m_path, ec) : 0;
+    m_active_size = ec ? 0 : size;
+    m_file.Open(m_path, append ? Common::FS::FileAccessMode::Append
+                               : Common::FS::FileAccessMode::Create,
+                Common::FS::FileType::TextFile);
+}
+
+void RotatingLogFile::Rotate() {
+    m_file.Close();
+
+    bool rotated = false;
+    {
+        std::scoped_lock lock{m_mutex};
+        UpdateActiveLocked();
+        LogSegment& segment = m_index.m_segments.back();
+        segment.active = false;
+        std::error_code ec;
+        std::filesystem::rename(m_path, m_index.GetSegmentPath(segment), ec);
+        if (ec) {
+            // Most likely open in another program, keep writing to it
+            segment.active = true;
+        } else {
+            rotated = true;
+            m_queue.push_back(segment.sequence);
+            const u64 next_sequence = segment.sequence + 1;
+            m_index.m_segments.push_back(
+                {.sequence = next_sequence, .session = m_session, .active = true});
+            m_active_first.reset();
+            m_active_last = 0;
+            TrimLocked();
+        }
+        m_index.Save();
+    }
+    if (rotated) {
+        m_cv.notify_one();
+    }
+    OpenActive(!rotated);
+    // A failed rotation is tried again a segment later, not on every write
+    m_retry_size = rotated ? 0 : m_active_size + m_segment_size.load(std::memory_order_relaxed);
+}
+
+void RotatingLogFile::UpdateActiveLocked() {
+    LogSegment& active = m_index.m_segments.back();
+    active.size = active.stored_size = m_active_size;
+    active.first_time = m_active_first.value_or(0);
+    active.last_time = m_active_last;
+}
+
+void RotatingLogFile::TrimLocked() {
+    auto& segments = m_index.m_segments;
+    u64 total_size = 0;
+    for (const LogSegment& segment : segments) {
+        total_size += segment.stored_size;
+    }
+
+    const u64 limit = m_total_size_limit.load(std::memory_order_relaxed);
+    while (total_size > limit && !segments.front().active) {
+        const LogSegment& oldest = segments.front();
+        std::error_code ec;
+        std::filesystem::remove(m_index.GetSegmentPath(oldest), ec);
+        std::erase(m_queue, oldest.sequence);
+        total_size -= oldest.stored_size;
+        segments.erase(segments.begin());
+    }
+}
+
+void RotatingLogFile::Run(std::stop_token stop_token) {
+    while (!stop_token.stop_requested()) {
+        LogSegment segment;
+        {
+            std::unique_lock lock{m_mutex};
+            Common::CondvarWait(m_cv, lock, stop_token, [this] { return !m_queue.empty(); });
+            if (stop_token.stop_requested()) {
+                return;
+            }
+            const u64 sequence = m_queue.front();
+            m_queue.pop_front();
+            const auto it = std::ranges::find(m_index.m_segments, sequence, &LogSegment::sequence);
+            if (it == m_index.m_segments.end()) {
+                continue;
+            }
+            segment = *it;
+        }
+
+        const std::optional<u64> stored_size = Compress(segment);
+        if (!stored_size) {
+            continue;
+        }
+
+        std::scoped_lock lock{m_mutex};
+        auto& segments = m_index.m_segments;
+        const auto it = std::ranges::find(segments, segment.sequence, &LogSegment::sequence);
+        std::error_code ec;
+        if (it == segments.end()) {
+            // Trimmed while it was compressed
+            segment.compressed = true;
+            std::filesystem::remove(m_index.GetSegmentPath(segment), ec);
+            continue;
+        }
+        std::filesystem::remove(m_index.GetSegmentPath(*it), ec);
+        it->compressed = true;
+        it->stored_size = *stored_size;
+        TrimLocked();
+        m_index.Save();
+    }
+}
+
+std::optional<u64> RotatingLogFile::Compress(const LogSegment& segment) const {
+    const auto text = ReadWholeFile(m_index.GetSegmentPath(segment));
+    if (!text) {
+        return std::nullopt;
+    }
+
+    libdeflate_compressor* compressor = libdeflate_alloc_compressor(CompressionLevel);
+    if (!compressor) {
+        return std::nullopt;
+    }
+    std::vector<u8> compressed(libdeflate_gzip_compress_bound(compressor, text->size()));
+    compressed.resize(libdeflate_gzip_compress(compressor, text->data(), text->size(),
+                                               compressed.data(), compressed.size()));
+    libdeflate_free_compressor(compressor);
+    if (compressed.empty()) {
+        return std::nullopt;
+    }
+
+    LogSegment compressed_segment = segment;
+    compressed_segment.compressed = true;
+    const auto path = m_index.GetSegmentPath(compressed_segment);
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile file(temp_path, Common::FS::FileAccessMode::Write);
+        if (file.WriteSpan(std::span<const u8>(compressed)) != compressed.size()) {
+            return std::nullopt;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return std::nullopt;
+    }
+    return compressed.size();
+}
+
+} // namespace Common::Log
@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/io_file.h"
+#include "common/polyfill_thread.h"
+#include "common/types.h"
+
+namespace Common::Log {
+
+/**
+ * Rotating log storage. The log file being written is the active segment. Once it reaches the
+ * segment size it is renamed to <stem>.<sequence><extension> and compressed to a .gz next to it
+ * in the background. The oldest segments are deleted once all of them together exceed the total
+ * size limit.
+ *
+ * <stem>.index lists the segments with the time range of their messages, so a point of a session
+ * can be opened by decompressing a single segment. The index is only rewritten when the log
+ * rotates, a segment is compressed or the log is closed, so the range of the active segment in it
+ * can be behind the log.
+ */
+struct LogSegment {
+    u64 sequence = 0;
+    s64 session = 0;    ///< Start of the session that wrote it, in microseconds since the epoch
+    s64 first_time = 0; ///< Time of the first message, in microseconds since the epoch
+    s64 last_time = 0;  ///< Time of the last message, in microseconds since the epoch
+    u64 size = 0;       ///< Size of the text
+    u64 stored_size = 0;
+    bool compressed = false;
+    bool active = false;
+};
+
+/// The segments of a rotating log, oldest first. The active segment, if any, is the last one.
+class LogSegmentIndex {
+public:
+    /// Loads the index of the log written to log_path.
+    explicit LogSegmentIndex(const std::filesystem::path& log_path);
+
+    /// False if the log has no index.
+    bool IsValid() const {
+        return m_valid;
+    }
+
+    const std::vector<LogSegment>& GetSegments() const {
+        return m_segments;
+    }
+
+    /// The segment whose time range contains time, or the first one after it. The active segment
+    /// holds everything after the segments before it. Nullptr if no segment does.
+    const LogSegment* Find(std::chrono::system_clock::time_point time) const;
+
+    std::filesystem::path GetSegmentPath(const LogSegment& segment) const;
+
+    /// Reads the text of a segment, decompressing it if needed.
+    std::optional<std::string> Read(const LogSegment& segment) const;
+
+private:
+    friend class RotatingLogFile;
+
+    bool Save() const;
+
+    std::filesystem::path m_log_path;
+    std::vector<LogSegment> m_segments;
+    bool m_valid = false;
+};
+
+/// Writes the active segment of a rotating log, see LogSegment.
+class RotatingLogFile {
+public:
+    /// Without append a leftover active segment of the previous session is rotated first.
+    RotatingLogFile(const std::filesystem::path& path, bool append, u64 segment_size,
+                    u64 total_size_limit);
+    ~RotatingLogFile();
+
+    RotatingLogFile(const RotatingLogFile&) = delete;
+    RotatingLogFile& operator=(const RotatingLogFile&) = delete;
+
+    /// Can be called from any thread, applies from the next write.
+    void SetLimits(u64 segment_size, u64 total_size_limit);
+
+    /// Writes text holding the messages logged from first to last, which are offsets from the
+    /// start of the session. Rotates first if the text doesn't fit in the active segment. Can be
+    /// called from any thread, the logging threads write directly while there's no backend thread.
+    void Write(std::string_view text, std::chrono::microseconds first,
+               std::chrono::microseconds last);
+    /// Flushes the active segment.
+    void Flush();
+
+private:
+    void OpenActive(bool append);
+    void Rotate();
+    void UpdateActiveLocked();
+    void TrimLocked();
+    void Run(std::stop_token stop_token);
+    std::optional<u64> Compress(const LogSegment& segment) const;
+
+    const std::filesystem::path m_path;
+    const s64 m_session;
+    std::atomic<u64> m_segment_size;
+    std::atomic<u64> m_total_size_limit;
+
+    std::mutex m_write_mutex; ///< Guards the active segment
+    Common::FS::IOFile m_file;
+    u64 m_active_size = 0;
+    u64 m_retry_size = 0; ///< Size to rotate at instead of the segment size after a failure
+    std::optional<s64> m_active_first;
+    s64 m_active_last = 0;
+
+    std::mutex m_mutex; ///< Guards the index and the queue, shared with the compression thread
+    LogSegmentIndex m_index;
+    std::deque<u64> m_queue; ///< Sequences of the segments to compress
+    std::condition_variable_any m_cv;
+    std::jthread m_thread;
+};
+
+} // namespace Common::Log
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cstdio>
+#include <iterator>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -19,17 +20,64 @@
 
 namespace Common::Log {
 
-std::string FormatLogMessage(const Entry& entry) {
-    const u32 time_seconds = static_cast<u32>(entry.timestamp.count() / 1000000);
-    const u32 time_fractional = static_cast<u32>(entry.timestamp.count() % 1000000);
+namespace {
 
+template <typename OutputIt>
+OutputIt FormatLogMessageTo(OutputIt out, const Entry& entry) {
     const char* class_name = GetLogClassName(entry.log_class);
     const char* level_name = GetLevelName(entry.log_level);
 
-    return fmt::format("[{}] <{}> {}:{} {}: {}", class_name, level_name, entry.filename,
-                       entry.line_num, entry.function, entry.message);
+    return fmt::format_to(out, "[{}] <{}> {}:{} {}: {}", class_name, level_name, entry.filename,
+                          entry.line_num, entry.function, entry.message);
+}
+
+#ifndef _WIN32
+#define ESC "\x1b"
+const char* GetLevelColor(Level log_level) {
+    switch (log_level) {
+    case Level::Trace: // Grey
+        return ESC "[1;30m";
+    case Level::Debug: // Cyan
+        return ESC "[0;36m";
+    case Level::Info: // Bright gray
+        return ESC "[0;37m";
+    case Level::Warning: // Bright yellow
+        return ESC "[1;33m";
+    case Level::Error: // Bright red
+        return ESC "[1;31m";
+    case Level::Critical: // Bright magenta
+        return ESC "[1;35m";
+    case Level::Count:
+        UNREACHABLE();
+    }
+    return "";
+}
+
+constexpr const char* ResetColor = ESC "[0m";
+#undef ESC
+#endif
+
+} // namespace
+
+std::string FormatLogMessage(const Entry& entry) {
+    std::string message;
+    FormatLogMessageTo(std::back_inserter(message), entry);
+    return message;
+}
+
+void AppendLogMessage(std::string& buffer, const Entry& entry) {
+    FormatLogMessageTo(std::back_inserter(buffer), entry);
+    buffer.push_back('\n');
 }
 
+#ifndef _WIN32
+void AppendColoredLogMessage(std::string& buffer, const Entry& entry) {
+    buffer.append(GetLevelColor(entry.log_level));
+    AppendLogMessage(buffer, entry);
+    buffer.append(ResetColor);
+}
+#endif
+
 void PrintMessage(const Entry& entry) {
     const auto str = FormatLogMessage(entry).append(1, '\n');
     fputs(str.c_str(), stdout);
@@ -71,32 +119,7 @@ void PrintColoredMessage(const Entry& entry) {
 
     SetConsoleTextAttribute(console_handle, color);
 #else
-#define ESC "\x1b"
-    const char* color = "";
-    switch (entry.log_level) {
-    case Level::Trace: // Grey
-        color = ESC "[1;30m";
-        break;
-    case Level::Debug: // Cyan
-        color = ESC "[0;36m";
-        break;
-    case Level::Info: // Bright gray
-        color = ESC "[0;37m";
-        break;
-    case Level::Warning: // Bright yellow
-        color = ESC "[1;33m";
-        break;
-    case Level::Error: // Bright red
-        color = ESC "[1;31m";
-        break;
-    case Level::Critical: // Bright magenta
-        color = ESC "[1;35m";
-        break;
-    case Level::Count:
-        UNREACHABLE();
-    }
-
-    fputs(color, stdout);
+    fputs(GetLevelColor(entry.log_level), stdout);
 #endif
 
     PrintMessage(entry);
@@ -104,8 +127,7 @@ void PrintColoredMessage(const Entry& entry) {
 #ifdef _WIN32
     SetConsoleTextAttribute(console_handle, original_info.wAttributes);
 #else
-    fputs(ESC "[0m", stdout);
-#undef ESC
+    fputs(ResetColor, stdout);
 #endif
 }
 
@@ -15,6 +15,14 @@ struct Entry;
 /// Formats a log entry into the provided text buffer.
 std::string FormatLogMessage(const Entry& entry);
 
+/// Appends the formatted log entry and a newline to the buffer.
+void AppendLogMessage(std::string& buffer, const Entry& entry);
+
+#ifndef _WIN32
+/// Same as `AppendLogMessage`, surrounded by the terminal colors of the severity level.
+void AppendColoredLogMessage(std::string& buffer, const Entry& entry);
+#endif
+
 /// Formats and prints a log entry to stderr.
 void PrintMessage(const Entry& entry);
 
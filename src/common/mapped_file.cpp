@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <utility>
+#include "common/mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace Common::FS {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    Open(path);
+}
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        Close();
+        file = std::move(other.file);
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+#ifdef _WIN32
+        mapping = std::exchange(other.mapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+bool MappedFile::Open(const std::filesystem::path& path) {
+    Close();
+
+    if (file.Open(path, FileAccessMode::Read) != 0 || !file.IsOpen()) {
+        return false;
+    }
+    size = file.GetSize();
+    if (size == 0) {
+        return true;
+    }
+
+    // Read-only IOFiles hand out their OS handle (Windows) or descriptor as file mapping.
+#ifdef _WIN32
+    const HANDLE handle = reinterpret_cast<HANDLE>(file.GetFileMapping());
+    mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) {
+        data = static_cast<const u8*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    void* view = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED,
+                      static_cast<int>(file.GetFileMapping()), 0);
+    if (view != MAP_FAILED) {
+        data = static_cast<const u8*>(view);
+    }
+#endif
+    if (!data) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (mapping) {
+        CloseHandle(mapping);
+        mapping = nullptr;
+    }
+#else
+    if (data) {
+        munmap(const_cast<u8*>(data), static_cast<size_t>(size));
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    file.Close();
+}
+
+} // namespace Common::FS
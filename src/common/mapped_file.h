@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <type_traits>
+#include "common/io_file.h"
+#include "common/types.h"
+
+namespace Common::FS {
+
+/**
+ * Read-only mapping of a whole file. Pages are read on first access, so parsing a large file
+ * only touches the parts that are used and several threads can read it without seeking.
+ */
+class MappedFile final {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// An empty file opens successfully with no data.
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    bool IsOpen() const {
+        return file.IsOpen();
+    }
+
+    u64 GetSize() const {
+        return size;
+    }
+
+    std::span<const u8> Data() const {
+        return {data, static_cast<size_t>(size)};
+    }
+
+    /// Bytes [offset, offset + length), empty if the range is outside the file.
+    std::span<const u8> Subspan(u64 offset, u64 length) const {
+        if (offset > size || length > size - offset) {
+            return {};
+        }
+        return Data().subspan(static_cast<size_t>(offset), static_cast<size_t>(length));
+    }
+
+    /// Copies a trivially copyable object out of the mapping, which needs no alignment.
+    template <typename T>
+    bool ReadObject(u64 offset, T& object) const {
+        static_assert(std::is_trivially_copyable_v<T>, "Data type must be trivially copyable.");
+        const auto bytes = Subspan(offset, sizeof(T));
+        if (bytes.size() != sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&object, bytes.data(), sizeof(T));
+        return true;
+    }
+
+private:
+    IOFile file;
+    const u8* data = nullptr;
+    u64 size = 0;
+#ifdef _WIN32
+    void* mapping = nullptr;
+#endif
+};
+
+} // namespace Common::FS
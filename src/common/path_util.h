@@ -25,6 +25,7 @@ enum class PathType {
     CustomTrophy,       // Where custom files for trophies are stored.
     CacheDir,           // Where pipeline and shader cache is stored.
     FontsDir,           // Where dumped system fonts are stored.
+    MetaDataDir,        // Where game metadata (e.g. trophy files) is stored.
 };
 
 // Sub-directories contained within a user data directory
@@ -40,6 +41,7 @@ constexpr auto PATCHES_DIR = "patches";
 constexpr auto CHEATS_DIR = "cheats";
 constexpr auto CACHE_DIR = "cache";
 constexpr auto FONTS_DIR = "fonts";
+constexpr auto METADATA_DIR = "game_data";
 
 // Filenames
 constexpr auto LOG_FILE = "shadLauncher4.txt";
@@ -27,6 +27,12 @@ void CondvarWait(Condvar& cv, std::unique_lock<Lock>& lk, std::stop_token token,
     cv.wait(lk, token, std::forward<Pred>(pred));
 }
 
+template <typename Condvar, typename Lock, typename Rep, typename Period, typename Pred>
+bool CondvarWaitFor(Condvar& cv, std::unique_lock<Lock>& lk, std::stop_token token,
+                    const std::chrono::duration<Rep, Period>& rel_time, Pred&& pred) {
+    return cv.wait_for(lk, token, rel_time, std::forward<Pred>(pred));
+}
+
 template <typename Rep, typename Period>
 bool StoppableTimedWait(std::stop_token token, const std::chrono::duration<Rep, Period>& rel_time) {
     std::condition_variable_any cv;
@@ -351,6 +357,24 @@ void CondvarWait(Condvar& cv, std::unique_lock<Lock>& lk, std::stop_token token,
     cv.wait(lk, [&] { return pred() || token.stop_requested(); });
 }
 
+template <typename Condvar, typename Lock, typename Rep, typename Period, typename Pred>
+bool CondvarWaitFor(Condvar& cv, std::unique_lock<Lock>& lk, std::stop_token token,
+                    const std::chrono::duration<Rep, Period>& rel_time, Pred pred) {
+    if (token.stop_requested()) {
+        return pred();
+    }
+
+    std::stop_callback callback(token, [&] {
+        {
+            std::scoped_lock lk2{*lk.mutex()};
+        }
+        cv.notify_all();
+    });
+
+    cv.wait_for(lk, rel_time, [&] { return pred() || token.stop_requested(); });
+    return pred();
+}
+
 template <typename Rep, typename Period>
 bool StoppableTimedWait(std::stop_token token, const std::chrono::duration<Rep, Period>& rel_time) {
     if (token.stop_requested()) {
@@ -0,0 +1,256 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <ctime>
+#include <optional>
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include "common/session_log.h"
+
+namespace Common {
+
+namespace {
+constexpr u32 IndexMagic = 0x58444953; // "SIDX"
+constexpr u32 IndexVersion = 1;
+constexpr size_t MaxClassNameSize = 64;
+
+constexpr std::array<std::string_view, static_cast<size_t>(Log::Level::Count)> LevelNames{
+    "Trace", "Debug", "Info", "Warning", "Error", "Critical",
+};
+
+std::filesystem::path GetIndexPath(const std::filesystem::path& log_path) {
+    auto path = log_path;
+    path.replace_extension(".idx");
+    return path;
+}
+
+// "Class.Sub" of a line starting with "[Class.Sub] ", empty if there is none.
+std::string_view ParseClass(std::string_view line) {
+    if (line.empty() || line[0] != '[') {
+        return {};
+    }
+    const size_t end = line.find(']');
+    if (end == line.npos || end == 1 || end > MaxClassNameSize) {
+        return {};
+    }
+    return line.substr(1, end - 1);
+}
+
+// The level of a line starting with "[Class] <Level> ".
+std::optional<Log::Level> ParseLevel(std::string_view line, size_t class_size) {
+    const size_t begin = class_size + 4;
+    if (class_size == 0 || line.size() <= begin || line[begin - 1] != '<') {
+        return std::nullopt;
+    }
+    const size_t end = line.find('>', begin);
+    if (end == line.npos) {
+        return std::nullopt;
+    }
+    const auto it = std::ranges::find(LevelNames, line.substr(begin, end - begin));
+    if (it == LevelNames.end()) {
+        return std::nullopt;
+    }
+    return static_cast<Log::Level>(it - LevelNames.begin());
+}
+} // namespace
+
+SessionLogWriter::SessionLogWriter(const std::filesystem::path& log_path)
+    : m_log{log_path, Common::FS::FileAccessMode::Write},
+      m_index{GetIndexPath(log_path), Common::FS::FileAccessMode::Write},
+      m_start{std::chrono::steady_clock::now()} {
+    m_index.WriteObject(IndexMagic);
+    m_index.WriteObject(IndexVersion);
+}
+
+void SessionLogWriter::Append(std::string_view line, bool is_stderr) {
+    if (!IsOpen()) {
+        return;
+    }
+
+    const auto elapsed = std::chrono::steady_clock::now() - m_start;
+    SessionLogLine record{
+        .offset = m_offset,
+        .time_ms = static_cast<u32>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()),
+        .class_id = 0,
+        .level = is_stderr ? Log::Level::Error : Log::Level::Info,
+        .flags = is_stderr ? SessionLogStderr : u8{0},
+    };
+    const std::string_view class_name = ParseClass(line);
+    if (!class_name.empty()) {
+        auto it = m_classes.find(class_name);
+        if (it == m_classes.end() && m_classes.size() < UINT16_MAX) {
+            const u16 id = static_cast<u16>(m_classes.size() + 1);
+            it = m_classes.emplace(std::string(class_name), id).first;
+        }
+        if (it != m_classes.end()) {
+            record.class_id = it->second;
+        }
+    }
+    if (const auto level = ParseLevel(line, class_name.size())) {
+        record.level = *level;
+    }
+
+    m_log.WriteString(line);
+    m_log.WriteString(std::string_view{"\n"});
+    m_offset += line.size() + 1;
+    m_index.WriteObject(record);
+}
+
+void SessionLogWriter::Flush() {
+    // The log first, so the index never points past it
+    m_log.Flush();
+    m_index.Flush();
+}
+
+std::filesystem::path SessionLogWriter::CreateSessionPath(const std::filesystem::path& dir,
+                                                          std::string_view name,
+                                                          size_t max_sessions) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+
+    // The names start with the time, so they sort oldest first
+    std::vector<std::filesystem::path> sessions;
+    for (std::filesystem::directory_iterator it(dir, ec), end; it != end && !ec;
+         it.increment(ec)) {
+        if (it->path().extension() == ".log") {
+            sessions.push_back(it->path());
+        }
+    }
+    std::ranges::sort(sessions);
+    const size_t keep = max_sessions == 0 ? 0 : max_sessions - 1;
+    for (size_t i = 0; i + keep < sessions.size(); ++i) {
+        std::filesystem::remove(sessions[i], ec);
+        std::filesystem::remove(GetIndexPath(sessions[i]), ec);
+    }
+
+    // With milliseconds, a session started right after another one must not truncate its archive
+    using namespace std::chrono;
+    const auto now = system_clock::now();
+    const auto millis = duration_cast<milliseconds>(now.time_since_epoch()).count() % 1000;
+    const std::string stamp = fmt::format("{:%Y%m%d-%H%M%S}.{:03}",
+                                          fmt::localtime(system_clock::to_time_t(now)), millis);
+    std::string safe_name;
+    for (const char c : name) {
+        const bool safe = std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_';
+        safe_name += safe ? c : '_';
+    }
+    auto path = dir / fmt::format("{}_{}.log", stamp, safe_name);
+    for (u32 i = 2; std::filesystem::exists(path, ec); ++i) {
+        path = dir / fmt::format("{}-{}_{}.log", stamp, i, safe_name);
+    }
+    return path;
+}
+
+void SessionLogWriter::Remove(const std::filesystem::path& log_path) {
+    std::error_code ec;
+    std::filesystem::remove(log_path, ec);
+    std::filesystem::remove(GetIndexPath(log_path), ec);
+}
+
+SessionLogIndex::SessionLogIndex(const std::filesystem::path& log_path) : m_log_path{log_path} {
+    Common::FS::IOFile index(GetIndexPath(log_path), Common::FS::FileAccessMode::Read);
+    std::error_code ec;
+    m_log_size = std::filesystem::file_size(log_path, ec);
+    if (!index.IsOpen() || ec) {
+        return;
+    }
+
+    u32 magic{};
+    u32 version{};
+    if (!index.ReadObject(magic) || !index.ReadObject(version) || magic != IndexMagic ||
+        version != IndexVersion) {
+        return;
+    }
+    m_lines.resize((index.GetSize() - sizeof(magic) - sizeof(version)) / sizeof(SessionLogLine));
+    m_lines.resize(index.ReadSpan(std::span<SessionLogLine>(m_lines)));
+    // Lines of a running session that aren't in the log yet
+    while (!m_lines.empty() && m_lines.back().offset >= m_log_size) {
+        m_lines.pop_back();
+    }
+
+    // Ids are given in order of appearance, the first line of a class has its name
+    Common::FS::IOFile log(log_path, Common::FS::FileAccessMode::Read);
+    m_class_names.emplace_back();
+    std::string prefix(MaxClassNameSize + 2, '\0');
+    for (const SessionLogLine& line : m_lines) {
+        if (line.class_id != m_class_names.size()) {
+            continue;
+        }
+        if (!log.Seek(static_cast<s64>(line.offset))) {
+            return;
+        }
+        const size_t read = log.ReadSpan(std::span<char>(prefix));
+        m_class_names.emplace_back(ParseClass(std::string_view(prefix.data(), read)));
+    }
+    m_valid = true;
+}
+
+std::vector<u32> SessionLogIndex::Filter(u32 level_mask, std::span<const u16> classes) const {
+    std::vector<bool> class_filter(m_class_names.size(), classes.empty());
+    for (const u16 id : classes) {
+        if (id < class_filter.size()) {
+            class_filter[id] = true;
+        }
+    }
+
+    std::vector<u32> lines;
+    for (u32 i = 0; i < m_lines.size(); ++i) {
+        const SessionLogLine& line = m_lines[i];
+        if ((level_mask & (1u << static_cast<u32>(line.level))) != 0 &&
+            line.class_id < class_filter.size() && class_filter[line.class_id]) {
+            lines.push_back(i);
+        }
+    }
+    return lines;
+}
+
+u32 SessionLogIndex::FindTime(u32 time_ms) const {
+    const auto it = std::ranges::lower_bound(m_lines, time_ms, {}, &SessionLogLine::time_ms);
+    return static_cast<u32>(it - m_lines.begin());
+}
+
+std::vector<std::string> SessionLogIndex::ReadLines(std::span<const u32> lines) const {
+    std::vector<std::string> result;
+    Common::FS::IOFile log(m_log_path, Common::FS::FileAccessMode::Read);
+    if (!log.IsOpen()) {
+        return result;
+    }
+
+    std::string buffer;
+    size_t first = 0;
+    while (first < lines.size() && lines[first] < m_lines.size()) {
+        size_t last = first;
+        while (last + 1 < lines.size() && lines[last + 1] == lines[last] + 1 &&
+               lines[last + 1] < m_lines.size()) {
+            ++last;
+        }
+
+        const u64 begin = m_lines[lines[first]].offset;
+        buffer.resize(GetLineEnd(lines[last]) - begin);
+        if (!log.Seek(static_cast<s64>(begin)) ||
+            log.ReadSpan(std::span<char>(buffer)) != buffer.size()) {
+            break;
+        }
+        for (size_t i = first; i <= last; ++i) {
+            const u64 offset = m_lines[lines[i]].offset - begin;
+            std::string_view line(buffer.data() + offset, GetLineEnd(lines[i]) - begin - offset);
+            if (line.ends_with('\n')) {
+                line.remove_suffix(1);
+            }
+            result.emplace_back(line);
+        }
+        first = last + 1;
+    }
+    return result;
+}
+
+u64 SessionLogIndex::GetLineEnd(u32 line) const {
+    return line + 1 < m_lines.size() ? m_lines[line + 1].offset : m_log_size;
+}
+
+} // namespace Common
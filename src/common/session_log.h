@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/io_file.h"
+#include "common/logging/types.h"
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * Archive of the output of one emulator session. The lines go to <name>.log as they arrive and
+ * a record per line goes to <name>.idx, so a viewer can filter a large session by level and
+ * class or jump to a point in time and read only the byte ranges of the lines it shows.
+ *
+ * Index: u32 magic, u32 version, then one SessionLogLine per line of the log.
+ */
+struct SessionLogLine {
+    u64 offset;       ///< Of the line in the log
+    u32 time_ms;      ///< Time the line arrived, since the start of the session
+    u16 class_id;     ///< 0 for lines without a [Class] prefix
+    Log::Level level; ///< Info for stdout lines without a <Level>, Error for stderr lines
+    u8 flags;
+};
+static_assert(sizeof(SessionLogLine) == 16);
+
+constexpr u8 SessionLogStderr = 1 << 0;
+
+/// Writes the archive of a running session.
+class SessionLogWriter {
+public:
+    explicit SessionLogWriter(const std::filesystem::path& log_path);
+
+    bool IsOpen() const {
+        return m_log.IsOpen() && m_index.IsOpen();
+    }
+
+    /// Appends a line, without its line break.
+    void Append(std::string_view line, bool is_stderr);
+
+    /// Makes the lines so far visible to readers.
+    void Flush();
+
+    /// Where in dir the archive of a session starting now goes. The oldest archives in dir are
+    /// deleted to keep at most max_sessions with the new one.
+    static std::filesystem::path CreateSessionPath(const std::filesystem::path& dir,
+                                                   std::string_view name, size_t max_sessions);
+
+    /// Deletes the archive of a session that is no longer written.
+    static void Remove(const std::filesystem::path& log_path);
+
+private:
+    Common::FS::IOFile m_log;
+    Common::FS::IOFile m_index;
+    u64 m_offset = 0;
+    std::chrono::steady_clock::time_point m_start;
+    std::map<std::string, u16, std::less<>> m_classes;
+};
+
+/// Reads the index of an archived session. Works on a session that is still being written, lines
+/// added later need a new index.
+class SessionLogIndex {
+public:
+    explicit SessionLogIndex(const std::filesystem::path& log_path);
+
+    bool IsValid() const {
+        return m_valid;
+    }
+
+    std::span<const SessionLogLine> GetLines() const {
+        return m_lines;
+    }
+
+    /// Names of the classes by id, the first one is empty.
+    const std::vector<std::string>& GetClassNames() const {
+        return m_class_names;
+    }
+
+    /// Numbers of the lines whose level is in level_mask (bit 1 << level) and whose class is one
+    /// of classes, or any class if it is empty.
+    std::vector<u32> Filter(u32 level_mask, std::span<const u16> classes = {}) const;
+
+    /// Number of the first line that arrived at or after time_ms, the line count if none did.
+    u32 FindTime(u32 time_ms) const;
+
+    /// Reads the given lines, in ascending order. Adjacent lines are read as a single range.
+    std::vector<std::string> ReadLines(std::span<const u32> lines) const;
+
+private:
+    u64 GetLineEnd(u32 line) const;
+
+    std::filesystem::path m_log_path;
+    std::vector<SessionLogLine> m_lines;
+    std::vector<std::string> m_class_names;
+    u64 m_log_size = 0;
+    bool m_valid = false;
+};
+
+} // namespace Common
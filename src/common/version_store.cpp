@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <fmt/core.h>
+#include "mapped_file.h"
+#include "picosha2.h"
+#include "version_store.h"
+
+namespace fs = std::filesystem;
+
+namespace VersionManager {
+
+namespace {
+
+fs::path BlobPath(const fs::path& store_dir, const std::string& hash) {
+    return store_dir / "objects" / hash.substr(0, 2) / hash.substr(2);
+}
+
+/// SHA-256 of the file as hex, empty if it cannot be read.
+std::string HashFile(const fs::path& path) {
+    const Common::FS::MappedFile file(path);
+    if (!file.IsOpen()) {
+        return {};
+    }
+    const auto data = file.Data();
+    std::array<u8, picosha2::k_digest_size> digest;
+    picosha2::hash256(data.begin(), data.end(), digest.begin(), digest.end());
+    return picosha2::bytes_to_hex_string(digest.begin(), digest.end());
+}
+
+/// Puts a hard link to (or a copy of) source at path, replacing path in a single rename.
+bool ReplaceWithLink(const fs::path& source, const fs::path& path, bool allow_copy) {
+    fs::path temp = path;
+    temp += ".new";
+    std::error_code ec;
+    fs::remove(temp, ec);
+    fs::create_hard_link(source, temp, ec);
+    if (ec && allow_copy) {
+        ec.clear();
+        fs::copy_file(source, temp, fs::copy_options::overwrite_existing, ec);
+    }
+    if (!ec) {
+        fs::rename(temp, path, ec);
+    }
+    if (ec) {
+        std::error_code ignored;
+        fs::remove(temp, ignored);
+        return false;
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
+StoreStats AddToStore(const fs::path& version_dir, const fs::path& store_dir) {
+    StoreStats stats{};
+    std::error_code ec;
+
+    // Listed first, linking renames files of the folder being walked
+    std::vector<fs::path> files;
+    for (auto it = fs::recursive_directory_iterator(version_dir, ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code entry_ec;
+        if (!it->is_symlink(entry_ec) && it->is_regular_file(entry_ec) &&
+            it->file_size(entry_ec) != 0) {
+            files.push_back(it->path());
+        }
+    }
+    if (ec) {
+        fmt::print(stderr, "VersionManager: Cannot list {}: {}\n", version_dir.string(),
+                   ec.message());
+    }
+
+    for (const fs::path& file : files) {
+        ++stats.files;
+        const std::string hash = HashFile(file);
+        if (hash.empty()) {
+            continue;
+        }
+
+        const fs::path blob = BlobPath(store_dir, hash);
+        if (!fs::exists(blob, ec)) {
+            fs::create_directories(blob.parent_path(), ec);
+            fs::create_hard_link(file, blob, ec);
+            continue;
+        }
+        // A link shares the permissions too, an executable never becomes a plain file
+        if (fs::equivalent(blob, file, ec) ||
+            fs::status(blob, ec).permissions() != fs::status(file, ec).permissions()) {
+            continue;
+        }
+        // The blob is the file of the first version with these contents, which may have been
+        // written in place since. Such a blob is replaced by this file instead of shared.
+        if (HashFile(blob) != hash) {
+            fs::remove(blob, ec);
+            fs::create_hard_link(file, blob, ec);
+            continue;
+        }
+        const u64 size = fs::file_size(file, ec);
+        if (ReplaceWithLink(blob, file, false)) {
+            ++stats.shared_files;
+            stats.shared_bytes += size;
+        }
+    }
+    return stats;
+}
+
+u64 CollectStoreGarbage(const fs::path& store_dir) {
+    u64 freed = 0;
+    std::error_code ec;
+    for (auto it = fs::recursive_directory_iterator(store_dir / "objects", ec);
+         !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code entry_ec;
+        if (!it->is_regular_file(entry_ec) || it->hard_link_count(entry_ec) != 1) {
+            continue;
+        }
+        const u64 size = it->file_size(entry_ec);
+        if (fs::remove(it->path(), entry_ec)) {
+            freed += size;
+        }
+    }
+    return freed;
+}
+
+bool ActivateExecutable(const fs::path& source, const fs::path& target) {
+    std::error_code ec;
+    if (!fs::is_regular_file(source, ec)) {
+        return false;
+    }
+    if (fs::equivalent(source, target, ec)) {
+        return true;
+    }
+
+    fs::path backup = target;
+    backup += ".backup";
+    if (fs::exists(target, ec)) {
+        fs::remove(backup, ec);
+#ifdef _WIN32
+        // A running executable can be renamed but not replaced
+        fs::rename(target, backup, ec);
+#else
+        fs::create_hard_link(target, backup, ec);
+#endif
+    }
+    if (ReplaceWithLink(source, target, true)) {
+        return true;
+    }
+#ifdef _WIN32
+    // Not left without an executable, the old one is put back
+    if (!fs::exists(target, ec) && fs::exists(backup, ec)) {
+        fs::rename(backup, target, ec);
+    }
+#endif
+    return false;
+}
+
+} // namespace VersionManager
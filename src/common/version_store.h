@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include "types.h"
+
+namespace VersionManager {
+
+struct StoreStats {
+    u64 files = 0;        ///< Regular files seen in the version folder
+    u64 shared_files = 0; ///< Files now sharing their data with another version
+    u64 shared_bytes = 0; ///< Disk space saved by the shared files
+};
+
+/**
+ * Adds the files of an installed version to a content-addressed store, a folder of blobs named by
+ * the SHA-256 of their contents. A file whose contents are already stored is replaced by a hard
+ * link to the blob, so identical files of different versions take disk space once; the version
+ * folder stays an ordinary tree of files. Hard links need store_dir and version_dir on one
+ * volume, files that cannot be linked are left as they are. A blob is the first file stored with
+ * its contents, so it is hashed again before another file is linked to it.
+ */
+StoreStats AddToStore(const std::filesystem::path& version_dir,
+                      const std::filesystem::path& store_dir);
+
+/// Removes the blobs no version links to anymore, returns the number of bytes freed.
+u64 CollectStoreGarbage(const std::filesystem::path& store_dir);
+
+/**
+ * Makes target the executable at source, linked rather than copied when both are on one volume.
+ * The previous target is kept as target.backup, and put back if the new one cannot be placed.
+ * The new executable is prepared next to target and renamed over it, so target never holds a
+ * partial file.
+ */
+bool ActivateExecutable(const std::filesystem::path& source, const std::filesystem::path& target);
+
+} // namespace VersionManager
@@ -1,135 +1,492 @@
 // SPDX-FileCopyrightText: Copyright 2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
-#include <QByteArray>
-#include <QDir>
-#include <QFile>
-#include <QFileInfo>
-#include <QMessageBox>
-#include <QString>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <common/endian.h>
+#include <common/io_file.h>
+#include <common/mapped_file.h>
+#include <common/path_util.h>
 #include <common/zip_util.h>
 #include <libdeflate.h>
 
 namespace Zip {
-void Extract(const QString& zipPath, const QString& outDir) {
-    QFile file(zipPath);
-    if (!file.open(QIODevice::ReadOnly))
-        throw std::runtime_error("Cannot open ZIP file");
 
-    QDir().mkpath(outDir);
+namespace {
 
-    libdeflate_decompressor* d = libdeflate_alloc_decompressor();
-    if (!d)
-        throw std::runtime_error("libdeflate alloc failed");
+constexpr u32 LocalHeaderSignature = 0x04034B50;
+constexpr u32 CentralHeaderSignature = 0x02014B50;
+constexpr u32 EndSignature = 0x06054B50;
+constexpr u32 Zip64LocatorSignature = 0x07064B50;
+constexpr u32 Zip64EndSignature = 0x06064B50;
+constexpr u16 Zip64ExtraId = 0x0001;
 
-    try {
-        while (!file.atEnd()) {
-            char sig[4];
-            if (file.read(sig, 4) != 4)
-                break;
+constexpr u16 FlagEncrypted = 1 << 0;
+constexpr u16 MethodStored = 0;
+constexpr u16 MethodDeflate = 8;
+constexpr u8 HostUnix = 3;
 
-            if (!(sig[0] == 0x50 && sig[1] == 0x4B && sig[2] == 0x03 && sig[3] == 0x04))
-                break;
+// Output written, and CRC computed, per step
+constexpr size_t ChunkSize = 4 * 1024 * 1024;
+// Decompressed bytes held at once by all workers, and the largest buffer a worker keeps
+constexpr u64 MaxInflateBytes = 256_MB;
+constexpr size_t KeptBufferSize = 16_MB;
+// The end record is followed by a comment of at most 64 KiB
+constexpr u64 MaxEndSearch = 22 + 0xFFFF;
 
-            quint16 version, flags, method, modTime, modDate;
-            quint32 crc32Header, compSizeHeader, uncompSizeHeader;
-            quint16 nameLen, extraLen;
+#pragma pack(push, 1)
+struct EndRecord {
+    u32_le signature;
+    u16_le disk;
+    u16_le directory_disk;
+    u16_le disk_entries;
+    u16_le entries;
+    u32_le directory_size;
+    u32_le directory_offset;
+    u16_le comment_size;
+};
+static_assert(sizeof(EndRecord) == 22);
 
-            file.read(reinterpret_cast<char*>(&version), 2);
-            file.read(reinterpret_cast<char*>(&flags), 2);
-            file.read(reinterpret_cast<char*>(&method), 2);
-            file.read(reinterpret_cast<char*>(&modTime), 2);
-            file.read(reinterpret_cast<char*>(&modDate), 2);
-            file.read(reinterpret_cast<char*>(&crc32Header), 4);
-            file.read(reinterpret_cast<char*>(&compSizeHeader), 4);
-            file.read(reinterpret_cast<char*>(&uncompSizeHeader), 4);
-            file.read(reinterpret_cast<char*>(&nameLen), 2);
-            file.read(reinterpret_cast<char*>(&extraLen), 2);
+struct Zip64Locator {
+    u32_le signature;
+    u32_le directory_disk;
+    u64_le end_offset;
+    u32_le disks;
+};
+static_assert(sizeof(Zip64Locator) == 20);
 
-            if (method != 8)
-                throw std::runtime_error("Only DEFLATE supported");
+struct Zip64EndRecord {
+    u32_le signature;
+    u64_le record_size;
+    u16_le version_made_by;
+    u16_le version_needed;
+    u32_le disk;
+    u32_le directory_disk;
+    u64_le disk_entries;
+    u64_le entries;
+    u64_le directory_size;
+    u64_le directory_offset;
+};
+static_assert(sizeof(Zip64EndRecord) == 56);
 
-            QByteArray filename = file.read(nameLen);
-            file.skip(extraLen);
+struct CentralHeader {
+    u32_le signature;
+    u16_le version_made_by;
+    u16_le version_needed;
+    u16_le flags;
+    u16_le method;
+    u16_le time;
+    u16_le date;
+    u32_le crc32;
+    u32_le compressed_size;
+    u32_le size;
+    u16_le name_size;
+    u16_le extra_size;
+    u16_le comment_size;
+    u16_le disk;
+    u16_le internal_attributes;
+    u32_le external_attributes;
+    u32_le local_header_offset;
+};
+static_assert(sizeof(CentralHeader) == 46);
 
-            QByteArray compressed;
+struct LocalHeader {
+    u32_le signature;
+    u16_le version_needed;
+    u16_le flags;
+    u16_le method;
+    u16_le time;
+    u16_le date;
+    u32_le crc32;
+    u32_le compressed_size;
+    u32_le size;
+    u16_le name_size;
+    u16_le extra_size;
+};
+static_assert(sizeof(LocalHeader) == 30);
+#pragma pack(pop)
 
-            if (flags & 0x08) {
-                // Data Descriptor
-                constexpr int BUF = 256 * 1024;
-                char buffer[BUF];
+struct Entry {
+    std::filesystem::path path; ///< Relative to the output directory
+    u64 data_offset;
+    u64 compressed_size;
+    u64 size;
+    u32 crc32;
+    u16 method;
+    u32 unix_mode; ///< 0 unless the archive was made on Unix
+};
 
-                qint64 dataStart = file.pos();
+[[noreturn]] void Fail(const std::string& message) {
+    throw std::runtime_error(message);
+}
 
-                while (!file.atEnd()) {
-                    qint64 r = file.read(buffer, sizeof(buffer));
-                    if (r <= 0)
-                        break;
+// The end record is searched backwards, as its comment has a variable size
+EndRecord FindEnd(const Common::FS::MappedFile& zip, u64& end_offset) {
+    const u64 size = zip.GetSize();
+    if (size < sizeof(EndRecord)) {
+        Fail("Not a ZIP file");
+    }
+    const u64 lowest = size > MaxEndSearch ? size - MaxEndSearch : 0;
+    for (u64 offset = size - sizeof(EndRecord);; --offset) {
+        EndRecord end;
+        if (zip.ReadObject(offset, end) && end.signature == EndSignature &&
+            offset + sizeof(EndRecord) + end.comment_size == size) {
+            end_offset = offset;
+            return end;
+        }
+        if (offset == lowest) {
+            Fail("Not a ZIP file");
+        }
+    }
+}
 
-                    compressed.append(buffer, r);
+// Replaces the 32-bit fields saturated to all ones with their value in the Zip64 extra field
+void ReadZip64Extra(std::span<const u8> extra, const CentralHeader& header, Entry& entry,
+                    u64& local_header_offset) {
+    while (extra.size() >= 4) {
+        const u16 id = extra[0] | extra[1] << 8;
+        const u16 size = extra[2] | extra[3] << 8;
+        if (extra.size() < 4u + size) {
+            break;
+        }
+        if (id == Zip64ExtraId) {
+            auto field = extra.subspan(4, size);
+            const auto take = [&field](u64& value) {
+                if (field.size() < 8) {
+                    Fail("Corrupted Zip64 extra field");
+                }
+                value = 0;
+                for (int i = 7; i >= 0; --i) {
+                    value = value << 8 | field[i];
+                }
+                field = field.subspan(8);
+            };
+            if (header.size == 0xFFFFFFFF) {
+                take(entry.size);
+            }
+            if (header.compressed_size == 0xFFFFFFFF) {
+                take(entry.compressed_size);
+            }
+            if (header.local_header_offset == 0xFFFFFFFF) {
+                take(local_header_offset);
+            }
+            return;
+        }
+        extra = extra.subspan(4u + size);
+    }
+}
 
-                    int idx = compressed.indexOf(QByteArray("\x50\x4B\x07\x08", 4));
+// Entries outside of the output directory are refused
+std::filesystem::path SafeRelativePath(std::string name) {
+    std::ranges::replace(name, '\\', '/');
+    const std::filesystem::path path(
+        std::u8string_view(reinterpret_cast<const char8_t*>(name.data()), name.size()));
+    if (path.empty() || path.has_root_name() || path.has_root_directory()) {
+        Fail("Invalid path in ZIP file: " + name);
+    }
+    for (const auto& part : path) {
+        if (part == "..") {
+            Fail("Invalid path in ZIP file: " + name);
+        }
+    }
+    return path;
+}
 
-                    if (idx != -1) {
-                        file.seek(dataStart + idx + 4);
-                        compressed.truncate(idx);
-                        break;
-                    }
-                }
+std::vector<Entry> ReadDirectory(const Common::FS::MappedFile& zip,
+                                 std::vector<std::filesystem::path>& directories) {
+    u64 end_offset = 0;
+    const EndRecord end = FindEnd(zip, end_offset);
+    u64 entries = end.entries;
+    u64 directory_offset = end.directory_offset;
+    u64 directory_size = end.directory_size;
 
-                quint32 crc32, compSize, uncompSize;
-                file.read(reinterpret_cast<char*>(&crc32), 4);
-                file.read(reinterpret_cast<char*>(&compSize), 4);
-                file.read(reinterpret_cast<char*>(&uncompSize), 4);
+    Zip64Locator locator;
+    if (end_offset >= sizeof(Zip64Locator) &&
+        zip.ReadObject(end_offset - sizeof(Zip64Locator), locator) &&
+        locator.signature == Zip64LocatorSignature) {
+        Zip64EndRecord end64;
+        if (!zip.ReadObject(locator.end_offset, end64) || end64.signature != Zip64EndSignature) {
+            Fail("Corrupted Zip64 end record");
+        }
+        entries = end64.entries;
+        directory_offset = end64.directory_offset;
+        directory_size = end64.directory_size;
+    }
+    const auto directory = zip.Subspan(directory_offset, directory_size);
+    if (directory.size() != directory_size) {
+        Fail("Corrupted ZIP central directory");
+    }
 
-                QByteArray decompressed;
-                decompressed.resize(uncompSize);
+    std::vector<Entry> files;
+    u64 offset = directory_offset;
+    for (u64 i = 0; i < entries; ++i) {
+        CentralHeader header;
+        if (!zip.ReadObject(offset, header) || header.signature != CentralHeaderSignature) {
+            Fail("Corrupted ZIP central directory");
+        }
+        const auto name = zip.Subspan(offset + sizeof(header), header.name_size);
+        const auto extra =
+            zip.Subspan(offset + sizeof(header) + header.name_size, header.extra_size);
+        if (name.size() != header.name_size || extra.size() != header.extra_size) {
+            Fail("Corrupted ZIP central directory");
+        }
+        offset += sizeof(header) + header.name_size + header.extra_size + header.comment_size;
 
-                size_t actualOut = 0;
-                libdeflate_result res = libdeflate_deflate_decompress(
-                    d, compressed.constData(), compressed.size(), decompressed.data(),
-                    decompressed.size(), &actualOut);
+        const std::string name_text(name.begin(), name.end());
+        if (name_text.ends_with('/') || name_text.ends_with('\\')) {
+            directories.push_back(SafeRelativePath(name_text));
+            continue;
+        }
+        if (header.flags & FlagEncrypted) {
+            Fail("Encrypted ZIP entries are not supported: " + name_text);
+        }
+        if (header.method != MethodStored && header.method != MethodDeflate) {
+            Fail("Unsupported compression method in ZIP entry: " + name_text);
+        }
 
-                if (res != LIBDEFLATE_SUCCESS)
-                    throw std::runtime_error("Decompression failed");
+        Entry entry{
+            .path = SafeRelativePath(name_text),
+            .data_offset = 0,
+            .compressed_size = header.compressed_size,
+            .size = header.size,
+            .crc32 = header.crc32,
+            .method = header.method,
+            .unix_mode = (header.version_made_by >> 8) == HostUnix
+                             ? static_cast<u32>(header.external_attributes) >> 16
+                             : 0,
+        };
+        u64 local_header_offset = header.local_header_offset;
+        ReadZip64Extra(extra, header, entry, local_header_offset);
 
-                QString outFilePath = QDir(outDir).filePath(QString::fromUtf8(filename));
+        // The local header only tells where the data starts, the sizes of the central
+        // directory hold for entries with a data descriptor too
+        LocalHeader local;
+        if (!zip.ReadObject(local_header_offset, local) ||
+            local.signature != LocalHeaderSignature) {
+            Fail("Corrupted ZIP local header: " + name_text);
+        }
+        entry.data_offset =
+            local_header_offset + sizeof(local) + local.name_size + local.extra_size;
+        if (zip.Subspan(entry.data_offset, entry.compressed_size).size() !=
+            entry.compressed_size) {
+            Fail("Truncated ZIP entry: " + name_text);
+        }
+        if (entry.method == MethodStored && entry.compressed_size != entry.size) {
+            Fail("Corrupted ZIP entry: " + name_text);
+        }
+        files.push_back(std::move(entry));
+    }
+    return files;
+}
 
-                QDir().mkpath(QFileInfo(outFilePath).path());
+bool IsLink(const Entry& entry) {
+#ifdef _WIN32
+    return false;
+#else
+    return (entry.unix_mode & 0170000) == 0120000;
+#endif
+}
 
-                QFile outFile(outFilePath);
-                outFile.open(QIODevice::WriteOnly);
-                outFile.write(decompressed);
-            } else {
-                // No Data Descriptor
-                QByteArray compressed = file.read(compSizeHeader);
+// Bounds the bytes the workers decompress at once. An entry larger than the limit waits until
+// no other one is held and then runs alone.
+class InflateBudget {
+public:
+    explicit InflateBudget(u64 limit) : m_limit{limit} {}
 
-                QByteArray decompressed;
-                decompressed.resize(uncompSizeHeader);
+    void Acquire(u64 bytes) {
+        std::unique_lock lock{m_mutex};
+        m_cv.wait(lock, [&] { return m_used == 0 || m_used + bytes <= m_limit; });
+        m_used += bytes;
+    }
+
+    void Release(u64 bytes) {
+        {
+            std::scoped_lock lock{m_mutex};
+            m_used -= bytes;
+        }
+        m_cv.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    const u64 m_limit;
+    u64 m_used = 0;
+};
+
+// The data of a stored entry is the mapping itself, a deflated one is decompressed into buffer
+std::span<const u8> ReadEntry(const Common::FS::MappedFile& zip, const Entry& entry,
+                              libdeflate_decompressor* decompressor, std::vector<u8>& buffer) {
+    const auto compressed = zip.Subspan(entry.data_offset, entry.compressed_size);
+    if (entry.method != MethodDeflate) {
+        return compressed;
+    }
+    buffer.resize(entry.size);
+    size_t actual = 0;
+    const libdeflate_result result =
+        libdeflate_deflate_decompress(decompressor, compressed.data(), compressed.size(),
+                                      buffer.data(), buffer.size(), &actual);
+    if (result != LIBDEFLATE_SUCCESS || actual != entry.size) {
+        Fail("Decompression failed: " + entry.path.string());
+    }
+    return buffer;
+}
 
-                size_t actualOut = 0;
-                libdeflate_result res = libdeflate_deflate_decompress(
-                    d, compressed.constData(), compressed.size(), decompressed.data(),
-                    decompressed.size(), &actualOut);
+void ExtractEntry(const Common::FS::MappedFile& zip, const Entry& entry,
+                  const std::filesystem::path& out_dir, libdeflate_decompressor* decompressor,
+                  std::vector<u8>& buffer) {
+    const std::span<const u8> data = ReadEntry(zip, entry, decompressor, buffer);
+    const std::filesystem::path path = out_dir / entry.path;
+    std::error_code ec;
 
-                if (res != LIBDEFLATE_SUCCESS)
-                    throw std::runtime_error("Decompression failed");
+    // Unlinked instead of truncated, an existing file may be a hard link shared with other trees
+    std::filesystem::remove(path, ec);
+    Common::FS::IOFile out(path, Common::FS::FileAccessMode::Write);
+    if (!out.IsOpen()) {
+        Fail("Cannot write file: " + path.string());
+    }
+    u32 crc = 0;
+    for (size_t offset = 0; offset < data.size(); offset += ChunkSize) {
+        const auto chunk = data.subspan(offset, std::min(ChunkSize, data.size() - offset));
+        crc = libdeflate_crc32(crc, chunk.data(), chunk.size());
+        if (out.WriteSpan(chunk) != chunk.size()) {
+            Fail("Cannot write file: " + path.string());
+        }
+    }
+    if (crc != entry.crc32) {
+        Fail("CRC mismatch in ZIP entry: " + entry.path.string());
+    }
 
-                QString outFilePath = QDir(outDir).filePath(QString::fromUtf8(filename));
+    if (entry.unix_mode & 0111) {
+        out.Close();
+        const auto mode = static_cast<std::filesystem::perms>(entry.unix_mode & 0777);
+        std::filesystem::permissions(path, mode, ec);
+    }
+}
+
+// Targets are checked like entry paths: relative and without "..", a link resolves inside the
+// directory of the link, also through other links of the archive
+void CreateLink(const Common::FS::MappedFile& zip, const Entry& entry,
+                const std::filesystem::path& out_dir, libdeflate_decompressor* decompressor,
+                std::vector<u8>& buffer) {
+    const auto data = ReadEntry(zip, entry, decompressor, buffer);
+    const std::filesystem::path target = SafeRelativePath(std::string(data.begin(), data.end()));
+    const std::filesystem::path path = out_dir / entry.path;
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::create_symlink(target, path, ec);
+    if (ec) {
+        Fail("Cannot create link: " + path.string());
+    }
+}
 
-                QDir().mkpath(QFileInfo(outFilePath).path());
+} // namespace
 
-                QFile outFile(outFilePath);
-                outFile.open(QIODevice::WriteOnly);
-                outFile.write(decompressed);
+void Extract(const QString& zipPath, const QString& outDir) {
+    const Common::FS::MappedFile zip(Common::FS::PathFromQString(zipPath));
+    if (!zip.IsOpen())
+        throw std::runtime_error("Cannot open ZIP file");
+
+    std::vector<std::filesystem::path> directories;
+    std::vector<Entry> files = ReadDirectory(zip, directories);
+
+    // Directories first, so the workers only create files
+    const std::filesystem::path out_dir = Common::FS::PathFromQString(outDir);
+    std::error_code ec;
+    std::filesystem::create_directories(out_dir, ec);
+    for (const Entry& entry : files) {
+        directories.push_back(entry.path.parent_path());
+    }
+    std::ranges::sort(directories);
+    const auto [first, last] = std::ranges::unique(directories);
+    directories.erase(first, last);
+    for (const auto& directory : directories) {
+        std::filesystem::create_directories(out_dir / directory, ec);
+    }
+
+    // Links last, after every file is written: a file is never written through a link, and a
+    // link whose path is a directory of the archive fails instead of replacing it
+    const auto links = std::ranges::stable_partition(files, std::not_fn(IsLink));
+    std::vector<Entry> link_entries(links.begin(), links.end());
+    files.erase(links.begin(), links.end());
+
+    // Largest entries first, so a big one does not start last and run alone
+    std::ranges::sort(files, std::greater{}, &Entry::size);
+    const size_t num_workers = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                                  std::max<size_t>(files.size(), 1));
+
+    std::atomic<size_t> next{0};
+    InflateBudget budget{MaxInflateBytes};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+    const auto work = [&] {
+        libdeflate_decompressor* decompressor = libdeflate_alloc_decompressor();
+        std::vector<u8> buffer;
+        try {
+            if (!decompressor)
+                throw std::runtime_error("libdeflate alloc failed");
+            for (size_t i = next++; i < files.size(); i = next++) {
+                const Entry& entry = files[i];
+                const u64 bytes = entry.method == MethodDeflate ? entry.size : 0;
+                budget.Acquire(bytes);
+                try {
+                    ExtractEntry(zip, entry, out_dir, decompressor, buffer);
+                } catch (...) {
+                    budget.Release(bytes);
+                    throw;
+                }
+                // Only a small buffer is kept for the next entries, a large one is freed
+                // before its bytes are given back
+                if (buffer.capacity() > KeptBufferSize) {
+                    buffer = {};
+                }
+                budget.Release(bytes);
             }
+        } catch (...) {
+            // Stops the other workers after their current entry
+            next = files.size();
+            std::scoped_lock lock{error_mutex};
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        if (decompressor)
+            libdeflate_free_decompressor(decompressor);
+    };
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(num_workers - 1);
+        for (size_t i = 1; i < num_workers; ++i) {
+            workers.emplace_back(work);
         }
-    } catch (...) {
-        libdeflate_free_decompressor(d);
-        throw;
+        work();
+    }
+    if (error) {
+        std::rethrow_exception(error);
     }
 
-    libdeflate_free_decompressor(d);
+    // Links are few and small, created on the calling thread
+    if (!link_entries.empty()) {
+        const std::unique_ptr<libdeflate_decompressor, decltype(&libdeflate_free_decompressor)>
+            decompressor{libdeflate_alloc_decompressor(), libdeflate_free_decompressor};
+        if (!decompressor)
+            throw std::runtime_error("libdeflate alloc failed");
+        std::vector<u8> buffer;
+        for (const Entry& entry : link_entries) {
+            CreateLink(zip, entry, out_dir, decompressor.get(), buffer);
+        }
+    }
 }
-} // namespace Zip
\ No newline at end of file
+
+} // namespace Zip
@@ -6,5 +6,7 @@
 #include <QString>
 
 namespace Zip {
+/// Extracts the stored and deflated entries of a ZIP or Zip64 archive, in parallel, checking
+/// their CRC32. Throws std::runtime_error on a corrupted archive or an entry outside of outDir.
 void Extract(const QString& zipPath, const QString& outDir);
 }
\ No newline at end of file
@@ -8,7 +8,7 @@
 #include <vector>
 #include "npbind.h"
 
-bool NPBindFile::Load(const std::string& path) {
+bool NPBindFile::Load(const std::filesystem::path& path) {
     Clear(); // Clear any existing data
 
     std::ifstream f(path, std::ios::binary | std::ios::ate);
@@ -2,6 +2,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <optional>
 #include <libdeflate.h>
 #include "common/io_file.h"
 #include "common/logging/formatter.h"
@@ -59,24 +61,12 @@ bool PKG::Open(const std::filesystem::path& filepath, std::string& failreason) {
     file.Seek(0x47); // skip first 7 characters of content_id
     file.Read(pkgTitleID);
 
-    u32 offset = pkgheader.pkg_table_entry_offset;
-    u32 n_files = pkgheader.pkg_table_entry_count;
-
-    if (!file.Seek(offset)) {
-        failreason = "Failed to seek to PKG table entry offset";
+    if (!ReadEntryTable(file, failreason)) {
         return false;
     }
+    pkgpath = filepath;
 
-    for (int i = 0; i < n_files; i++) {
-        PKGEntry entry{};
-        file.Read(entry.id);
-        file.Read(entry.filename_offset);
-        file.Read(entry.flags1);
-        file.Read(entry.flags2);
-        file.Read(entry.offset);
-        file.Read(entry.size);
-        file.Seek(8, Common::FS::SeekOrigin::CurrentPosition);
-
+    for (const auto& entry : entries) {
         // Try to figure out the name
         const auto name = GetEntryNameByType(entry.id);
         if (name == "param.sfo") {
@@ -87,6 +77,7 @@ bool PKG::Open(const std::filesystem::path& filepath, std::string& failreason) {
             }
             sfo.resize(entry.size);
             file.ReadRaw<u8>(sfo.data(), entry.size);
+            break;
         }
     }
     file.Close();
@@ -94,10 +85,60 @@ bool PKG::Open(const std::filesystem::path& filepath, std::string& failreason) {
     return true;
 }
 
+bool PKG::ReadEntryTable(const Common::FS::IOFile& file, std::string& failreason) {
+    entries.clear();
+
+    const u64 offset = pkgheader.pkg_table_entry_offset;
+    const u64 n_files = pkgheader.pkg_table_entry_count;
+    if (offset + n_files * sizeof(PKGEntry) > pkgSize) {
+        failreason = "PKG table entries are out of bounds";
+        return false;
+    }
+
+    if (!file.Seek(offset)) {
+        failreason = "Failed to seek to PKG table entry offset";
+        return false;
+    }
+
+    // The whole table is contiguous, read it at once instead of field by field.
+    entries.resize(n_files);
+    if (file.ReadRaw<PKGEntry>(entries.data(), entries.size()) != entries.size()) {
+        entries.clear();
+        failreason = "Failed to read PKG table entries";
+        return false;
+    }
+
+    // The entry is hashed as-is for the NP and image keys, keep the padding zeroed
+    // like the per-field reader did.
+    for (auto& entry : entries) {
+        entry.padding = 0;
+    }
+    return true;
+}
+
+bool PKG::ReadEntry(u32 id, std::vector<u8>& data) const {
+    const auto it = std::find_if(entries.begin(), entries.end(),
+                                 [id](const PKGEntry& entry) { return entry.id == id; });
+    if (it == entries.end() || (static_cast<u32>(it->flags1) & PKG_ENTRY_FLAG_ENCRYPTED) != 0) {
+        return false;
+    }
+    if (static_cast<u64>(it->offset) + it->size > pkgSize) {
+        return false;
+    }
+
+    Common::FS::IOFile file(pkgpath, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen() || !file.Seek(it->offset)) {
+        return false;
+    }
+    data.resize(it->size);
+    return file.ReadRaw<u8>(data.data(), data.size()) == data.size();
+}
+
 bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::path& extract,
                   std::string& failreason) {
     extract_path = extract;
     pkgpath = filepath;
+    stats.Reset();
     Common::FS::IOFile file(filepath, Common::FS::FileAccessMode::Read);
     if (!file.IsOpen()) {
         return false;
@@ -117,32 +158,17 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
         return false;
     }
 
-    u32 offset = pkgheader.pkg_table_entry_offset;
-    u32 n_files = pkgheader.pkg_table_entry_count;
-
     std::array<u8, 64> concatenated_ivkey_dk3;
     std::array<u8, 32> seed_digest;
     std::array<std::array<u8, 32>, 7> digest1;
     std::array<std::array<u8, 256>, 7> key1;
     std::array<u8, 256> imgkeydata;
 
-    if (!file.Seek(offset)) {
-        failreason = "Failed to seek to PKG table entry offset";
+    if (!ReadEntryTable(file, failreason)) {
         return false;
     }
 
-    for (int i = 0; i < n_files; i++) {
-        PKGEntry entry{};
-        file.Read(entry.id);
-        file.Read(entry.filename_offset);
-        file.Read(entry.flags1);
-        file.Read(entry.flags2);
-        file.Read(entry.offset);
-        file.Read(entry.size);
-        file.Seek(8, Common::FS::SeekOrigin::CurrentPosition);
-
-        auto currentPos = file.Tell();
-
+    for (const auto& entry : entries) {
         // Try to figure out the name
         const auto name = GetEntryNameByType(entry.id);
         const auto filepath = extract_path / "sce_sys" / name;
@@ -162,14 +188,12 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
             file.ReadRaw<u8>(data.data(), entry.size);
             out.WriteRaw<u8>(data.data(), entry.size);
             out.Close();
-
-            file.Seek(currentPos);
             continue;
         }
 
-        if (entry.id == 0x1) {         // DIGESTS, seek;
-                                       // file.Seek(entry.offset, fsSeekSet);
-        } else if (entry.id == 0x10) { // ENTRY_KEYS, seek;
+        if (entry.id == 0x1) {                          // DIGESTS, seek;
+                                                        // file.Seek(entry.offset, fsSeekSet);
+        } else if (entry.id == 0x10 && !ekpfs_preset) { // ENTRY_KEYS, seek;
             file.Seek(entry.offset);
             file.Read(seed_digest);
 
@@ -182,7 +206,7 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
             }
 
             PKG::crypto.RSA2048Decrypt(dk3_, key1[3], true); // decrypt DK3
-        } else if (entry.id == 0x20) {                       // IMAGE_KEY, seek; IV_KEY
+        } else if (entry.id == 0x20 && !ekpfs_preset) {      // IMAGE_KEY, seek; IV_KEY
             file.Seek(entry.offset);
             file.Read(imgkeydata);
 
@@ -237,8 +261,6 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
             out.Write(decNp);
             out.Close();
         }
-
-        file.Seek(currentPos);
     }
 
     // Read the seed
@@ -405,9 +427,26 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
             }
         }
     }
+
+    u64 total_bytes = 0;
+    for (const auto& entry : fsTable) {
+        if (entry.type == PFS_FILE && entry.inode < iNodeBuf.size()) {
+            total_bytes += iNodeBuf[entry.inode].Size;
+        }
+    }
+    stats.SetTotalBytes(total_bytes);
     return true;
 }
 
+bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::path& extract,
+                  std::span<const u8, 32> ekpfs, std::string& failreason) {
+    std::copy(ekpfs.begin(), ekpfs.end(), ekpfsKey.begin());
+    ekpfs_preset = true;
+    const bool result = Extract(filepath, extract, failreason);
+    ekpfs_preset = false;
+    return result;
+}
+
 void PKG::ExtractFiles(const int index) {
     int inode_number = fsTable[index].inode;
     int inode_type = fsTable[index].type;
@@ -436,6 +475,14 @@ void PKG::ExtractFiles(const int index) {
         pfsc.resize(pfsc_buf_size);
         pfs_decrypted.resize(pfsc_buf_size);
 
+        using Stage = PKGInstallStats::Stage;
+        auto stage_start = PKGInstallStats::Clock::now();
+        const auto end_stage = [&](Stage stage, u64 nbytes) {
+            const auto now = PKGInstallStats::Clock::now();
+            stats.Add(stage, nbytes, now - stage_start);
+            stage_start = now;
+        };
+
         for (int j = 0; j < nblocks; j++) {
             u64 sectorOffset =
                 sectorMap[sector_loc + j]; // offset into PFSC_image and not pfs_image.
@@ -448,10 +495,13 @@ void PKG::ExtractFiles(const int index) {
             int sectorOffsetMask = (sectorOffset + pfsc_offset) & 0xFFFFF000;
             int previousData = (sectorOffset + pfsc_offset) - sectorOffsetMask;
 
+            stage_start = PKGInstallStats::Clock::now();
             pkgFile.Seek(fileOffset - previousData);
             pkgFile.Read(pfsc);
+            end_stage(Stage::Read, pfsc.size());
 
             PKG::crypto.decryptPFS(dataKey, tweakKey, pfsc, pfs_decrypted, currentSector1);
+            end_stage(Stage::Decrypt, pfsc.size());
 
             compressedData.resize(sectorSize);
             std::memcpy(compressedData.data(), pfs_decrypted.data() + previousData, sectorSize);
@@ -460,15 +510,18 @@ void PKG::ExtractFiles(const int index) {
                 std::memcpy(decompressedData.data(), compressedData.data(), 0x10000);
             else if (sectorSize < 0x10000) // Compressed data
                 DecompressPFSC(compressedData, decompressedData);
+            end_stage(Stage::Inflate, decompressedData.size());
 
             size_decompressed += 0x10000;
 
             if (j < nblocks - 1) {
                 inflated.WriteRaw<u8>(decompressedData.data(), decompressedData.size());
+                end_stage(Stage::Write, decompressedData.size());
             } else {
                 // This is to remove the zeros at the end of the file.
                 const u32 write_size = decompressedData.size() - (size_decompressed - bsize);
                 inflated.WriteRaw<u8>(decompressedData.data(), write_size);
+                end_stage(Stage::Write, write_size);
             }
         }
         pkgFile.Close();
@@ -10,7 +10,9 @@
 #include <vector>
 #include "common/crypto.h"
 #include "common/endian.h"
+#include "common/io_file.h"
 #include "pfs.h"
+#include "pkg_stats.h"
 #include "trp.h"
 
 struct PKGHeader {
@@ -98,15 +100,24 @@ struct PKGEntry {
 };
 static_assert(sizeof(PKGEntry) == 32);
 
+constexpr u32 PKG_ENTRY_FLAG_ENCRYPTED = 0x80000000; // flags1 bit set for encrypted entries
+
 class PKG {
 public:
     PKG();
     ~PKG();
 
     bool Open(const std::filesystem::path& filepath, std::string& failreason);
+    // Reads the raw data of an unencrypted entry (param.sfo, icon0.png, pic1.png...) straight
+    // from the PKG opened with Open(), without touching the PFS image.
+    bool ReadEntry(u32 id, std::vector<u8>& data) const;
     void ExtractFiles(const int index);
     bool Extract(const std::filesystem::path& filepath, const std::filesystem::path& extract,
                  std::string& failreason);
+    // Same as above for content whose EKPFS is known up front, the RSA wrapped key entries are
+    // not needed. Used by the extraction benchmark with its generated test packages.
+    bool Extract(const std::filesystem::path& filepath, const std::filesystem::path& extract,
+                 std::span<const u8, 32> ekpfs, std::string& failreason);
 
     std::vector<u8> sfo;
 
@@ -130,6 +141,15 @@ public:
         return pkgheader;
     }
 
+    const std::vector<PKGEntry>& GetEntries() const {
+        return entries;
+    }
+
+    // Live counters of the running extraction, safe to sample from other threads.
+    const PKGInstallStats& GetStats() const {
+        return stats;
+    }
+
     static bool isFlagSet(u32_be variable, PKGContentFlag flag) {
         return (variable) & static_cast<u32>(flag);
     }
@@ -147,13 +167,17 @@ public:
          {PKGContentFlag::CUMULATIVE_PATCH, "CUMULATIVE_PATCH"}}};
 
 private:
+    bool ReadEntryTable(const Common::FS::IOFile& file, std::string& failreason);
+
     Crypto crypto;
     TRP trp;
+    PKGInstallStats stats;
     u64 pkgSize = 0;
     char pkgTitleID[9];
     PKGHeader pkgheader;
     std::string pkgFlags;
 
+    std::vector<PKGEntry> entries;
     std::unordered_map<int, std::filesystem::path> extractPaths;
     std::vector<pfs_fs_table> fsTable;
     std::vector<Inode> iNodeBuf;
@@ -164,6 +188,7 @@ private:
     std::array<u8, 32> ivKey;
     std::array<u8, 256> imgKey;
     std::array<u8, 32> ekpfsKey;
+    bool ekpfs_preset = false;
     std::array<u8, 16> dataKey;
     std::array<u8, 16> tweakKey;
     std::vector<u8> decNp;
@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <fmt/format.h>
+#include "core/file_format/pkg_stats.h"
+
+namespace {
+constexpr double MiB = 1024.0 * 1024.0;
+
+double Seconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double>(time).count();
+}
+} // namespace
+
+void PKGInstallStats::Reset() {
+    total_bytes.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < NumStages; ++i) {
+        bytes[i].store(0, std::memory_order_relaxed);
+        busy_ns[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+const char* PKGInstallStats::GetStageName(Stage stage) {
+    switch (stage) {
+    case Stage::Read:
+        return "read";
+    case Stage::Decrypt:
+        return "decrypt";
+    case Stage::Inflate:
+        return "inflate";
+    case Stage::Write:
+        return "write";
+    default:
+        return "unknown";
+    }
+}
+
+std::string PKGInstallStats::Report(Clock::duration wall) const {
+    const double wall_s =
+        std::max(Seconds(std::chrono::duration_cast<std::chrono::nanoseconds>(wall)), 1e-9);
+    const u64 written = GetBytes(Stage::Write);
+
+    std::string report = fmt::format("{:.1f} MiB in {:.2f}s ({:.1f} MiB/s)", written / MiB,
+                                     wall_s, written / MiB / wall_s);
+
+    // Busy times are summed over all workers, so a stage can exceed the wall time.
+    Stage bottleneck = Stage::Read;
+    for (size_t i = 0; i < NumStages; ++i) {
+        const auto stage = static_cast<Stage>(i);
+        const double busy_s = Seconds(GetBusyTime(stage));
+        const double stage_mib = GetBytes(stage) / MiB;
+        report += fmt::format(" | {} {:.1f} MiB, {:.2f}s busy", GetStageName(stage), stage_mib,
+                              busy_s);
+        if (busy_s > 0.0) {
+            report += fmt::format(" ({:.1f} MiB/s)", stage_mib / busy_s);
+        }
+        if (GetBusyTime(stage) > GetBusyTime(bottleneck)) {
+            bottleneck = stage;
+        }
+    }
+    report += fmt::format(" | bound by {}", GetStageName(bottleneck));
+    return report;
+}
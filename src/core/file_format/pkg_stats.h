@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "common/types.h"
+
+/**
+ * Byte counters and per-stage busy time of a PKG extraction. The counters are bumped
+ * concurrently by the ExtractFiles workers and can be sampled from any thread while the
+ * extraction is running.
+ */
+class PKGInstallStats {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage : u32 {
+        Read,    ///< Encrypted PFS image read from the PKG
+        Decrypt, ///< AES-XTS decryption of the PFS sectors
+        Inflate, ///< PFSC block decompression
+        Write,   ///< Extracted file data written to disk
+        Count,
+    };
+
+    void Reset();
+
+    void SetTotalBytes(u64 total) {
+        total_bytes.store(total, std::memory_order_relaxed);
+    }
+
+    u64 GetTotalBytes() const {
+        return total_bytes.load(std::memory_order_relaxed);
+    }
+
+    void Add(Stage stage, u64 nbytes, Clock::duration busy) {
+        const auto index = static_cast<size_t>(stage);
+        bytes[index].fetch_add(nbytes, std::memory_order_relaxed);
+        busy_ns[index].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count(),
+                                 std::memory_order_relaxed);
+    }
+
+    u64 GetBytes(Stage stage) const {
+        return bytes[static_cast<size_t>(stage)].load(std::memory_order_relaxed);
+    }
+
+    std::chrono::nanoseconds GetBusyTime(Stage stage) const {
+        return std::chrono::nanoseconds{
+            busy_ns[static_cast<size_t>(stage)].load(std::memory_order_relaxed)};
+    }
+
+    /// Human readable summary: wall time, throughput and where the time went.
+    std::string Report(Clock::duration wall) const;
+
+    static const char* GetStageName(Stage stage);
+
+private:
+    static constexpr size_t NumStages = static_cast<size_t>(Stage::Count);
+
+    std::atomic<u64> total_bytes{0};
+    std::array<std::atomic<u64>, NumStages> bytes{};
+    std::array<std::atomic<u64>, NumStages> busy_ns{};
+};
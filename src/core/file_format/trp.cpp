@@ -1,28 +1,34 @@
 // SPDX-FileCopyrightText: Copyright 2024-2026 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "common/key_manager.h"
 #include "common/logging/log.h"
+#include "common/mapped_file.h"
 #include "common/path_util.h"
+#include "npbind.h"
 #include "trp.h"
 
+namespace {
+constexpr u32 TRP_MAGIC = 0xDCA24D00;
+constexpr auto DigestFileName = "trp.digest";
+
+// What the last extraction of a trophy set was made from, see ExtractFile.
+struct TrpDigest {
+    unsigned char digest[20];
+    std::array<u8, 16> np_comm_id;
+
+    bool operator==(const TrpDigest&) const = default;
+};
+} // namespace
+
 TRP::TRP() = default;
 TRP::~TRP() = default;
 
-void TRP::GetNPcommID(const std::filesystem::path& trophyPath, int index) {
-    std::filesystem::path trpPath = trophyPath / "sce_sys/npbind.dat";
-    Common::FS::IOFile npbindFile(trpPath, Common::FS::FileAccessMode::Read);
-    if (!npbindFile.IsOpen()) {
-        LOG_CRITICAL(Common_Filesystem, "Failed to open npbind.dat file");
-        return;
-    }
-    if (!npbindFile.Seek(0x84 + (index * 0x180))) {
-        LOG_CRITICAL(Common_Filesystem, "Failed to seek to NPbind offset");
-        return;
-    }
-    npbindFile.ReadRaw<u8>(np_comm_id.data(), 12);
-    std::fill(np_comm_id.begin() + 12, np_comm_id.end(), 0); // fill with 0, we need 16 bytes.
-}
-
 static void removePadding(std::vector<u8>& vec) {
     for (auto it = vec.rbegin(); it != vec.rend(); ++it) {
         if (*it == '>') {
@@ -33,105 +39,163 @@ static void removePadding(std::vector<u8>& vec) {
     }
 }
 
-static void hexToBytes(const char* hex, unsigned char* dst) {
-    for (size_t i = 0; hex[i] != 0; i++) {
-        const unsigned char value = (hex[i] < 0x3A) ? (hex[i] - 0x30) : (hex[i] - 0x37);
-        dst[i / 2] |= ((i % 2) == 0) ? (value << 4) : (value);
+bool TRP::Extract(const std::filesystem::path& trophyPath, const std::string titleId) {
+    NPBindFile npbind;
+    if (!npbind.Load(trophyPath / "sce_sys" / "npbind.dat")) {
+        LOG_WARNING(Common_Filesystem, "Failed to load npbind.dat, trophy XML is not decrypted");
     }
+    return Extract(trophyPath, npbind,
+                   Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / titleId /
+                       "TrophyFiles");
 }
 
-bool TRP::Extract(const std::filesystem::path& trophyPath, const std::string titleId) {
-    /* std::filesystem::path gameSysDir = trophyPath / "sce_sys/trophy/";
-    if (!std::filesystem::exists(gameSysDir)) {
+bool TRP::Extract(const std::filesystem::path& trophyPath, const NPBindFile& npbind,
+                  const std::filesystem::path& outputPath) {
+    skipped = 0;
+
+    std::filesystem::path gameSysDir = trophyPath / "sce_sys/trophy/";
+    std::error_code ec;
+    if (!std::filesystem::exists(gameSysDir, ec)) {
         LOG_CRITICAL(Common_Filesystem, "Game sce_sys directory doesn't exist");
         return false;
     }
 
-    const auto user_key_str = Config::getTrophyKey();
-    if (user_key_str.size() != 32) {
+    const auto& user_key = KeyManager::GetInstance()->GetAllKeys().TrophyKeySet.ReleaseTrophyKey;
+    if (user_key.size() != trophyKey.size()) {
         LOG_CRITICAL(Common_Filesystem, "Trophy decryption key is not specified");
         return false;
     }
+    std::copy(user_key.begin(), user_key.end(), trophyKey.begin());
 
-    std::array<CryptoPP::byte, 16> user_key{};
-    hexToBytes(user_key_str.c_str(), user_key.data());
-
-    for (int index = 0; const auto& it : std::filesystem::directory_iterator(gameSysDir)) {
+    // trophy00.trp belongs to the first npbind.dat entry, trophy01.trp to the second and so on.
+    std::vector<std::filesystem::path> trpFiles;
+    for (const auto& it : std::filesystem::directory_iterator(gameSysDir, ec)) {
         if (it.is_regular_file()) {
-            GetNPcommID(trophyPath, index);
+            trpFiles.push_back(it.path());
+        }
+    }
+    std::sort(trpFiles.begin(), trpFiles.end());
+
+    bool success = true;
+    for (size_t index = 0; index < trpFiles.size(); ++index) {
+        std::array<u8, 16> np_comm_id{}; // 12 bytes, zero padded to an AES block
+        if (npbind.IsValid() && index < npbind.BodyCount()) {
+            const auto& data = npbind.GetBody(index).npcommid.data;
+            std::copy_n(data.begin(), std::min<size_t>(data.size(), 12), np_comm_id.begin());
+        }
+        success &= ExtractFile(trpFiles[index], np_comm_id, outputPath);
+    }
+    return success;
+}
+
+bool TRP::ExtractFile(const std::filesystem::path& trpPath, std::span<const u8, 16> npCommId,
+                      const std::filesystem::path& outputPath) {
+    Common::FS::MappedFile file(trpPath);
+    if (!file.IsOpen()) {
+        LOG_CRITICAL(Common_Filesystem, "Unable to open trophy file for read");
+        return false;
+    }
 
-            Common::FS::IOFile file(it.path(), Common::FS::FileAccessMode::Read);
-            if (!file.IsOpen()) {
-                LOG_CRITICAL(Common_Filesystem, "Unable to open trophy file for read");
-                return false;
+    TrpHeader header;
+    if (!file.ReadObject(0, header) || header.magic != TRP_MAGIC) {
+        LOG_CRITICAL(Common_Filesystem, "Wrong trophy magic number");
+        return false;
+    }
+
+    const std::filesystem::path trpFilesPath = outputPath / trpPath.stem();
+    const std::filesystem::path digestPath = trpFilesPath / DigestFileName;
+
+    // The TRP digest covers the whole file. Together with the NP comm ID it identifies the
+    // extracted output, so unchanged trophy sets are not decrypted again.
+    TrpDigest digest;
+    std::memcpy(digest.digest, header.digest, sizeof(digest.digest));
+    std::copy(npCommId.begin(), npCommId.end(), digest.np_comm_id.begin());
+    {
+        TrpDigest cached;
+        Common::FS::IOFile cache(digestPath, Common::FS::FileAccessMode::Read);
+        if (cache.IsOpen() && cache.ReadObject(cached) && cached == digest) {
+            ++skipped;
+            return true;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(digestPath, ec);
+    std::filesystem::create_directories(trpFilesPath / "Icons", ec);
+    std::filesystem::create_directories(trpFilesPath / "Xml", ec);
+
+    const u32 entry_num = header.entry_num;
+    const u64 entry_size = header.entry_size;
+    const bool decrypt_xml = npCommId[0] == 'N' && npCommId[1] == 'P';
+
+    std::atomic<u32> next_entry{0};
+    std::atomic<bool> failed{false};
+    const auto worker = [&] {
+        std::vector<u8> xml; // Reused by every ESFM entry of this worker
+        std::array<u8, 16> key = trophyKey;
+        std::array<u8, 16> np_comm_id;
+        std::copy(npCommId.begin(), npCommId.end(), np_comm_id.begin());
+
+        for (u32 i = next_entry++; i < entry_num && !failed; i = next_entry++) {
+            TrpEntry entry;
+            if (!file.ReadObject(sizeof(TrpHeader) + i * entry_size, entry)) {
+                LOG_CRITICAL(Common_Filesystem, "Failed to read TRP entry {}", i);
+                failed = true;
+                break;
+            }
+            const std::string_view name(entry.entry_name,
+                                        strnlen(entry.entry_name, sizeof(entry.entry_name)));
+            const auto data = file.Subspan(entry.entry_pos, entry.entry_len);
+            if (data.size() != entry.entry_len) {
+                LOG_CRITICAL(Common_Filesystem, "TRP entry {} is outside of the file", name);
+                failed = true;
+                break;
             }
 
-            TrpHeader header;
-            file.Read(header);
-            if (header.magic != 0xDCA24D00) {
-                LOG_CRITICAL(Common_Filesystem, "Wrong trophy magic number");
-                return false;
+            if (entry.flag == 0 && name.find("TROP") != std::string::npos) { // PNG
+                // Written straight from the mapping in a single write
+                Common::FS::IOFile::WriteBytes(trpFilesPath / "Icons" / name, data);
             }
+            if (entry.flag == 3 && decrypt_xml && data.size() > iv_len) { // ESFM, encrypted.
+                // The first 16 bytes of every entry are the IV, the XML file is left without.
+                std::array<u8, 16> esfmIv;
+                std::copy_n(data.begin(), iv_len, esfmIv.begin());
+                xml.assign(data.begin() + iv_len, data.end());
+                crypto.decryptEFSM(key, np_comm_id, esfmIv, xml, xml); // decrypt in place
+                removePadding(xml);
 
-            s64 seekPos = sizeof(TrpHeader);
-            std::filesystem::path trpFilesPath(
-                Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / titleId /
-                "TrophyFiles" / it.path().stem());
-            std::filesystem::create_directories(trpFilesPath / "Icons");
-            std::filesystem::create_directory(trpFilesPath / "Xml");
-
-            for (int i = 0; i < header.entry_num; i++) {
-                if (!file.Seek(seekPos)) {
-                    LOG_CRITICAL(Common_Filesystem, "Failed to seek to TRP entry offset");
-                    return false;
-                }
-                seekPos += (s64)header.entry_size;
-                TrpEntry entry;
-                file.Read(entry);
-                std::string_view name(entry.entry_name);
-                if (entry.flag == 0 && name.find("TROP") != std::string::npos) { // PNG
-                    if (!file.Seek(entry.entry_pos)) {
-                        LOG_CRITICAL(Common_Filesystem, "Failed to seek to TRP entry offset");
-                        return false;
-                    }
-                    std::vector<u8> icon(entry.entry_len);
-                    file.Read(icon);
-                    Common::FS::IOFile::WriteBytes(trpFilesPath / "Icons" / name, icon);
-                }
-                if (entry.flag == 3 && np_comm_id[0] == 'N' &&
-                    np_comm_id[1] == 'P') { // ESFM, encrypted.
-                    if (!file.Seek(entry.entry_pos)) {
-                        LOG_CRITICAL(Common_Filesystem, "Failed to seek to TRP entry offset");
-                        return false;
-                    }
-                    file.Read(esfmIv); // get iv key.
-                    // Skip the first 16 bytes which are the iv key on every entry as we want a
-                    // clean xml file.
-                    std::vector<u8> ESFM(entry.entry_len - iv_len);
-                    std::vector<u8> XML(entry.entry_len - iv_len);
-                    if (!file.Seek(entry.entry_pos + iv_len)) {
-                        LOG_CRITICAL(Common_Filesystem, "Failed to seek to TRP entry + iv offset");
-                        return false;
-                    }
-                    file.Read(ESFM);
-                    crypto.decryptEFSM(user_key, np_comm_id, esfmIv, ESFM, XML); // decrypt
-                    removePadding(XML);
-                    std::string xml_name = entry.entry_name;
-                    size_t pos = xml_name.find("ESFM");
-                    if (pos != std::string::npos)
-                        xml_name.replace(pos, xml_name.length(), "XML");
-                    std::filesystem::path path = trpFilesPath / "Xml" / xml_name;
-                    size_t written = Common::FS::IOFile::WriteBytes(path, XML);
-                    if (written != XML.size()) {
-                        LOG_CRITICAL(
-                            Common_Filesystem,
-                            "Trophy XML {} write failed, wanted to write {} bytes, wrote {}",
-                            fmt::UTF(path.u8string()), XML.size(), written);
-                    }
+                std::string xml_name{name};
+                size_t pos = xml_name.find("ESFM");
+                if (pos != std::string::npos)
+                    xml_name.replace(pos, xml_name.length(), "XML");
+                std::filesystem::path path = trpFilesPath / "Xml" / xml_name;
+                size_t written = Common::FS::IOFile::WriteBytes(path, xml);
+                if (written != xml.size()) {
+                    LOG_CRITICAL(Common_Filesystem,
+                                 "Trophy XML {} write failed, wanted to write {} bytes, wrote {}",
+                                 fmt::UTF(path.u8string()), xml.size(), written);
+                    failed = true;
                 }
             }
         }
-        index++;
-    }*/
+    };
+
+    // One worker per hardware thread, but no more than there are entries.
+    const u32 num_workers =
+        std::clamp(std::thread::hardware_concurrency(), 1u, std::max(entry_num, 1u));
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(num_workers - 1);
+        for (u32 t = 1; t < num_workers; ++t) {
+            workers.emplace_back(worker);
+        }
+        worker();
+    }
+
+    if (failed) {
+        return false;
+    }
+    Common::FS::IOFile cache(digestPath, Common::FS::FileAccessMode::Write);
+    cache.WriteObject(digest);
     return true;
 }
@@ -3,12 +3,18 @@
 
 #pragma once
 
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string>
 #include <vector>
 #include "common/crypto.h"
 #include "common/endian.h"
 #include "common/io_file.h"
 #include "common/types.h"
 
+class NPBindFile;
+
 struct TrpHeader {
     u32_be magic; // (0xDCA24D00)
     u32_be version;
@@ -33,14 +39,29 @@ class TRP {
 public:
     TRP();
     ~TRP();
+
+    /**
+     * Extracts the trophy icons and decrypted XML of every trophy set in
+     * <trophyPath>/sce_sys/trophy to <MetaDataDir>/<titleId>/TrophyFiles/<set>/{Icons,Xml}.
+     * Sets that were extracted before with the same TRP digest are skipped.
+     */
     bool Extract(const std::filesystem::path& trophyPath, const std::string titleId);
-    void GetNPcommID(const std::filesystem::path& trophyPath, int index);
+
+    /// Same as above with a npbind.dat the caller has already loaded.
+    bool Extract(const std::filesystem::path& trophyPath, const NPBindFile& npbind,
+                 const std::filesystem::path& outputPath);
+
+    /// Trophy sets skipped by the last Extract because they were up to date.
+    u32 GetSkippedCount() const {
+        return skipped;
+    }
 
 private:
+    bool ExtractFile(const std::filesystem::path& trpPath, std::span<const u8, 16> npCommId,
+                     const std::filesystem::path& outputPath);
+
     Crypto crypto;
-    std::vector<u8> NPcommID = std::vector<u8>(12);
-    std::array<u8, 16> np_comm_id{};
-    std::array<u8, 16> esfmIv{};
-    std::filesystem::path trpFilesPath;
+    std::array<u8, 16> trophyKey{};
+    u32 skipped = 0;
     static constexpr int iv_len = 16;
-};
\ No newline at end of file
+};
@@ -1,14 +1,22 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <cstring>
+#include <utility>
 #include <QDir>
 #include <QMessageBox>
 #include <QProcessEnvironment>
 #include <QRegularExpression>
 
 #include "common/logging/log.h"
+#include "common/path_util.h"
 #include "ipc_client.h"
 
+// Sessions whose output is kept in the sessions folder of the log directory
+constexpr size_t MaxArchivedSessions = 20;
+// Interval of the telemetry samples requested from the emulator
+constexpr int TelemetryIntervalMs = 250;
+
 IpcClient::IpcClient(QObject* parent) : QObject(parent) {}
 
 void IpcClient::startEmulator(const QFileInfo& exe, const QStringList& args, const QString& workDir,
@@ -19,6 +27,33 @@ void IpcClient::startEmulator(const QFileInfo& exe, const QStringList& args, con
         process = nullptr;
     }
     process = new QProcess(this);
+    buffer.clear();
+    stdoutBuffer.clear();
+    parked = false;
+    handshakeDone = false;
+    parkedLog.clear();
+    for (auto& [capability, supported] : supportedCapabilities) {
+        supported = false;
+    }
+    telemetry.Clear();
+    telemetrySummary = {};
+
+    // Named after the game folder, the argument after --game is its eboot.bin
+    QString sessionName = "emulator";
+    const qsizetype gameArg = args.indexOf("--game");
+    if (gameArg != -1 && gameArg + 1 < args.size()) {
+        const QFileInfo game(args[gameArg + 1]);
+        sessionName = game.isDir() ? game.fileName() : game.dir().dirName();
+    }
+    sessionLogPath = Common::SessionLogWriter::CreateSessionPath(
+        Common::FS::GetUserPath(Common::FS::PathType::LogDir) / "sessions",
+        sessionName.toStdString(), MaxArchivedSessions);
+    sessionLog = std::make_unique<Common::SessionLogWriter>(sessionLogPath);
+    if (!sessionLog->IsOpen()) {
+        LOG_WARNING(IPC, "Could not create the session log {}",
+                    Common::FS::PathToUTF8String(sessionLogPath));
+        sessionLog.reset();
+    }
 
     connect(process, &QProcess::readyReadStandardError, this, [this] { onStderr(); });
     connect(process, &QProcess::readyReadStandardOutput, this, [this] { onStdout(); });
@@ -36,6 +71,39 @@ void IpcClient::startEmulator(const QFileInfo& exe, const QStringList& args, con
     process->start(exe.absoluteFilePath(), args, QIODevice::ReadWrite);
 }
 
+void IpcClient::parkEmulator(const QFileInfo& exe, const QStringList& args,
+                             const QString& workDir) {
+    startEmulator(exe, args, workDir);
+    parked = true;
+}
+
+void IpcClient::launchParked() {
+    parked = false;
+    for (const auto& [entry, color] : std::exchange(parkedLog, {})) {
+        emit LogEntrySent(entry, color);
+    }
+    if (handshakeDone) {
+        LOG_INFO(IPC, "Start parked emu");
+        runGame();
+    }
+}
+
+void IpcClient::discardParked() {
+    if (!parked) {
+        return;
+    }
+    parked = false;
+    parkedLog.clear();
+    if (process) {
+        process->disconnect();
+        process->kill();
+        process->deleteLater();
+        process = nullptr;
+    }
+    sessionLog.reset();
+    Common::SessionLogWriter::Remove(sessionLogPath);
+}
+
 void IpcClient::startGame() {
     writeLine("START");
 }
@@ -181,6 +249,9 @@ void IpcClient::onStderr() {
         }
 
         if (!line.startsWith(";")) {
+            if (sessionLog) {
+                sessionLog->Append(std::string_view(line.constData(), line.size()), true);
+            }
             LOG_ERROR(Tty, "{}", line.toStdString());
             continue;
         }
@@ -194,17 +265,30 @@ void IpcClient::onStderr() {
         } else if (s == "ENABLE_EMU_CONTROL") {
             supportedCapabilities["emu_control"] = true;
             LOG_INFO(IPC, "Feature detected: 'emu_control'");
+        } else if (s == "ENABLE_TELEMETRY") {
+            supportedCapabilities["telemetry"] = true;
+            LOG_INFO(IPC, "Feature detected: 'telemetry'");
+        } else if (s.startsWith("#TELEMETRY ")) {
+            onTelemetry(s);
         } else if (s == "#IPC_END") {
             for (const auto& [capability, supported] : supportedCapabilities) {
-                if (not supported) {
+                // Telemetry is optional, current emulators run without it
+                if (not supported && capability != "telemetry") {
                     LOG_WARNING(IPC,
                                 "Feature: '{}' is not supported by the choosen emulator version",
                                 capability);
                 }
             }
-            LOG_INFO(IPC, "Start emu");
-            writeLine("RUN");
-            startGameFunc();
+            handshakeDone = true;
+            if (parked) {
+                LOG_INFO(IPC, "Emu parked before RUN");
+                if (parkedFunc) {
+                    parkedFunc();
+                }
+            } else {
+                LOG_INFO(IPC, "Start emu");
+                runGame();
+            }
         } else if (s == "RESTART") {
             parsingState = ParsingState::args_counter;
         }
@@ -225,38 +309,102 @@ void IpcClient::onStderr() {
     }
 }
 
+void IpcClient::runGame() {
+    writeLine("RUN");
+    if (supportedCapabilities["telemetry"]) {
+        writeLine("SET_TELEMETRY");
+        writeLine(QString::number(TelemetryIntervalMs));
+    }
+    startGameFunc();
+}
+
+void IpcClient::onTelemetry(const QString& line) {
+    const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
+    if (parts.size() != 3 || parts[1].toUInt() != TelemetryVersion) {
+        return;
+    }
+    const QByteArray payload = QByteArray::fromBase64(parts[2].toLatin1());
+    if (payload.size() < static_cast<qsizetype>(sizeof(TelemetrySample))) {
+        return;
+    }
+
+    TelemetrySample sample;
+    std::memcpy(&sample, payload.constData(), sizeof(sample));
+    telemetry.Push(sample);
+    telemetrySummary.Add(sample);
+    emit TelemetryUpdated();
+}
+
 void IpcClient::onStdout() {
-    QColor color;
-    QByteArray data = process->readAllStandardOutput();
-    QString dataString = QString::fromUtf8(data);
-    QStringList entries = dataString.split('\n');
-
-    for (QString& entry : entries) {
-        if (entry.contains("<Warning>")) {
-            color = Qt::yellow;
-        } else if (entry.contains("<Error>")) {
-            color = Qt::red;
-        } else if (entry.contains("<Critical>")) {
-            color = Qt::magenta;
-        } else if (entry.contains("<Trace>")) {
-            color = Qt::gray;
-        } else if (entry.contains("<Debug>")) {
-            color = Qt::cyan;
-        } else {
-            color = Qt::white;
-        }
+    stdoutBuffer.append(process->readAllStandardOutput());
+    qsizetype begin = 0;
+    qsizetype idx;
+    while ((idx = stdoutBuffer.indexOf('\n', begin)) != -1) {
+        processStdoutLine(stdoutBuffer.sliced(begin, idx - begin));
+        begin = idx + 1;
+    }
+    stdoutBuffer.remove(0, begin);
+    if (sessionLog) {
+        sessionLog->Flush();
+    }
+}
 
-        QRegularExpression ansiRegex(
-            R"(\x1B\[[0-9;]*[mK])"); // ANSI escape codes from UNIX terminals
-        entry = entry.replace(ansiRegex, "");
+void IpcClient::processStdoutLine(QByteArray line) {
+    static const QRegularExpression ansiRegex(
+        R"(\x1B\[[0-9;]*[mK])"); // ANSI escape codes from UNIX terminals
 
-        if (!entry.isEmpty())
-            emit LogEntrySent(entry.trimmed(), color);
+    if (!line.isEmpty() && line.back() == '\r') {
+        line.chop(1);
+    }
+    QString entry = QString::fromUtf8(line);
+    entry.replace(ansiRegex, "");
+    if (entry.isEmpty()) {
+        return;
+    }
+    if (sessionLog) {
+        const QByteArray text = entry.toUtf8();
+        sessionLog->Append(std::string_view(text.constData(), text.size()), false);
+    }
+
+    QColor color;
+    if (entry.contains("<Warning>")) {
+        color = Qt::yellow;
+    } else if (entry.contains("<Error>")) {
+        color = Qt::red;
+    } else if (entry.contains("<Critical>")) {
+        color = Qt::magenta;
+    } else if (entry.contains("<Trace>")) {
+        color = Qt::gray;
+    } else if (entry.contains("<Debug>")) {
+        color = Qt::cyan;
+    } else {
+        color = Qt::white;
+    }
+    if (parked) {
+        parkedLog.emplace_back(entry.trimmed(), color);
+    } else {
+        emit LogEntrySent(entry.trimmed(), color);
     }
 }
 
 void IpcClient::onProcessClosed() {
-    gameClosedFunc();
+    if (process) {
+        stdoutBuffer.append(process->readAllStandardOutput());
+    }
+    if (!stdoutBuffer.isEmpty()) {
+        processStdoutLine(std::exchange(stdoutBuffer, {}));
+    }
+    sessionLog.reset();
+
+    // A parked emulator that exits on its own never ran a game
+    if (std::exchange(parked, false)) {
+        parkedLog.clear();
+        if (parkedClosedFunc) {
+            parkedClosedFunc();
+        }
+    } else {
+        gameClosedFunc();
+    }
     if (process) {
         process->disconnect();
         process->deleteLater();
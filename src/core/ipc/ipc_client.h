@@ -4,23 +4,47 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <QColor>
 #include <QFileInfo>
 #include <QProcess>
 
 #include "common/memory_patcher.h"
+#include "common/session_log.h"
+#include "core/ipc/telemetry.h"
 
 class IpcClient : public QObject {
     Q_OBJECT
 
 signals:
     void LogEntrySent(QString entry, QColor textColor);
+    void TelemetryUpdated();
 
 public:
     explicit IpcClient(QObject* parent = nullptr);
     void startEmulator(const QFileInfo& exe, const QStringList& args,
                        const QString& workDir = QString(), bool disable_ipc = false);
+    /// Starts the emulator but holds it at the end of the IPC handshake, parkedFunc is called
+    /// once it gets there. Its output is held back until launchParked.
+    void parkEmulator(const QFileInfo& exe, const QStringList& args,
+                      const QString& workDir = QString());
+    /// Lets the parked emulator run, as soon as its handshake completes if it hasn't yet.
+    void launchParked();
+    /// Kills the parked emulator and deletes its session log.
+    void discardParked();
+    bool isParked() const {
+        return parked;
+    }
+    /// Samples of the running session, if the emulator streams telemetry.
+    const TelemetryRing& getTelemetry() const {
+        return telemetry;
+    }
+    const TelemetrySummary& getTelemetrySummary() const {
+        return telemetrySummary;
+    }
     void startGame();
     void pauseGame();
     void resumeGame();
@@ -51,24 +75,39 @@ public:
     std::function<void()> gameClosedFunc;
     std::function<void()> startGameFunc;
     std::function<void()> restartEmulatorFunc;
+    std::function<void()> parkedFunc;
+    /// Called instead of gameClosedFunc when a parked emulator exits before it was launched.
+    std::function<void()> parkedClosedFunc;
 
     enum ParsingState { normal, args_counter, args };
     std::vector<std::string> parsedArgs;
     std::unordered_map<std::string, bool> supportedCapabilities{
         {"memory_patch", false},
         {"emu_control", false},
+        {"telemetry", false},
     };
 
 private:
     void onStderr();
     void onStdout();
     void onProcessClosed();
+    void processStdoutLine(QByteArray line);
+    void runGame();
+    void onTelemetry(const QString& line);
     void writeLine(const QString& text);
 
     QProcess* process = nullptr;
     QByteArray buffer;
+    QByteArray stdoutBuffer;
+    std::unique_ptr<Common::SessionLogWriter> sessionLog;
+    std::filesystem::path sessionLogPath;
     bool pendingRestart = false;
+    bool parked = false;
+    bool handshakeDone = false;
+    std::vector<std::pair<QString, QColor>> parkedLog; ///< Output of the parked emulator
+    TelemetryRing telemetry;
+    TelemetrySummary telemetrySummary;
 
-    ParsingState parsingState;
-    int argsCounter;
+    ParsingState parsingState = ParsingState::normal;
+    int argsCounter = 0;
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "telemetry.h"
+
+void TelemetryRing::Push(const TelemetrySample& sample) {
+    m_samples[m_next] = sample;
+    m_next = (m_next + 1) % Capacity;
+    m_size = std::min(m_size + 1, Capacity);
+}
+
+void TelemetryRing::Clear() {
+    m_next = 0;
+    m_size = 0;
+}
+
+void TelemetrySummary::Add(const TelemetrySample& sample) {
+    min_fps = samples == 0 ? sample.fps : std::min(min_fps, sample.fps);
+    worst_frame_time_p99 = std::max(worst_frame_time_p99, sample.frame_time_p99);
+    peak_memory_mib = std::max(peak_memory_mib, sample.memory_mib);
+    duration_ms = std::max(duration_ms, sample.time_ms);
+    fps_sum += sample.fps;
+    frame_time_p99_sum += sample.frame_time_p99;
+    cpu_util_sum += sample.cpu_thread_util;
+    gpu_util_sum += sample.gpu_thread_util;
+    ++samples;
+}
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "common/types.h"
+
+/**
+ * Performance samples streamed by an emulator that announces ENABLE_TELEMETRY in the IPC
+ * handshake. After RUN the launcher sends SET_TELEMETRY with the sample interval in
+ * milliseconds, then every sample arrives on stderr as ";#TELEMETRY <version> <base64>", the
+ * payload being a little-endian TelemetrySample.
+ */
+struct TelemetrySample {
+    u32 time_ms;          ///< Since the emulator started
+    float fps;            ///< Over the sample interval
+    float frame_time_p50; ///< Milliseconds, over the sample interval
+    float frame_time_p95;
+    float frame_time_p99;
+    u8 cpu_thread_util; ///< Percent of the interval the game threads were busy
+    u8 gpu_thread_util; ///< Percent of the interval the GPU submission thread was busy
+    u16 reserved;
+    u32 memory_mib; ///< Resident memory of the emulator
+};
+static_assert(sizeof(TelemetrySample) == 28);
+
+constexpr u32 TelemetryVersion = 1;
+
+/// The latest samples of a session, the oldest ones are overwritten. Filled and drawn on the GUI
+/// thread, so it needs no synchronization.
+class TelemetryRing {
+public:
+    static constexpr size_t Capacity = 4096;
+
+    void Push(const TelemetrySample& sample);
+    void Clear();
+
+    size_t Size() const {
+        return m_size;
+    }
+
+    /// The i-th oldest sample kept.
+    const TelemetrySample& operator[](size_t i) const {
+        return m_samples[(m_next + Capacity - m_size + i) % Capacity];
+    }
+
+private:
+    std::array<TelemetrySample, Capacity> m_samples{};
+    size_t m_next = 0;
+    size_t m_size = 0;
+};
+
+/// Summary of all the samples of a session, including those the ring dropped.
+struct TelemetrySummary {
+    u64 samples = 0;
+    u32 duration_ms = 0;
+    float min_fps = 0;
+    float worst_frame_time_p99 = 0;
+    u32 peak_memory_mib = 0;
+    double fps_sum = 0;
+    double frame_time_p99_sum = 0;
+    double cpu_util_sum = 0;
+    double gpu_util_sum = 0;
+
+    void Add(const TelemetrySample& sample);
+
+    double AverageFps() const {
+        return samples != 0 ? fps_sum / samples : 0;
+    }
+    double AverageFrameTimeP99() const {
+        return samples != 0 ? frame_time_p99_sum / samples : 0;
+    }
+    double AverageCpuUtil() const {
+        return samples != 0 ? cpu_util_sum / samples : 0;
+    }
+    double AverageGpuUtil() const {
+        return samples != 0 ? gpu_util_sum / samples : 0;
+    }
+};
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <charconv>
+#include "common/path_util.h"
+#include "common/string_util.h"
+#include "core/file_format/pkg.h"
+#include "core/file_format/psf.h"
+#include "core/pkg_install_target.h"
+
+namespace {
+constexpr int GameSearchDepth = 5;
+
+double ParseAppVersion(std::string_view version) {
+    double value = 0.0;
+    std::from_chars(version.data(), version.data() + version.size(), value);
+    return value;
+}
+} // namespace
+
+bool ResolvePkgInstallTarget(PKG& pkg, const PSF& psf, const std::filesystem::path& install_dir,
+                             const std::filesystem::path& addon_install_dir,
+                             bool separate_update_folder, PkgInstallTarget& target,
+                             std::string& failreason) {
+    const std::string title_id{pkg.GetTitleID()};
+    const bool is_patch = pkg.GetPkgFlags().find("PATCH") != std::string::npos;
+    const bool is_addon = psf.GetString("CATEGORY") == "ac";
+
+    target = {};
+    target.kind = is_patch   ? PkgInstallTarget::Kind::Patch
+                  : is_addon ? PkgInstallTarget::Kind::Addon
+                             : PkgInstallTarget::Kind::Game;
+
+    // Reuse the folder of an installed copy of the game, wherever it is below install_dir.
+    target.game_folder = install_dir / title_id;
+    if (const auto found = Common::FS::FindGameByID(install_dir, title_id, GameSearchDepth)) {
+        target.game_folder = found->parent_path();
+    }
+    target.extract_path = is_patch && separate_update_folder
+                              ? target.game_folder.parent_path() / (title_id + "-patch")
+                              : target.game_folder;
+
+    std::error_code ec;
+    target.game_installed = std::filesystem::exists(target.game_folder, ec);
+    if (!target.game_installed) {
+        return true;
+    }
+
+    const auto content_id = psf.GetString("CONTENT_ID");
+    if (!content_id) {
+        failreason = "PSF file there is no CONTENT_ID";
+        return false;
+    }
+    const auto content_parts = Common::SplitString(std::string{*content_id}, '-');
+    if (content_parts.size() < 3) {
+        failreason = "PSF file has an invalid CONTENT_ID";
+        return false;
+    }
+    target.entitlement_label = content_parts[2];
+
+    if (is_patch) {
+        const auto pkg_app_ver = psf.GetString("APP_VER");
+        if (!pkg_app_ver) {
+            failreason = "PSF file there is no APP_VER";
+            return false;
+        }
+        target.pkg_app_version = std::string{*pkg_app_ver};
+
+        // An update installed on its own takes precedence over the base game version.
+        const auto update_sfo = target.extract_path / "sce_sys" / "param.sfo";
+        PSF installed_psf;
+        installed_psf.Open(std::filesystem::exists(update_sfo, ec)
+                               ? update_sfo
+                               : target.game_folder / "sce_sys" / "param.sfo");
+        const auto installed_app_ver = installed_psf.GetString("APP_VER");
+        if (!installed_app_ver) {
+            failreason = "PSF file there is no APP_VER";
+            return false;
+        }
+        target.installed_app_version = std::string{*installed_app_ver};
+    } else if (is_addon) {
+        target.extract_path = addon_install_dir / title_id / target.entitlement_label;
+        target.addon_installed = std::filesystem::exists(target.extract_path, ec);
+    }
+    return true;
+}
+
+int CompareAppVersions(std::string_view lhs, std::string_view rhs) {
+    const double lhs_value = ParseAppVersion(lhs);
+    const double rhs_value = ParseAppVersion(rhs);
+    return lhs_value < rhs_value ? -1 : (lhs_value > rhs_value ? 1 : 0);
+}
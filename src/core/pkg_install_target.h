@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+class PKG;
+class PSF;
+
+/**
+ * Where a PKG goes and what is already installed there. Shared by the GUI installer, which
+ * turns the flags into questions, and the headless installer, which turns them into a policy.
+ */
+struct PkgInstallTarget {
+    enum class Kind {
+        Game,
+        Patch,
+        Addon,
+    };
+
+    Kind kind = Kind::Game;
+    std::filesystem::path game_folder;  ///< Folder of the base game, found or to be created
+    std::filesystem::path extract_path; ///< Destination handed to PKG::Extract
+    bool game_installed = false;        ///< game_folder exists already
+    bool addon_installed = false;       ///< The DLC folder exists already (Addon only)
+    std::string entitlement_label;      ///< Third part of the content ID (DLC folder name)
+    std::string pkg_app_version;        ///< APP_VER of the patch (Patch only)
+    std::string installed_app_version;  ///< APP_VER of the installed game or update (Patch only)
+
+    /// Patches and DLC can only be installed on top of their game.
+    bool NeedsBaseGame() const {
+        return kind != Kind::Game && !game_installed;
+    }
+};
+
+/**
+ * Applies the game/update/DLC placement rules for an opened PKG.
+ * @param install_dir The game install folder picked by the user
+ * @param addon_install_dir The configured DLC folder
+ * @param separate_update_folder Install patches to "<TITLE_ID>-patch" next to the game
+ * @returns false with a failreason if the param.sfo lacks data the rules need
+ */
+bool ResolvePkgInstallTarget(PKG& pkg, const PSF& psf, const std::filesystem::path& install_dir,
+                             const std::filesystem::path& addon_install_dir,
+                             bool separate_update_folder, PkgInstallTarget& target,
+                             std::string& failreason);
+
+/// Compares two APP_VER strings ("01.05") numerically, returns <0, 0 or >0.
+int CompareAppVersions(std::string_view lhs, std::string_view rhs);
@@ -1,18 +1,129 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <charconv>
+#include <fstream>
 #include <iostream>
+#include <string_view>
 #include <QApplication>
 #include <QMessageBox>
 
+#include "common/key_manager.h"
 #include "common/logging/backend.h"
+#include "common/logging/binary_log.h"
 #include "common/logging/log.h"
+#include "core/emulator_settings.h"
 #include "qt_ui/gui_application.h"
+#include "qt_ui/gui_settings.h"
+#include "qt_ui/headless_installer.h"
 #include "qt_ui/stylesheets.h"
 
+namespace {
+
+// Installs PKGs from the command line without creating any window, see HeadlessInstaller.
+int RunHeadlessInstall(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    std::setlocale(LC_NUMERIC, "C"); // Qt changes to the system locale while initializing
+
+    HeadlessInstallOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--install") {
+            while (i + 1 < argc && argv[i + 1][0] != '-') {
+                options.pkgs.emplace_back(std::filesystem::path(std::u8string_view(
+                    reinterpret_cast<const char8_t*>(argv[++i]))));
+            }
+        } else if (arg == "--dest" && i + 1 < argc) {
+            options.dest = std::filesystem::path(
+                std::u8string_view(reinterpret_cast<const char8_t*>(argv[++i])));
+        } else if (arg == "--overwrite") {
+            options.overwrite = true;
+        } else if (arg == "--binary-log") {
+            // Already applied before the log was opened
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            const std::string_view value = argv[++i];
+            const auto [ptr, ec] =
+                std::from_chars(value.data(), value.data() + value.size(), options.jobs);
+            if (ec != std::errc{} || ptr != value.data() + value.size()) {
+                std::cerr << "Error: Invalid value for --jobs: " << value << "\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "Unknown or incomplete argument: " << arg << ", see --help for info.\n";
+            return 1;
+        }
+    }
+    if (options.pkgs.empty()) {
+        std::cerr << "Error: Missing PKG files for --install\n";
+        return 1;
+    }
+
+    auto gui_settings = std::make_shared<GUISettings>();
+    auto emu_settings = std::make_shared<EmulatorSettings>();
+    emu_settings->Load();
+    EmulatorSettings::SetInstance(emu_settings);
+    auto key_manager = std::make_shared<KeyManager>();
+    KeyManager::SetInstance(key_manager);
+    key_manager->LoadFromFile();
+
+    if (options.dest.empty() && !emu_settings->GetGameInstallDirs().empty()) {
+        options.dest = emu_settings->GetGameInstallDirs().front();
+    }
+    return HeadlessInstaller(gui_settings, emu_settings).Run(options);
+}
+
+// Renders a binary log to text, to the given file or to stdout.
+int DecodeBinaryLog(int argc, char* argv[], int i) {
+    if (i + 1 >= argc) {
+        std::cerr << "Error: Missing argument for --decode-log\n";
+        return 1;
+    }
+    const std::filesystem::path input(
+        std::u8string_view(reinterpret_cast<const char8_t*>(argv[i + 1])));
+    const auto text = Common::Log::BinaryLogDecoder::DecodeToText(input);
+    if (!text) {
+        std::cerr << "Error: " << argv[i + 1] << " is not a binary log\n";
+        return 1;
+    }
+
+    if (i + 2 >= argc) {
+        std::cout << *text;
+        return 0;
+    }
+    const std::filesystem::path output_path(
+        std::u8string_view(reinterpret_cast<const char8_t*>(argv[i + 2])));
+    std::ofstream output(output_path, std::ios::binary);
+    output << *text;
+    if (!output) {
+        std::cerr << "Error: Could not write " << argv[i + 2] << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
 int main(int argc, char* argv[]) {
+    // Handled before the log is opened, decoding must not replace the log being read
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--decode-log") {
+            return DecodeBinaryLog(argc, argv, i);
+        } else if (arg == "--binary-log") {
+            Common::Log::SetBinary();
+        }
+    }
+
     Common::Log::Initialize();
     Common::Log::Start();
+
+    // The headless installer must not create a QApplication, it may run without a display.
+    for (int i = 1; i < argc; ++i) {
+        if (std::string_view(argv[i]) == "--install") {
+            return RunHeadlessInstall(argc, argv);
+        }
+    }
+
     QScopedPointer<QCoreApplication> app(new GUIApplication(argc, argv));
     GUIApplication* gui_app = qobject_cast<GUIApplication*>(app.data());
 
@@ -31,6 +142,17 @@ int main(int argc, char* argv[]) {
                  "use, or 'default' for using the version selected in the config.\n"
                  "  -g, --game <ID|path>          Specify game to launch.\n"
                  "  -d                            Alias for '-e default'.\n"
+                 "  --install <pkg...>            Install PKGs without opening the GUI, "
+                 "printing JSON progress lines.\n"
+                 "    --dest <dir>                Game install folder (default: first "
+                 "configured).\n"
+                 "    --overwrite                 Reinstall content that is already installed.\n"
+                 "    --jobs <n>                  Extraction threads and titles installed at "
+                 "once (default: all cores).\n"
+                 "  --binary-log                  Write a binary log (.blog) with deferred "
+                 "formatting, without console output.\n"
+                 "  --decode-log <blog> [out]     Render a binary log as text, to stdout or "
+                 "to the given file.\n"
                  "  -h, --help                    Display this help message.\n";
              QMessageBox::information(nullptr, "tr(shadLauncher4 command line options)", helpMsg);
              exit(0);
@@ -58,6 +180,7 @@ int main(int argc, char* argv[]) {
          }},
         {"--emulator", [&](int& i) { arg_map["-e"](i); }},
         {"-d", [&](int&) { emulator_arg = "default"; }},
+        {"--binary-log", [&](int&) {}}, // Handled before the log is opened
     };
 
     // Parse command-line arguments using the map
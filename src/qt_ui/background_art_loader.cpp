@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <QImageReader>
+
+#include "background_art_loader.h"
+
+BackgroundArtLoader::BackgroundArtLoader(QObject* parent, size_t capacity)
+    : QObject(parent), m_capacity(capacity) {
+    m_thread.reset(QThread::create([this] { Run(); }));
+    m_thread->start(QThread::LowPriority);
+}
+
+BackgroundArtLoader::~BackgroundArtLoader() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+        m_jobs.clear();
+    }
+    m_cv.notify_all();
+    m_thread->wait();
+}
+
+void BackgroundArtLoader::Request(const std::string& path, const QSize& target_size,
+                                  const std::vector<std::string>& prefetch_paths) {
+    if (target_size.isEmpty()) {
+        return;
+    }
+
+    QImage cached;
+    {
+        std::scoped_lock lock{m_mutex};
+        const u64 generation = ++m_generation;
+
+        // Whatever hasn't started yet belongs to an older selection
+        m_jobs.clear();
+
+        if (!FindCached(path, target_size, cached)) {
+            m_jobs.push_back({path, target_size, false, generation});
+        }
+        for (const std::string& prefetch_path : prefetch_paths) {
+            QImage unused;
+            if (!prefetch_path.empty() && prefetch_path != path &&
+                !FindCached(prefetch_path, target_size, unused)) {
+                m_jobs.push_back({prefetch_path, target_size, true, generation});
+            }
+        }
+    }
+    m_cv.notify_one();
+
+    if (!cached.isNull()) {
+        Q_EMIT ImageReady(QString::fromStdString(path), cached);
+    }
+}
+
+void BackgroundArtLoader::Run() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock{m_mutex};
+            m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+            if (m_stop) {
+                return;
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+
+            // Decoded by an earlier request while this one was queued
+            QImage unused;
+            if (FindCached(job.path, job.size, unused)) {
+                continue;
+            }
+        }
+
+        const QImage image = Decode(job.path, job.size);
+
+        bool current = false;
+        {
+            std::scoped_lock lock{m_mutex};
+            if (m_stop) {
+                return;
+            }
+            if (!image.isNull()) {
+                Insert(job.path, job.size, image);
+            }
+            current = !job.prefetch && job.generation == m_generation;
+        }
+        if (current) {
+            Q_EMIT ImageReady(QString::fromStdString(job.path), image);
+        }
+    }
+}
+
+bool BackgroundArtLoader::FindCached(const std::string& path, const QSize& size, QImage& image) {
+    const auto it = std::find_if(m_cache.begin(), m_cache.end(), [&](const CacheEntry& entry) {
+        return entry.size == size && entry.path == path;
+    });
+    if (it == m_cache.end()) {
+        return false;
+    }
+    m_cache.splice(m_cache.begin(), m_cache, it);
+    image = it->image;
+    return true;
+}
+
+void BackgroundArtLoader::Insert(const std::string& path, const QSize& size, const QImage& image) {
+    m_cache.push_front({path, size, image});
+    while (m_cache.size() > m_capacity) {
+        m_cache.pop_back();
+    }
+}
+
+QImage BackgroundArtLoader::Decode(const std::string& path, const QSize& target_size) {
+    QImageReader reader(QString::fromStdString(path));
+    const QSize source_size = reader.size();
+    if (source_size.isValid()) {
+        // Same size the views scale to, so painting doesn't have to rescale it again
+        reader.setScaledSize(source_size.scaled(target_size, Qt::KeepAspectRatioByExpanding));
+    }
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        return {};
+    }
+    // Converted here, the views make their cached pixmap from it without converting again
+    return image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <QImage>
+#include <QObject>
+#include <QSize>
+#include <QThread>
+
+#include "common/types.h"
+
+/**
+ * Decodes the PIC1 backgrounds of the game list on a worker thread, scaled to the size they are
+ * drawn at. Keeps the last few decoded backgrounds and prefetches the ones of the neighbouring
+ * entries, so moving the selection with the arrow keys doesn't decode on the GUI thread.
+ */
+class BackgroundArtLoader : public QObject {
+    Q_OBJECT
+
+public:
+    explicit BackgroundArtLoader(QObject* parent = nullptr, size_t capacity = 8);
+    ~BackgroundArtLoader();
+
+    /** Requests the background for the selection. Older requests that haven't started are
+     * dropped, and only the latest request is reported through ImageReady. */
+    void Request(const std::string& path, const QSize& target_size,
+                 const std::vector<std::string>& prefetch_paths);
+
+Q_SIGNALS:
+    /** The background of the latest request. Null if the file couldn't be decoded. */
+    void ImageReady(const QString& path, const QImage& image);
+
+private:
+    struct Job {
+        std::string path;
+        QSize size;
+        bool prefetch;
+        u64 generation;
+    };
+    struct CacheEntry {
+        std::string path;
+        QSize size;
+        QImage image;
+    };
+
+    void Run();
+    bool FindCached(const std::string& path, const QSize& size, QImage& image);
+    void Insert(const std::string& path, const QSize& size, const QImage& image);
+    static QImage Decode(const std::string& path, const QSize& target_size);
+
+    const size_t m_capacity;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::list<CacheEntry> m_cache; ///< Most recently used first
+    std::deque<Job> m_jobs;
+    u64 m_generation = 0;
+    bool m_stop = false;
+    std::unique_ptr<QThread> m_thread;
+};
@@ -32,6 +32,7 @@
 #include "common/memory_patcher.h"
 #include "common/path_util.h"
 #include "core/emulator_state.h"
+#include "network_service.h"
 #include "ui_cheats_patches_dialog.h"
 
 CheatsPatches::CheatsPatches(std::shared_ptr<GUISettings> gui_settings,
@@ -41,7 +42,7 @@ CheatsPatches::CheatsPatches(std::shared_ptr<GUISettings> gui_settings,
     : QWidget(parent), ui(new Ui::CheatsPatchesDialog), m_gameName(gameName),
       m_gameSerial(gameSerial), m_gameVersion(gameVersion), m_gameSize(gameSize),
       m_gameImage(gameImage), m_gui_settings(std::move(gui_settings)), m_ipc_client(ipc_client),
-      manager(new QNetworkAccessManager(this)) {
+      manager(NetworkService::instance().GetManager()) {
     ui->setupUi(this);
     setWindowTitle(tr("Cheats / Patches for ") + m_gameName);
     setupUI();
@@ -201,8 +202,6 @@ void CheatsPatches::setupUI() {
         if (index == 1)
             populateFileListPatches();
     });
-
-    manager = new QNetworkAccessManager(this);
 }
 
 void CheatsPatches::onSaveButtonClicked() {
@@ -391,42 +390,30 @@ void CheatsPatches::downloadCheats(const QString& source, const QString& gameSer
                 QDir cheatsDir(Common::FS::GetUserPath(Common::FS::PathType::CheatsDir));
                 cheatsDir.mkpath(".");
 
-                bool foundFiles = false;
-
+                QList<std::pair<QUrl, QString>> files;
                 auto it = regex.globalMatch(textContent);
                 while (it.hasNext()) {
                     const QString fileName = it.next().captured(0);
                     const QString finalName =
                         fileName.left(fileName.lastIndexOf('.')) + QString("_%1.json").arg(source);
-
-                    const QString fileUrl = cheatsBaseUrl + fileName;
-                    const QString localPath = cheatsDir.filePath(finalName);
-
-                    auto* fileDl = new Downloader(m_gui_settings, std::nullopt, std::nullopt, this);
-
-                    connect(fileDl, &Downloader::SignalDownloadFinished, this,
-                            [this, fileDl](const QByteArray&) {
-                                fileDl->deleteLater();
-                                populateFileListCheats();
-                            });
-
-                    connect(fileDl, &Downloader::SignalDownloadError, this,
-                            [this, fileDl](const QString& err) {
-                                QMessageBox::warning(this, tr("Download Error"), err);
-                                fileDl->deleteLater();
-                            });
-
-                    fileDl->DownloadJSONWithCache(fileUrl.toStdString(), localPath, false,
-                                                  QString(), 0);
-
-                    foundFiles = true;
+                    files.append({QUrl(cheatsBaseUrl + fileName), cheatsDir.filePath(finalName)});
                 }
 
-                if (!foundFiles && showMessageBox) {
-                    QMessageBox::warning(this, tr("Cheats Not Found"), CheatsNotFound_MSG);
-                } else if (foundFiles && showMessageBox) {
-                    QMessageBox::information(this, tr("Success"), CheatsDownloadedSuccessfully_MSG);
+                if (files.isEmpty()) {
+                    if (showMessageBox)
+                        QMessageBox::warning(this, tr("Cheats Not Found"), CheatsNotFound_MSG);
+                    return;
                 }
+
+                DownloadFiles(files, [this, showMessageBox](const QStringList& errors) {
+                    populateFileListCheats();
+                    if (!errors.isEmpty()) {
+                        QMessageBox::warning(this, tr("Download Error"), errors.join('\n'));
+                    } else if (showMessageBox) {
+                        QMessageBox::information(this, tr("Success"),
+                                                 CheatsDownloadedSuccessfully_MSG);
+                    }
+                });
             });
 
     connect(m_downloader, &Downloader::SignalDownloadError, this,
@@ -543,6 +530,7 @@ void CheatsPatches::downloadPatches(const QString repository, const bool showMes
                 patchesDir.mkpath(repository);
                 patchesDir.cd(repository);
 
+                QList<std::pair<QUrl, QString>> files;
                 for (const auto& v : items) {
                     const QJsonObject o = v.toObject();
                     const QString name = o["name"].toString();
@@ -551,21 +539,22 @@ void CheatsPatches::downloadPatches(const QString repository, const bool showMes
                     if (!name.endsWith(".xml"))
                         continue;
 
-                    auto* fileDl = new Downloader(m_gui_settings, std::nullopt, std::nullopt, this);
-
-                    fileDl->DownloadJSONWithCache(downloadUrl.toStdString(),
-                                                  patchesDir.filePath(name), false, QString(), 0);
-
-                    connect(fileDl, &Downloader::SignalDownloadFinished, fileDl,
-                            &QObject::deleteLater);
+                    files.append({QUrl(downloadUrl), patchesDir.filePath(name)});
                 }
 
-                if (showMessageBox)
-                    QMessageBox::information(this, tr("Download Complete"), DownloadComplete_MSG);
+                // The index and the notice need every file on disk
+                DownloadFiles(files, [this, repository, showMessageBox](const QStringList& errors) {
+                    if (!errors.isEmpty()) {
+                        QMessageBox::warning(this, tr("Download Error"), errors.join('\n'));
+                    } else if (showMessageBox) {
+                        QMessageBox::information(this, tr("Download Complete"),
+                                                 DownloadComplete_MSG);
+                    }
 
-                createFilesJson(repository);
-                populateFileListPatches();
-                compatibleVersionNotice(repository);
+                    createFilesJson(repository);
+                    populateFileListPatches();
+                    compatibleVersionNotice(repository);
+                });
 
                 dl->deleteLater();
             });
@@ -654,6 +643,37 @@ void CheatsPatches::compatibleVersionNotice(const QString repository) {
     }
 }
 
+void CheatsPatches::DownloadFiles(const QList<std::pair<QUrl, QString>>& files,
+                                  std::function<void(const QStringList&)> done) {
+    if (files.isEmpty()) {
+        done({});
+        return;
+    }
+    struct Progress {
+        qsizetype pending;
+        QStringList errors;
+    };
+    auto progress = std::make_shared<Progress>(Progress{files.size(), {}});
+    for (const auto& [url, path] : files) {
+        NetworkService::instance().Fetch(
+            url, this,
+            [progress, done, url, path](const NetworkService::Response& response) {
+                if (!response.error.isEmpty()) {
+                    progress->errors.append(url.fileName() + ": " + response.error);
+                } else {
+                    QFile file(path);
+                    if (!file.open(QIODevice::WriteOnly) ||
+                        file.write(response.data) != response.data.size()) {
+                        progress->errors.append(tr("Failed to save file:") + " " + path);
+                    }
+                }
+                if (--progress->pending == 0) {
+                    done(progress->errors);
+                }
+            });
+    }
+}
+
 void CheatsPatches::createFilesJson(const QString& repository) {
 
     QDir dir(Common::FS::GetUserPath(Common::FS::PathType::PatchesDir));
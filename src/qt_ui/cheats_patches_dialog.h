@@ -1,7 +1,9 @@
 ﻿// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <functional>
 #include <memory>
+#include <utility>
 #include <QCheckBox>
 #include <QComboBox>
 #include <QGroupBox>
@@ -59,6 +61,9 @@ private:
     // Cheat and Patch Management
     void populateFileListCheats();
     void populateFileListPatches();
+    /// Fetches each URL to its path through NetworkService, then calls done with the errors.
+    void DownloadFiles(const QList<std::pair<QUrl, QString>>& files,
+                       std::function<void(const QStringList&)> done);
 
     void addCheatsToLayout(const QJsonArray& modsArray, const QJsonArray& creditsArray);
     void addPatchesToLayout(const QString& serial);
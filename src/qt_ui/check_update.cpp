@@ -27,13 +27,14 @@
 
 #include "check_update.h"
 #include "gui_settings.h"
+#include "network_service.h"
 
 using namespace Common::FS;
 
 CheckUpdate::CheckUpdate(std::shared_ptr<GUISettings> gui_settings, bool showMessage,
                          QWidget* parent)
     : QDialog(parent), m_gui_settings(std::move(gui_settings)),
-      networkManager(new QNetworkAccessManager(this)) {
+      networkManager(NetworkService::instance().GetManager()) {
 
     setWindowTitle(tr("Auto Updater - GUI"));
     setFixedSize(0, 0);
@@ -0,0 +1,275 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include "common/io_file.h"
+#include "compat_database.h"
+
+namespace Compat {
+
+namespace {
+constexpr u32 DatabaseMagic = 0x44434C53; // "SLCD"
+constexpr u32 DatabaseVersion = 1;
+constexpr u32 EmptyBucket = 0;
+constexpr size_t SerialSize = 16;
+
+u32 HashSerial(std::string_view serial) {
+    u32 hash = 0x811C9DC5;
+    for (const char c : serial) {
+        hash = (hash ^ static_cast<u8>(c)) * 0x01000193;
+    }
+    return hash;
+}
+
+size_t AlignUp4(size_t value) {
+    return (value + 3) & ~size_t{3};
+}
+} // namespace
+
+struct Database::Header {
+    u32 magic;
+    u32 version;
+    u64 source_size;
+    s64 source_mtime;
+    u64 source_hash;
+    u32 entry_count;
+    u32 bucket_count;  ///< Power of two, each bucket holds entry index + 1
+    u32 string_count;  ///< Entries of the offset table minus one
+    u32 strings_size;
+};
+
+struct Database::Entry {
+    char serial[SerialSize]; ///< Zero padded
+    u32 last_tested_date;    ///< String ids
+    u32 latest_version;
+    u32 issue_number;
+    u8 status;
+    u8 padding[3];
+};
+
+u64 Database::Hash(std::span<const u8> data) {
+    u64 hash = 0xCBF29CE484222325ULL;
+    for (const u8 byte : data) {
+        hash = (hash ^ byte) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+void Database::Builder::Add(std::string_view serial, u8 status, std::string_view last_tested_date,
+                            std::string_view latest_version, std::string_view issue_number) {
+    if (serial.empty() || serial.size() >= SerialSize) {
+        return;
+    }
+    m_entries.insert_or_assign(std::string{serial},
+                               Pending{status, Intern(last_tested_date), Intern(latest_version),
+                                       Intern(issue_number)});
+}
+
+u32 Database::Builder::Intern(std::string_view text) {
+    const auto [it, inserted] =
+        m_string_ids.try_emplace(std::string{text}, static_cast<u32>(m_strings.size()));
+    if (inserted) {
+        m_strings.emplace_back(text);
+    }
+    return it->second;
+}
+
+std::shared_ptr<const Database> Database::Builder::Build(const SourceStamp& source) {
+    const u32 entry_count = static_cast<u32>(m_entries.size());
+    const u32 bucket_count = std::bit_ceil(std::max(entry_count * 2, 16u));
+    const u32 string_count = static_cast<u32>(m_strings.size());
+    size_t strings_size = 0;
+    for (const auto& text : m_strings) {
+        strings_size += text.size();
+    }
+
+    const size_t entries_offset = sizeof(Header);
+    const size_t buckets_offset = entries_offset + entry_count * sizeof(Entry);
+    const size_t offsets_offset = buckets_offset + bucket_count * sizeof(u32);
+    const size_t strings_offset = offsets_offset + (string_count + 1) * sizeof(u32);
+    const size_t total_size = AlignUp4(strings_offset + strings_size);
+
+    auto database = std::shared_ptr<Database>(new Database());
+    auto& buffer = database->m_buffer;
+    buffer.assign(total_size, 0);
+
+    Header header{};
+    header.magic = DatabaseMagic;
+    header.version = DatabaseVersion;
+    header.source_size = source.size;
+    header.source_mtime = source.mtime;
+    header.source_hash = source.hash;
+    header.entry_count = entry_count;
+    header.bucket_count = bucket_count;
+    header.string_count = string_count;
+    header.strings_size = static_cast<u32>(strings_size);
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    auto* entries = reinterpret_cast<Entry*>(buffer.data() + entries_offset);
+    auto* buckets = reinterpret_cast<u32*>(buffer.data() + buckets_offset);
+    u32 index = 0;
+    for (const auto& [serial, entry] : m_entries) { // std::map keeps the serials sorted
+        Entry& out = entries[index];
+        std::memcpy(out.serial, serial.data(), serial.size());
+        out.last_tested_date = entry.last_tested_date;
+        out.latest_version = entry.latest_version;
+        out.issue_number = entry.issue_number;
+        out.status = entry.status;
+
+        u32 bucket = HashSerial(serial) & (bucket_count - 1);
+        while (buckets[bucket] != EmptyBucket) {
+            bucket = (bucket + 1) & (bucket_count - 1);
+        }
+        buckets[bucket] = ++index;
+    }
+
+    auto* offsets = reinterpret_cast<u32*>(buffer.data() + offsets_offset);
+    char* strings = reinterpret_cast<char*>(buffer.data() + strings_offset);
+    u32 offset = 0;
+    for (u32 i = 0; i < string_count; ++i) {
+        offsets[i] = offset;
+        std::memcpy(strings + offset, m_strings[i].data(), m_strings[i].size());
+        offset += static_cast<u32>(m_strings[i].size());
+    }
+    offsets[string_count] = offset;
+
+    if (!database->Parse(buffer)) {
+        return nullptr;
+    }
+    return database;
+}
+
+std::shared_ptr<const Database> Database::Open(const std::filesystem::path& path) {
+    auto database = std::shared_ptr<Database>(new Database());
+    if (!database->m_file.Open(path) || !database->Parse(database->m_file.Data())) {
+        return nullptr;
+    }
+    return database;
+}
+
+bool Database::Parse(std::span<const u8> data) {
+    static_assert(sizeof(Header) == 48 && sizeof(Entry) == 32, "On-disk layout changed");
+    if (data.size() < sizeof(Header)) {
+        return false;
+    }
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != DatabaseMagic || header.version != DatabaseVersion ||
+        !std::has_single_bit(header.bucket_count)) {
+        return false;
+    }
+
+    const u64 entries_offset = sizeof(Header);
+    const u64 buckets_offset = entries_offset + u64{header.entry_count} * sizeof(Entry);
+    const u64 offsets_offset = buckets_offset + u64{header.bucket_count} * sizeof(u32);
+    const u64 strings_offset = offsets_offset + (u64{header.string_count} + 1) * sizeof(u32);
+    if (strings_offset + header.strings_size > data.size()) {
+        return false;
+    }
+
+    // Sections are 4 byte aligned and the data starts page (mapping) or malloc aligned.
+    m_data = data;
+    m_source = {header.source_size, header.source_mtime, header.source_hash};
+    m_entry_count = header.entry_count;
+    m_bucket_count = header.bucket_count;
+    m_string_count = header.string_count;
+    m_entries = reinterpret_cast<const Entry*>(data.data() + entries_offset);
+    m_buckets = reinterpret_cast<const u32*>(data.data() + buckets_offset);
+    m_string_offsets = reinterpret_cast<const u32*>(data.data() + offsets_offset);
+    m_strings = reinterpret_cast<const char*>(data.data() + strings_offset);
+    m_strings_size = header.strings_size;
+    return m_string_offsets[m_string_count] <= m_strings_size;
+}
+
+bool Database::Write(const std::filesystem::path& path,
+                     const std::optional<SourceStamp>& source) const {
+    Header header;
+    std::memcpy(&header, m_data.data(), sizeof(header));
+    if (source) {
+        header.source_size = source->size;
+        header.source_mtime = source->mtime;
+        header.source_hash = source->hash;
+    }
+
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile file(temp_path, Common::FS::FileAccessMode::Write);
+        const auto body = m_data.subspan(sizeof(Header));
+        if (!file.IsOpen() || !file.WriteObject(header) || file.WriteSpan(body) != body.size()) {
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+std::string_view Database::Serial(u32 index) const {
+    const char* serial = m_entries[index].serial;
+    return {serial, strnlen(serial, SerialSize)};
+}
+
+std::string_view Database::String(u32 id) const {
+    if (id >= m_string_count) {
+        return {};
+    }
+    const u32 begin = m_string_offsets[id];
+    const u32 end = std::max(begin, std::min(m_string_offsets[id + 1], m_strings_size));
+    return {m_strings + begin, end - begin};
+}
+
+Database::Record Database::RecordAt(u32 index) const {
+    const Entry& entry = m_entries[index];
+    return {entry.status, String(entry.last_tested_date), String(entry.latest_version),
+            String(entry.issue_number)};
+}
+
+std::optional<Database::Record> Database::Find(std::string_view serial) const {
+    if (m_entry_count == 0) {
+        return std::nullopt;
+    }
+    u32 bucket = HashSerial(serial) & (m_bucket_count - 1);
+    for (u32 probe = 0; probe < m_bucket_count; ++probe) {
+        const u32 slot = m_buckets[bucket];
+        if (slot == EmptyBucket || slot > m_entry_count) {
+            break;
+        }
+        if (Serial(slot - 1) == serial) {
+            return RecordAt(slot - 1);
+        }
+        bucket = (bucket + 1) & (m_bucket_count - 1);
+    }
+    return std::nullopt;
+}
+
+std::vector<std::string> Database::Diff(const Database* before, const Database& after) {
+    std::vector<std::string> changed;
+    const u32 before_count = before ? before->m_entry_count : 0;
+    u32 i = 0;
+    u32 j = 0;
+    // Both entry arrays are sorted by serial, so this is a single merge pass.
+    while (i < before_count || j < after.m_entry_count) {
+        if (j == after.m_entry_count ||
+            (i < before_count && before->Serial(i) < after.Serial(j))) {
+            changed.emplace_back(before->Serial(i++));
+        } else if (i == before_count || after.Serial(j) < before->Serial(i)) {
+            changed.emplace_back(after.Serial(j++));
+        } else {
+            if (before->RecordAt(i) != after.RecordAt(j)) {
+                changed.emplace_back(after.Serial(j));
+            }
+            ++i;
+            ++j;
+        }
+    }
+    return changed;
+}
+
+} // namespace Compat
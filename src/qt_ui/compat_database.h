@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "common/mapped_file.h"
+#include "common/types.h"
+
+namespace Compat {
+
+/// Identifies the compatibility_data.json a Database was built from.
+struct SourceStamp {
+    u64 size = 0;
+    s64 mtime = 0;
+    u64 hash = 0; ///< FNV-1a of the JSON text
+
+    bool operator==(const SourceStamp&) const = default;
+};
+
+/**
+ * Immutable compatibility database for one platform in a compact binary layout: entries
+ * sorted by serial, an open addressing hash index over them and a table of interned strings
+ * (dates and versions repeat a lot). The same bytes are used in memory and on disk, so a cached
+ * database is memory-mapped instead of parsed.
+ */
+class Database {
+public:
+    struct Record {
+        u8 status = 0; ///< Compat::Status::index
+        std::string_view last_tested_date;
+        std::string_view latest_version;
+        std::string_view issue_number;
+
+        bool operator==(const Record&) const = default;
+    };
+
+    class Builder {
+    public:
+        void Add(std::string_view serial, u8 status, std::string_view last_tested_date,
+                 std::string_view latest_version, std::string_view issue_number);
+        std::shared_ptr<const Database> Build(const SourceStamp& source);
+
+    private:
+        struct Pending {
+            u8 status;
+            u32 last_tested_date;
+            u32 latest_version;
+            u32 issue_number;
+        };
+        u32 Intern(std::string_view text);
+
+        std::map<std::string, Pending, std::less<>> m_entries;
+        std::vector<std::string> m_strings{""};
+        std::unordered_map<std::string, u32> m_string_ids{{"", 0}};
+    };
+
+    /// Maps a database written by Write, nullptr if it is missing or malformed.
+    static std::shared_ptr<const Database> Open(const std::filesystem::path& path);
+
+    /// Writes to a temporary file and renames it over path. A given source replaces the stored
+    /// one, for a cache whose JSON was rewritten with the same content.
+    bool Write(const std::filesystem::path& path,
+               const std::optional<SourceStamp>& source = std::nullopt) const;
+
+    std::optional<Record> Find(std::string_view serial) const;
+
+    u32 Size() const {
+        return m_entry_count;
+    }
+
+    const SourceStamp& GetSource() const {
+        return m_source;
+    }
+
+    /// Serials added, removed or changed between two databases.
+    static std::vector<std::string> Diff(const Database* before, const Database& after);
+
+    static u64 Hash(std::span<const u8> data);
+
+private:
+    struct Header;
+    struct Entry;
+
+    bool Parse(std::span<const u8> data);
+    std::string_view Serial(u32 index) const;
+    Record RecordAt(u32 index) const;
+    std::string_view String(u32 id) const;
+
+    std::vector<u8> m_buffer;
+    Common::FS::MappedFile m_file;
+    std::span<const u8> m_data;
+
+    SourceStamp m_source;
+    u32 m_entry_count = 0;
+    u32 m_bucket_count = 0;
+    u32 m_string_count = 0;
+    const Entry* m_entries = nullptr;
+    const u32* m_buckets = nullptr;
+    const u32* m_string_offsets = nullptr;
+    const char* m_strings = nullptr;
+    u32 m_strings_size = 0;
+};
+
+} // namespace Compat
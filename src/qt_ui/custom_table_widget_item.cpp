@@ -23,6 +23,31 @@ CustomTableWidgetItem::CustomTableWidgetItem(const QString& text, int sort_role,
 }
 
 bool CustomTableWidgetItem::operator<(const QTableWidgetItem& other) const {
+    if (m_sort_game) {
+        const auto* other_item = dynamic_cast<const CustomTableWidgetItem*>(&other);
+        if (other_item && other_item->m_sort_game && other_item->m_sort_column == m_sort_column) {
+            const GUIGameInfo& l = *m_sort_game;
+            const GUIGameInfo& r = *other_item->m_sort_game;
+            switch (m_sort_column) {
+            case GUI::GameListColumns::name:
+                if (l.sort_keys.title && r.sort_keys.title) {
+                    return l.sort_keys.title->compare(*r.sort_keys.title) < 0;
+                }
+                break;
+            case GUI::GameListColumns::serial:
+                return l.info.serial < r.info.serial;
+            case GUI::GameListColumns::last_play:
+                return l.sort_keys.last_played < r.sort_keys.last_played;
+            case GUI::GameListColumns::play_time:
+                return l.sort_keys.playtime < r.sort_keys.playtime;
+            case GUI::GameListColumns::dir_size:
+                return l.info.size_on_disk < r.info.size_on_disk;
+            default:
+                break;
+            }
+        }
+    }
+
     if (m_sort_role == Qt::DisplayRole) {
         return QTableWidgetItem::operator<(other);
     }
@@ -58,6 +83,11 @@ bool CustomTableWidgetItem::operator<(const QTableWidgetItem& other) const {
     }
 }
 
+void CustomTableWidgetItem::SetSortKey(game_info game, GUI::GameListColumns column) {
+    m_sort_game = std::move(game);
+    m_sort_column = column;
+}
+
 void CustomTableWidgetItem::setData(int role, const QVariant& value, bool assign_sort_role) {
     if (assign_sort_role) {
         m_sort_role = role;
@@ -5,10 +5,14 @@
 #pragma once
 
 #include "game_item.h"
+#include "gui_game_info.h"
+#include "gui_settings.h"
 
 class CustomTableWidgetItem : public GameItem {
 private:
     int m_sort_role = Qt::DisplayRole;
+    game_info m_sort_game;
+    GUI::GameListColumns m_sort_column{};
 
 public:
     using QTableWidgetItem::setData;
@@ -22,4 +26,7 @@ public:
     bool operator<(const QTableWidgetItem& other) const override;
 
     void setData(int role, const QVariant& value, bool assign_sort_role);
+
+    /** Sorts by the precomputed keys of the game for this column instead of the item data */
+    void SetSortKey(game_info game, GUI::GameListColumns column);
 };
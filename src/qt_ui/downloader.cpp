@@ -9,11 +9,12 @@
 #include <QTimer>
 #include "downloader.h"
 #include "gui_settings.h"
+#include "network_service.h"
 #include "progress_dialog.h"
 
 Downloader::Downloader(std::shared_ptr<GUISettings> gui_settings, std::optional<GUISave> etag,
                        std::optional<GUISave> last_modified, QWidget* parent)
-    : QObject(parent), m_manager(new QNetworkAccessManager(this)), m_parent(parent),
+    : QObject(parent), m_manager(NetworkService::instance().GetManager()), m_parent(parent),
       m_gui_settings(std::move(gui_settings)), m_etag(std::move(etag)),
       m_last_modified(std::move(last_modified)) {}
 
@@ -72,30 +73,71 @@ void Downloader::DownloadJSONWithCache(const std::string& url, const QString& lo
     connect(m_reply, &QNetworkReply::errorOccurred, this, &Downloader::OnError);
 
     // --- Optional progress dialog
-    if (show_progress_dialog) {
-        const int maximum = 100;
-        if (!m_progress_dialog) {
-            m_progress_dialog = new ProgressDialog(progress_dialog_title, tr("Please wait..."),
-                                                   tr("Abort"), 0, maximum, true, m_parent);
-            m_progress_dialog->setAutoClose(true);
-            m_progress_dialog->setAutoReset(false);
-            m_progress_dialog->show();
-
-            connect(m_progress_dialog, &QProgressDialog::canceled, this, [this]() {
-                m_abort = true;
-                if (m_reply)
-                    m_reply->abort();
-                m_progress_dialog = nullptr;
-                Q_EMIT SignalDownloadCanceled();
-            });
+    if (show_progress_dialog)
+        ShowProgressDialog(progress_dialog_title);
+}
 
-            connect(m_progress_dialog, &QProgressDialog::finished, this,
-                    [this]() { m_progress_dialog = nullptr; });
-        } else {
-            m_progress_dialog->setWindowTitle(progress_dialog_title);
-            m_progress_dialog->SetRange(0, maximum);
-            m_progress_dialog->show();
-        }
+void Downloader::DownloadFile(const std::string& url, const QString& local_path,
+                              const QByteArray& sha256, qint64 expected_size,
+                              bool show_progress_dialog, const QString& progress_dialog_title) {
+    m_localPath = local_path;
+    m_abort = false;
+
+    if (!m_file_download) {
+        m_file_download = new FileDownload(m_manager, this);
+        connect(m_file_download, &FileDownload::Progress, this,
+                [this](qint64 received, qint64 total) {
+                    // In KiB, the dialog range is an int
+                    if (m_progress_dialog && total > 0) {
+                        m_progress_dialog->SetRange(0, static_cast<int>(total / 1024));
+                        m_progress_dialog->SetValue(static_cast<int>(received / 1024));
+                    }
+                });
+        connect(m_file_download, &FileDownload::Finished, this, [this]() {
+            if (m_progress_dialog)
+                CloseProgressDialog();
+            Q_EMIT SignalDownloadFinished(QByteArray());
+        });
+        connect(m_file_download, &FileDownload::Failed, this, [this](const QString& error) {
+            if (m_progress_dialog)
+                CloseProgressDialog();
+            Q_EMIT SignalDownloadError(error);
+        });
+    }
+
+    if (show_progress_dialog)
+        ShowProgressDialog(progress_dialog_title);
+
+    m_file_download->Start(QUrl(QString::fromStdString(url)), local_path,
+                           FileDownload::Options{.expected_size = expected_size, .sha256 = sha256});
+}
+
+void Downloader::ShowProgressDialog(const QString& title) {
+    const int maximum = 100;
+    if (!m_progress_dialog) {
+        m_progress_dialog = new ProgressDialog(title, tr("Please wait..."), tr("Abort"), 0, maximum,
+                                               true, m_parent);
+        m_progress_dialog->setAutoClose(true);
+        m_progress_dialog->setAutoReset(false);
+        m_progress_dialog->show();
+
+        connect(m_progress_dialog, &QProgressDialog::canceled, this, [this]() {
+            m_abort = true;
+            if (m_reply)
+                m_reply->abort();
+            // Keeps the .part file, the next download of the same URL resumes it
+            if (m_file_download)
+                m_file_download->Abort();
+            m_progress_dialog = nullptr;
+            Q_EMIT SignalDownloadCanceled();
+        });
+
+        connect(m_progress_dialog, &QProgressDialog::finished, this,
+                [this]() { m_progress_dialog = nullptr; });
+    } else {
+        m_progress_dialog->setWindowTitle(title);
+        m_progress_dialog->SetRange(0, maximum);
+        m_progress_dialog->show();
     }
 }
 
@@ -8,6 +8,7 @@
 #include <QNetworkReply>
 #include <QObject>
 #include <QPointer>
+#include "file_download.h"
 #include "gui_save.h"
 
 class GUISettings;
@@ -26,6 +27,14 @@ public:
                                bool show_progress_dialog = true,
                                const QString& progress_dialog_title = QString(), int delayMs = 0);
 
+    /// Streams a large file to local_path, resuming what an earlier call left in its .part file.
+    /// SignalDownloadFinished carries no data, the file is only renamed in place once its size
+    /// and sha256 (hex, if not empty) check out.
+    void DownloadFile(const std::string& url, const QString& local_path,
+                      const QByteArray& sha256 = {}, qint64 expected_size = -1,
+                      bool show_progress_dialog = true,
+                      const QString& progress_dialog_title = QString());
+
     void CloseProgressDialog(int delayMs = 0);
     ProgressDialog* GetProgressDialog() const;
 
@@ -42,6 +51,8 @@ private slots:
     void OnError(QNetworkReply::NetworkError code);
 
 private:
+    void ShowProgressDialog(const QString& title);
+
     QString m_localPath;
     std::shared_ptr<GUISettings> m_gui_settings;
     QByteArray m_data;
@@ -51,6 +62,7 @@ private:
 
     ProgressDialog* m_progress_dialog = nullptr;
     QNetworkReply* m_reply = nullptr;
+    FileDownload* m_file_download = nullptr;
     QNetworkAccessManager* m_manager = nullptr;
     QWidget* m_parent = nullptr;
     std::optional<GUISave> m_etag;
@@ -0,0 +1,452 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QSaveFile>
+#include <QTimer>
+#include "common/path_util.h"
+#include "file_download.h"
+
+namespace {
+
+// Progress received since the state was last saved, that a crash would make download again
+constexpr qint64 StateSaveInterval = 4 * 1024 * 1024;
+
+QString StatePath(const QString& local_path) {
+    return FileDownload::PartPath(local_path) + ".json";
+}
+
+// "bytes <first>-<last>/<total>", the total being "*" when unknown
+bool ParseContentRange(const QByteArray& value, qint64& first, qint64& total) {
+    const QByteArray range = value.trimmed();
+    if (!range.startsWith("bytes ")) {
+        return false;
+    }
+    const qsizetype dash = range.indexOf('-');
+    const qsizetype slash = range.indexOf('/');
+    if (dash < 0 || slash < dash) {
+        return false;
+    }
+    bool ok = false;
+    first = range.mid(6, dash - 6).toLongLong(&ok);
+    if (!ok) {
+        return false;
+    }
+    const QByteArray size = range.mid(slash + 1);
+    total = size == "*" ? -1 : size.toLongLong(&ok);
+    return ok;
+}
+
+} // namespace
+
+FileDownload::FileDownload(QNetworkAccessManager* manager, QObject* parent)
+    : QObject(parent), m_manager(manager) {}
+
+FileDownload::~FileDownload() {
+    if (m_running) {
+        Abort();
+    }
+}
+
+QString FileDownload::PartPath(const QString& local_path) {
+    return local_path + ".part";
+}
+
+void FileDownload::DiscardPart(const QString& local_path) {
+    QFile::remove(PartPath(local_path));
+    QFile::remove(StatePath(local_path));
+}
+
+void FileDownload::Start(const QUrl& url, const QString& local_path, const Options& options) {
+    if (m_running) {
+        Abort();
+    }
+    m_url = url;
+    m_local_path = local_path;
+    m_options = options;
+    m_part.setFileName(PartPath(local_path));
+    const quint64 start = ++m_starts;
+
+    // An outcome known right away is reported from the event loop, so the caller can connect to
+    // the signals after Start
+    const bool resumed = LoadState();
+    if (!m_part.open(QIODevice::ReadWrite)) {
+        m_running = true;
+        QMetaObject::invokeMethod(
+            this,
+            [this, start] {
+                if (m_running && m_starts == start) {
+                    Fail(tr("Cannot write output file."));
+                }
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+    if (resumed) {
+        qDebug() << "FileDownload: Resuming" << m_local_path << "at" << Received() << "bytes";
+    } else {
+        Restart();
+    }
+
+    m_running = true;
+    if (std::ranges::all_of(m_segments, &Segment::IsComplete)) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, start] {
+                if (m_running && m_starts == start) {
+                    Complete();
+                }
+            },
+            Qt::QueuedConnection);
+        return;
+    }
+    for (size_t i = 0; i < m_segments.size(); ++i) {
+        if (!m_segments[i].IsComplete()) {
+            Request(i);
+        }
+    }
+}
+
+void FileDownload::Abort() {
+    if (!m_running) {
+        return;
+    }
+    m_running = false;
+    DropReplies();
+    SaveState();
+    m_part.close();
+}
+
+bool FileDownload::LoadState() {
+    m_total = -1;
+    m_validator.clear();
+    m_segments.clear();
+
+    QFile file(StatePath(m_local_path));
+    if (!m_part.exists() || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QJsonObject state = QJsonDocument::fromJson(file.readAll()).object();
+    if (state["url"].toString() != m_url.toString()) {
+        return false;
+    }
+
+    const qint64 part_size = m_part.size();
+    for (const QJsonValue& value : state["segments"].toArray()) {
+        const QJsonArray segment = value.toArray();
+        Segment loaded{
+            .begin = segment[0].toInteger(),
+            .end = segment[1].toInteger(),
+            .done = segment[2].toInteger(),
+        };
+        if (loaded.done < 0 || (loaded.end >= 0 && loaded.Next() > loaded.end) ||
+            loaded.Next() > part_size) {
+            m_segments.clear();
+            return false;
+        }
+        m_segments.push_back(loaded);
+    }
+    m_total = state["total"].toInteger(-1);
+    m_validator = state["validator"].toString().toUtf8();
+    return !m_segments.empty();
+}
+
+void FileDownload::SaveState() {
+    // What SaveState records as done must be on disk first
+    if (!m_part.isOpen() || !m_part.flush()) {
+        return;
+    }
+    QJsonArray segments;
+    for (const Segment& segment : m_segments) {
+        segments.append(QJsonArray{segment.begin, segment.end, segment.done});
+    }
+    const QJsonObject state{
+        {"url", m_url.toString()},
+        {"total", m_total},
+        {"validator", QString::fromUtf8(m_validator)},
+        {"segments", segments},
+    };
+
+    QSaveFile file(StatePath(m_local_path));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(QJsonDocument(state).toJson(QJsonDocument::Compact));
+        file.commit();
+    }
+    m_saved_at = Received();
+}
+
+void FileDownload::Restart() {
+    DropReplies();
+    m_part.resize(0);
+    QFile::remove(StatePath(m_local_path));
+    m_total = -1;
+    m_validator.clear();
+    m_saved_at = 0;
+    m_segments = {Segment{.begin = 0, .end = -1, .done = 0}};
+}
+
+void FileDownload::Request(size_t index) {
+    Segment& segment = m_segments[index];
+    QNetworkRequest request(m_url);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+    // Ranges of large files have no place in the HTTP cache of a shared manager
+    request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+    // Also asked for a fresh download, a 206 tells the server can resume and split it
+    QByteArray range = "bytes=" + QByteArray::number(segment.Next()) + "-";
+    if (segment.end >= 0) {
+        range += QByteArray::number(segment.end - 1);
+    }
+    request.setRawHeader("Range", range);
+    if (!m_validator.isEmpty()) {
+        request.setRawHeader("If-Range", m_validator);
+    }
+
+    segment.accepted = false;
+    segment.reply = m_manager->get(request);
+    QNetworkReply* reply = segment.reply;
+    connect(reply, &QNetworkReply::metaDataChanged, this, [this, index] { OnMetaData(index); });
+    connect(reply, &QNetworkReply::readyRead, this, [this, index] { OnReadyRead(index); });
+    connect(reply, &QNetworkReply::finished, this, [this, index] { OnFinished(index); });
+}
+
+void FileDownload::OnMetaData(size_t index) {
+    Segment& segment = m_segments[index];
+    QNetworkReply* reply = segment.reply;
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (segment.accepted || (status >= 300 && status < 400)) {
+        return;
+    }
+
+    if (status == 206) {
+        qint64 first = 0;
+        qint64 total = -1;
+        if (!ParseContentRange(reply->rawHeader("Content-Range"), first, total) ||
+            first != segment.Next() || (m_total >= 0 && total != m_total)) {
+            Fail(tr("Unexpected Content-Range from the server."));
+            return;
+        }
+        if (m_total < 0) {
+            m_total = total;
+        }
+        if (segment.end < 0) {
+            segment.end = m_total;
+        }
+    } else if (status == 200) {
+        // Ranges not supported, or the file changed since the part was written
+        if (segment.Next() != 0 || m_segments.size() != 1) {
+            qDebug() << "FileDownload: Server sent the whole file, restarting" << m_local_path;
+            m_options.max_segments = 1;
+            Restart();
+            Request(0);
+            return;
+        }
+        m_total = reply->header(QNetworkRequest::ContentLengthHeader).toLongLong();
+        if (m_total <= 0) {
+            m_total = -1;
+        }
+        segment.end = m_total;
+    } else if (status == 416) {
+        // The part is not a prefix of what the server has anymore
+        m_options.max_segments = 1;
+        Restart();
+        Request(0);
+        return;
+    } else {
+        if (status != 0) {
+            qWarning() << "HTTP error" << status << "on URL:" << reply->url();
+            Fail(QString("HTTP error %1").arg(status));
+        }
+        return;
+    }
+    segment.accepted = true;
+
+    if (m_validator.isEmpty()) {
+        // A weak ETag cannot be used with If-Range
+        const QByteArray etag = reply->rawHeader("ETag");
+        m_validator = etag.startsWith("W/") ? reply->rawHeader("Last-Modified") : etag;
+    }
+    if (status == 206 && m_segments.size() == 1 && segment.Next() == 0) {
+        Split();
+    }
+}
+
+void FileDownload::Split() {
+    const qint64 min_size = std::max<qint64>(m_options.min_segment_size, 1);
+    const qint64 count = std::min<qint64>(m_options.max_segments, m_total / min_size);
+    if (count < 2) {
+        return;
+    }
+    // The running request keeps the first range and is dropped once it reaches its end
+    const qint64 size = m_total / count;
+    m_segments[0].end = size;
+    for (qint64 i = 1; i < count; ++i) {
+        m_segments.push_back(Segment{
+            .begin = i * size,
+            .end = i == count - 1 ? m_total : (i + 1) * size,
+            .done = 0,
+        });
+    }
+    m_part.resize(m_total);
+    SaveState();
+    for (size_t i = 1; i < m_segments.size(); ++i) {
+        Request(i);
+    }
+}
+
+void FileDownload::OnReadyRead(size_t index) {
+    Segment& segment = m_segments[index];
+    QNetworkReply* reply = segment.reply;
+    if (!segment.accepted) {
+        reply->readAll();
+        return;
+    }
+
+    QByteArray data = reply->readAll();
+    if (segment.end >= 0) {
+        data.truncate(std::max<qint64>(segment.end - segment.Next(), 0));
+    }
+    if (data.isEmpty()) {
+        return;
+    }
+    if (!m_part.seek(segment.Next()) || m_part.write(data) != data.size()) {
+        Fail(tr("Cannot write output file."));
+        return;
+    }
+    segment.done += data.size();
+    segment.retries = 0;
+
+    if (Received() - m_saved_at >= StateSaveInterval) {
+        SaveState();
+    }
+
+    if (segment.IsComplete()) {
+        // The first request of a split download goes on past its range
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+        segment.reply = nullptr;
+        if (std::ranges::all_of(m_segments, &Segment::IsComplete)) {
+            Complete();
+            return;
+        }
+    }
+    Q_EMIT Progress(Received(), m_total);
+}
+
+void FileDownload::OnFinished(size_t index) {
+    Segment& segment = m_segments[index];
+    if (segment.accepted && segment.reply->bytesAvailable() > 0) {
+        OnReadyRead(index);
+        if (!segment.reply) {
+            return;
+        }
+    }
+    QNetworkReply* reply = segment.reply;
+    segment.reply = nullptr;
+    reply->deleteLater();
+
+    if (reply->error() == QNetworkReply::NoError && segment.accepted) {
+        if (segment.end < 0) {
+            // Size unknown until the end of the stream
+            segment.end = segment.Next();
+            m_total = segment.end;
+        }
+        if (segment.IsComplete()) {
+            if (std::ranges::all_of(m_segments, &Segment::IsComplete)) {
+                Complete();
+            }
+            return;
+        }
+    }
+
+    // Dropped connection, resume the range where it stopped
+    if (segment.retries >= m_options.max_retries) {
+        Fail(reply->error() != QNetworkReply::NoError ? reply->errorString()
+                                                      : tr("Connection closed early."));
+        return;
+    }
+    ++segment.retries;
+    qDebug() << "FileDownload: Range" << segment.begin << "stopped at" << segment.Next()
+             << "retrying:" << reply->errorString();
+    SaveState();
+    QTimer::singleShot(m_options.retry_delay_ms, this, [this, index] {
+        if (m_running && index < m_segments.size() && !m_segments[index].reply &&
+            !m_segments[index].IsComplete()) {
+            Request(index);
+        }
+    });
+}
+
+void FileDownload::Complete() {
+    m_running = false;
+    DropReplies();
+    m_part.flush();
+
+    const qint64 size = m_part.size();
+    const qint64 expected = m_options.expected_size >= 0 ? m_options.expected_size : m_total;
+    QString error;
+    if (expected >= 0 && size != expected) {
+        error = tr("Downloaded %1 bytes, expected %2.").arg(size).arg(expected);
+    } else if (!m_options.sha256.isEmpty()) {
+        QCryptographicHash hash(QCryptographicHash::Sha256);
+        m_part.seek(0);
+        hash.addData(&m_part);
+        if (hash.result().toHex() != m_options.sha256.toLower()) {
+            error = tr("Checksum mismatch.");
+        }
+    }
+    m_part.close();
+    if (!error.isEmpty()) {
+        qWarning() << "FileDownload:" << error << m_local_path;
+        DiscardPart(m_local_path);
+        Q_EMIT Failed(error);
+        return;
+    }
+
+    QFile::remove(StatePath(m_local_path));
+    std::error_code ec;
+    std::filesystem::rename(Common::FS::PathFromQString(m_part.fileName()),
+                            Common::FS::PathFromQString(m_local_path), ec);
+    if (ec) {
+        Q_EMIT Failed(tr("Cannot write output file."));
+        return;
+    }
+    Q_EMIT Finished();
+}
+
+void FileDownload::Fail(const QString& error) {
+    m_running = false;
+    DropReplies();
+    SaveState();
+    m_part.close();
+    Q_EMIT Failed(error);
+}
+
+void FileDownload::DropReplies() {
+    for (Segment& segment : m_segments) {
+        if (segment.reply) {
+            segment.reply->disconnect(this);
+            segment.reply->abort();
+            segment.reply->deleteLater();
+            segment.reply = nullptr;
+        }
+    }
+}
+
+qint64 FileDownload::Received() const {
+    qint64 received = 0;
+    for (const Segment& segment : m_segments) {
+        received += segment.done;
+    }
+    return received;
+}
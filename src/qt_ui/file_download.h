@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+#include <QByteArray>
+#include <QFile>
+#include <QNetworkReply>
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+
+class QNetworkAccessManager;
+
+/**
+ * Downloads a file straight to disk. The data goes to <path>.part as it arrives and the progress
+ * to <path>.part.json, so an interrupted download resumes with HTTP Range requests, in a later
+ * session too. Large files are fetched as several byte ranges in parallel when the server
+ * supports it. The size and the SHA-256, when known, are checked before <path>.part is renamed
+ * over <path>.
+ */
+class FileDownload : public QObject {
+    Q_OBJECT
+public:
+    struct Options {
+        qint64 expected_size = -1; ///< Checked when not negative
+        QByteArray sha256;         ///< Hex digest, checked when not empty
+        int max_segments = 4;      ///< Parallel ranges for a large file
+        qint64 min_segment_size = 8 * 1024 * 1024;
+        int max_retries = 3; ///< Per range, each retry resumes where the range stopped
+        int retry_delay_ms = 1000;
+    };
+
+    explicit FileDownload(QNetworkAccessManager* manager, QObject* parent = nullptr);
+    ~FileDownload() override;
+
+    /// Never emits Finished or Failed before it returns.
+    void Start(const QUrl& url, const QString& local_path, const Options& options);
+
+    /// Stops the transfer, what was received is kept for a later Start.
+    void Abort();
+
+    bool IsRunning() const {
+        return m_running;
+    }
+
+    /// Path of the partial download of local_path.
+    static QString PartPath(const QString& local_path);
+
+    /// Deletes the partial download of local_path.
+    static void DiscardPart(const QString& local_path);
+
+signals:
+    void Progress(qint64 received, qint64 total);
+    void Finished();
+    void Failed(const QString& error);
+
+private:
+    struct Segment {
+        qint64 begin;
+        qint64 end; ///< Exclusive, -1 while the size is unknown
+        qint64 done;
+        int retries = 0;
+        bool accepted = false; ///< The response of the current request is for this range
+        QPointer<QNetworkReply> reply;
+
+        qint64 Next() const {
+            return begin + done;
+        }
+        bool IsComplete() const {
+            return end >= 0 && Next() >= end;
+        }
+    };
+
+    bool LoadState();
+    void SaveState();
+    void Restart();
+    void Request(size_t index);
+    void OnMetaData(size_t index);
+    void OnReadyRead(size_t index);
+    void OnFinished(size_t index);
+    void Split();
+    void Complete();
+    void Fail(const QString& error);
+    void DropReplies();
+    qint64 Received() const;
+
+    QNetworkAccessManager* m_manager;
+    QUrl m_url;
+    QString m_local_path;
+    Options m_options;
+    QFile m_part;
+    qint64 m_total = -1;
+    QByteArray m_validator; ///< ETag or Last-Modified, sent as If-Range
+    bool m_running = false;
+    quint64 m_starts = 0; ///< Tells a deferred outcome of a Start from that of a later one
+    qint64 m_saved_at = 0;
+    std::vector<Segment> m_segments;
+};
@@ -121,10 +121,10 @@ int FlowLayout::doLayout(const QRect& rect, bool testOnly) const {
         const int min_spacing = smartSpacing(QStyle::PM_LayoutHorizontalSpacing);
         bool fits_into_width = true;
         int width = 0;
-        int index = 0;
+        int visible_count = 0;
 
-        for (; index < m_item_list.size(); index++) {
-            if (QLayoutItem* item = m_item_list.at(index)) {
+        for (int index = 0; index < m_item_list.size(); index++) {
+            if (QLayoutItem* item = m_item_list.at(index); item && !item->isEmpty()) {
                 const int new_width =
                     width + item->sizeHint().width() + (width > 0 ? min_spacing : 0);
 
@@ -134,11 +134,12 @@ int FlowLayout::doLayout(const QRect& rect, bool testOnly) const {
                 }
 
                 width = new_width;
+                visible_count++;
             }
         }
 
         // Try to evenly distribute the items across the width
-        m_h_space = (index == 0) ? -1 : ((available_width - width) / index);
+        m_h_space = (visible_count == 0) ? -1 : ((available_width - width) / visible_count);
 
         if (fits_into_width) {
             // Make sure there aren't huge gaps between the items
@@ -157,6 +158,12 @@ int FlowLayout::doLayout(const QRect& rect, bool testOnly) const {
         if (!wid)
             continue;
 
+        // Hidden items (filtered by the search bar) take no space and can't be navigated to
+        if (wid->isHidden()) {
+            m_positions[i] = position{.row = -1, .col = -1};
+            continue;
+        }
+
         int spaceX = horizontalSpacing();
         if (spaceX == -1)
             spaceX = wid->style()->layoutSpacing(QSizePolicy::PushButton, QSizePolicy::PushButton,
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <common/path_util.h>
 #include "downloader.h"
 #include "game_compatibility.h"
@@ -8,19 +11,99 @@
 
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QJsonObject>
+#include <QtConcurrent>
+
+namespace {
+// Status keys by Compat::Status::index, the binary database stores the index.
+constexpr std::array<const char*, 6> StatusKeys = {"Playable", "Ingame",  "Menus",
+                                                   "Boots",    "Nothing", "NoResult"};
+
+std::string_view ToStringView(const QByteArray& bytes) {
+    return {bytes.constData(), static_cast<size_t>(bytes.size())};
+}
+
+QString ToQString(std::string_view text) {
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+// Caches are written as compatibility_data.<generation>.bin instead of over one file. A database
+// in use keeps its file mapped, and Windows refuses to replace a file while it is mapped.
+constexpr std::string_view CachePrefix = "compatibility_data.";
+constexpr std::string_view CacheSuffix = ".bin";
+
+std::optional<u64> CacheGeneration(const std::filesystem::path& path) {
+    const std::string name = path.filename().string();
+    if (name.size() <= CachePrefix.size() + CacheSuffix.size() || !name.starts_with(CachePrefix) ||
+        !name.ends_with(CacheSuffix)) {
+        return std::nullopt;
+    }
+    const std::string_view digits = std::string_view(name).substr(
+        CachePrefix.size(), name.size() - CachePrefix.size() - CacheSuffix.size());
+    u64 generation = 0;
+    const auto [ptr, ec] =
+        std::from_chars(digits.data(), digits.data() + digits.size(), generation);
+    if (ec != std::errc{} || ptr != digits.data() + digits.size()) {
+        return std::nullopt;
+    }
+    return generation;
+}
+
+/// Cache files by generation, newest first.
+std::vector<std::pair<u64, std::filesystem::path>> ListCaches(const std::filesystem::path& dir) {
+    std::vector<std::pair<u64, std::filesystem::path>> caches;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (const auto generation = CacheGeneration(entry.path())) {
+            caches.emplace_back(*generation, entry.path());
+        }
+    }
+    std::sort(caches.begin(), caches.end(), std::greater{});
+    return caches;
+}
+} // namespace
 
 GameCompatibility::GameCompatibility(std::shared_ptr<GUISettings> gui_settings, QWidget* parent)
     : QObject(parent), m_gui_settings(std::move(gui_settings)) {
-    const std::filesystem::path compat_path =
-        Common::FS::GetUserPath(Common::FS::PathType::UserDir) / "compatibility_data.json";
+    const auto user_dir = Common::FS::GetUserPath(Common::FS::PathType::UserDir);
+    m_json_path = user_dir / "compatibility_data.json";
+    m_cache_dir = user_dir;
 #ifdef _WIN32
-    m_filepath = QString::fromStdWString(compat_path.wstring()); // UTF-16 Windows
+    m_filepath = QString::fromStdWString(m_json_path.wstring()); // UTF-16 Windows
 #else
-    m_filepath = QString::fromUtf8(compat_path.u8string().c_str()); // UTF-8 Linux/macOS
+    m_filepath = QString::fromUtf8(m_json_path.u8string().c_str()); // UTF-8 Linux/macOS
 #endif
 
     m_downloader = new Downloader(m_gui_settings, GUI::compatibility_etag,
                                   GUI::compatibility_last_modified, parent);
+
+    connect(&m_load_watcher, &QFutureWatcher<DatabasePtr>::finished, this, [this]() {
+        // A download that finished first already installed a newer database.
+        if (GetDatabase()) {
+            return;
+        }
+        SetDatabase(m_load_watcher.result());
+        Q_EMIT DatabaseLoaded();
+    });
+    connect(&m_update_watcher, &QFutureWatcher<DatabasePtr>::finished, this, [this]() {
+        DatabasePtr database = m_update_watcher.result();
+        if (!database) {
+            qDebug() << "Database Error - Empty JSON root";
+            Q_EMIT DownloadError(tr("Error Downloading Compatibility Database"));
+            return;
+        }
+
+        const DatabasePtr current = GetDatabase();
+        if (database != current) {
+            const auto changed = Compat::Database::Diff(current.get(), *database);
+            qDebug() << "Compatibility database updated," << changed.size() << "of"
+                     << database->Size() << "entries changed";
+            SetDatabase(std::move(database));
+        }
+        // We have a new database, therefore refresh gamelist to new state
+        Q_EMIT DownloadFinished();
+    });
+
     RequestCompatibility();
 
     connect(m_downloader, &Downloader::SignalDownloadError, this,
@@ -32,46 +115,56 @@ GameCompatibility::GameCompatibility(std::shared_ptr<GUISettings> gui_settings,
 }
 
 Compat::Status GameCompatibility::GetCompatibility(const std::string& title_id) {
-    if (m_compat_database.empty()) {
+    const DatabasePtr database = GetDatabase();
+    if (!database || database->Size() == 0) {
         return m_status_data.at("NoData");
     }
 
-    if (const auto it = m_compat_database.find(title_id); it != m_compat_database.cend()) {
-        return it->second;
+    const auto record = database->Find(title_id);
+    if (!record || record->status >= StatusKeys.size()) {
+        return m_status_data.at("NoResult");
     }
 
-    return m_status_data.at("NoResult");
+    Compat::Status status = m_status_data.at(StatusKeys[record->status]);
+    status.last_tested_date = ToQString(record->last_tested_date);
+    status.latest_version = ToQString(record->latest_version);
+    status.issue_number = ToQString(record->issue_number);
+    return status;
 }
 
 Compat::Status GameCompatibility::GetStatusData(const QString& status) const {
     return m_status_data.at(status);
 }
 
-void GameCompatibility::HandleDownloadFinished(const QByteArray& content) {
-    qDebug() << "Database download finished";
+GameCompatibility::DatabasePtr GameCompatibility::GetDatabase() {
+    std::scoped_lock lock{m_database_mutex};
+    return m_database;
+}
 
-    // Create new map from database and write database to file if database was valid
-    if (ReadJSON(QJsonDocument::fromJson(content).object(), true)) {
-        // Write database to file
-        QFile file(m_filepath);
+void GameCompatibility::SetDatabase(DatabasePtr database) {
+    std::scoped_lock lock{m_database_mutex};
+    m_database = std::move(database);
+}
 
-        if (file.exists()) {
-            qDebug() << "Database file found:" << m_filepath;
-        }
+void GameCompatibility::HandleDownloadFinished(const QByteArray& content) {
+    qDebug() << "Database download finished";
 
-        if (!file.open(QIODevice::WriteOnly)) {
-            qDebug() << "Could not write database to file:" << m_filepath;
-            return;
+    // The downloader already wrote the JSON to m_filepath. Parsing and building the binary
+    // database happens on a worker; an unchanged download keeps the current database.
+    const DatabasePtr current = GetDatabase();
+    m_update_watcher.setFuture(QtConcurrent::run([this, content, current]() -> DatabasePtr {
+        const auto bytes = std::span(reinterpret_cast<const u8*>(content.constData()),
+                                     static_cast<size_t>(content.size()));
+        Compat::SourceStamp source = GetSourceStamp();
+        source.hash = Compat::Database::Hash(bytes);
+        if (current && current->GetSource().hash == source.hash) {
+            if (!(current->GetSource() == source)) {
+                WriteCache(*current, source); // Same content, refresh the file stamp
+            }
+            return current;
         }
-
-        file.write(content);
-        file.close();
-
-        qDebug() << "Wrote database to file:" << m_filepath;
-    }
-
-    // We have a new database in map, therefore refresh gamelist to new state
-    Q_EMIT DownloadFinished();
+        return BuildDatabase(content, source);
+    }));
 }
 
 void GameCompatibility::HandleDownloadCanceled() {
@@ -84,27 +177,9 @@ void GameCompatibility::HandleDownloadError(const QString& error) {
 
 void GameCompatibility::RequestCompatibility(bool online) {
     if (!online) {
-        // Retrieve database from file
-        QFile file(m_filepath);
-
-        if (!file.exists()) {
-            qDebug() << "Database file not found:" << m_filepath;
-            return;
-        }
-
-        if (!file.open(QIODevice::ReadOnly)) {
-            qDebug() << "Could not read database from file:" << m_filepath;
-            return;
+        if (!m_load_watcher.isRunning()) {
+            m_load_watcher.setFuture(QtConcurrent::run([this] { return LoadDatabase(); }));
         }
-
-        const QByteArray content = file.readAll();
-        file.close();
-
-        qDebug() << "Finished reading database from file:" << m_filepath;
-
-        // Create new map from database
-        ReadJSON(QJsonDocument::fromJson(content).object(), online);
-
         return;
     }
     const std::string url =
@@ -118,7 +193,89 @@ void GameCompatibility::RequestCompatibility(bool online) {
     Q_EMIT DownloadStarted();
 }
 
-bool GameCompatibility::ReadJSON(const QJsonObject& json_data, bool after_download) {
+Compat::SourceStamp GameCompatibility::GetSourceStamp() const {
+    std::error_code ec;
+    Compat::SourceStamp source;
+    if (const auto size = std::filesystem::file_size(m_json_path, ec); !ec) {
+        source.size = size;
+    }
+    if (const auto mtime = std::filesystem::last_write_time(m_json_path, ec); !ec) {
+        source.mtime = mtime.time_since_epoch().count();
+    }
+    return source;
+}
+
+GameCompatibility::DatabasePtr GameCompatibility::OpenCache() const {
+    std::scoped_lock lock{m_cache_mutex};
+    DatabasePtr cached;
+    std::error_code ec;
+    for (const auto& [generation, path] : ListCaches(m_cache_dir)) {
+        if (!cached && (cached = Compat::Database::Open(path))) {
+            continue;
+        }
+        // Older generations are no longer mapped by anything at this point
+        std::filesystem::remove(path, ec);
+    }
+    std::filesystem::remove(m_cache_dir / "compatibility_data.bin", ec); // Unversioned name
+    return cached;
+}
+
+void GameCompatibility::WriteCache(const Compat::Database& database,
+                                   const std::optional<Compat::SourceStamp>& source) const {
+    std::scoped_lock lock{m_cache_mutex};
+    const auto caches = ListCaches(m_cache_dir);
+    const u64 generation = caches.empty() ? 0 : caches.front().first + 1;
+    const auto path = m_cache_dir / (std::string(CachePrefix) + std::to_string(generation) +
+                                     std::string(CacheSuffix));
+    if (!database.Write(path, source)) {
+        qDebug() << "Could not write compatibility database cache";
+        return;
+    }
+    // Fails on Windows for a generation still mapped, it goes on the next start
+    std::error_code ec;
+    for (const auto& [old_generation, old_path] : caches) {
+        std::filesystem::remove(old_path, ec);
+    }
+}
+
+GameCompatibility::DatabasePtr GameCompatibility::LoadDatabase() const {
+    DatabasePtr cached = OpenCache();
+    if (!QFile::exists(m_filepath)) {
+        if (!cached) {
+            qDebug() << "Database file not found:" << m_filepath;
+        }
+        return cached;
+    }
+
+    // Size and modification time match: the JSON is what the cache was built from.
+    Compat::SourceStamp source = GetSourceStamp();
+    if (cached && cached->GetSource().size == source.size &&
+        cached->GetSource().mtime == source.mtime) {
+        qDebug() << "Mapped compatibility database cache with" << cached->Size() << "entries";
+        return cached;
+    }
+
+    QFile file(m_filepath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Could not read database from file:" << m_filepath;
+        return cached;
+    }
+    const QByteArray content = file.readAll();
+    file.close();
+
+    qDebug() << "Finished reading database from file:" << m_filepath;
+
+    source.hash = Compat::Database::Hash(
+        std::span(reinterpret_cast<const u8*>(content.constData()), content.size()));
+    if (cached && cached->GetSource().hash == source.hash) {
+        WriteCache(*cached, source);
+        return cached;
+    }
+    return BuildDatabase(content, source);
+}
+
+GameCompatibility::DatabasePtr GameCompatibility::BuildDatabase(
+    const QByteArray& content, const Compat::SourceStamp& source) const {
     // Set current_os automatically
     QString current_os;
 #ifdef Q_OS_WIN
@@ -130,50 +287,52 @@ bool GameCompatibility::ReadJSON(const QJsonObject& json_data, bool after_downlo
 #else
     current_os = "os-unknown";
 #endif
+    const QJsonObject json_data = QJsonDocument::fromJson(content).object();
     if (json_data.isEmpty()) {
-        qDebug() << "Database Error - Empty JSON root";
-        Q_EMIT DownloadError(tr("Error Downloading Compatibility Database"));
-        return false;
-    }
-    m_compat_database.clear();
-    for (const QString& game_id : json_data.keys()) {
-        const QJsonValue game_value = json_data.value(game_id);
-        if (!game_value.isObject()) {
+        return nullptr;
+    }
+
+    Compat::Database::Builder builder;
+    for (auto game_it = json_data.constBegin(); game_it != json_data.constEnd(); ++game_it) {
+        const QString& game_id = game_it.key();
+        if (!game_it.value().isObject()) {
             qDebug() << "Database Error - Unusable object:" << game_id;
             continue;
         }
-        const QJsonObject game_object = game_value.toObject();
-        for (const QString& platform_key : game_object.keys()) { // match platform
-            const QJsonValue platform_value = game_object.value(platform_key);
-            if (!platform_value.isObject()) {
-                qDebug() << "Database Error - Invalid platform object:" << platform_key
-                         << "for game ID:" << game_id;
-                continue;
-            }
-            if (platform_key != current_os) {
-                continue; // skip non-matching platform
-            }
-            const QJsonObject platform_obj = platform_value.toObject();
-
-            // Create and populate the status structure
-            QString normalized =
-                NormalizeStatusString(platform_obj.value("status").toString("NoResult"));
-            if (normalized.startsWith("Unknown")) {
-                normalized = "NoResult";
-            }
-            Compat::Status status = m_status_data.at(normalized);
-
-            QString isoDate = platform_obj.value("last_tested").toString();
-            QDateTime dt = QDateTime::fromString(isoDate, Qt::ISODate);
-            dt.setTimeZone(QTimeZone::utc());
-            status.last_tested_date = dt.toString("yyyy/MM/dd");
-            status.latest_version = platform_obj.value("version").toString();
-            status.issue_number = platform_obj.value("issue_number").toString();
+        const QJsonObject game_object = game_it.value().toObject();
+        const QJsonValue platform_value = game_object.value(current_os); // match platform
+        if (platform_value.isUndefined()) {
+            continue; // no entry for this platform
+        }
+        if (!platform_value.isObject()) {
+            qDebug() << "Database Error - Invalid platform object:" << current_os
+                     << "for game ID:" << game_id;
+            continue;
+        }
+        const QJsonObject platform_obj = platform_value.toObject();
 
-            // Add status to map
-            m_compat_database.emplace(game_id.toStdString(), std::move(status));
+        QString normalized =
+            NormalizeStatusString(platform_obj.value("status").toString("NoResult"));
+        if (normalized.startsWith("Unknown")) {
+            normalized = "NoResult";
         }
+        const auto status_it = m_status_data.find(normalized);
+        const int status_index =
+            status_it != m_status_data.end() ? status_it->second.index : 5; // NoResult
+
+        QString isoDate = platform_obj.value("last_tested").toString();
+        QDateTime dt = QDateTime::fromString(isoDate, Qt::ISODate);
+        dt.setTimeZone(QTimeZone::utc());
+
+        builder.Add(ToStringView(game_id.toUtf8()), static_cast<u8>(status_index),
+                    ToStringView(dt.toString("yyyy/MM/dd").toUtf8()),
+                    ToStringView(platform_obj.value("version").toString().toUtf8()),
+                    ToStringView(platform_obj.value("issue_number").toString().toUtf8()));
     }
 
-    return true;
+    DatabasePtr database = builder.Build(source);
+    if (database) {
+        WriteCache(*database);
+    }
+    return database;
 }
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <filesystem>
 #include <memory>
-#include <QJsonObject>
+#include <mutex>
+#include <QFutureWatcher>
 #include <QString>
 #include <QWidget>
+#include "compat_database.h"
 
 class GUISettings;
 class Downloader;
@@ -42,12 +45,30 @@ private:
 		{ "Download", { 7, "", "",        tr("Retrieving..."),    tr("Downloading the compatibility database. Please wait...") } }
 	};
     /* clang-format on */
+    using DatabasePtr = std::shared_ptr<const Compat::Database>;
+
     std::shared_ptr<GUISettings> m_gui_settings;
-    std::map<std::string, Compat::Status> m_compat_database;
+    DatabasePtr m_database;      ///< Swapped as a whole, never modified in place
+    std::mutex m_database_mutex; ///< GetCompatibility is called from the refresh workers
+    QFutureWatcher<DatabasePtr> m_load_watcher;
+    QFutureWatcher<DatabasePtr> m_update_watcher;
     QString m_filepath;
-    /** Creates new map from the database */
-    bool ReadJSON(const QJsonObject& json_data, bool after_download);
-    QString NormalizeStatusString(const QString& value) {
+    std::filesystem::path m_json_path;
+    std::filesystem::path m_cache_dir;
+    mutable std::mutex m_cache_mutex; ///< The load and the update workers may both write a cache
+    /** Maps the newest binary cache and removes the older ones. */
+    DatabasePtr OpenCache() const;
+    /** Writes the database as a new cache generation, the mapped ones are left in place. */
+    void WriteCache(const Compat::Database& database,
+                    const std::optional<Compat::SourceStamp>& source = std::nullopt) const;
+    /** Maps the binary cache if it matches the JSON file, otherwise rebuilds it. Worker thread. */
+    DatabasePtr LoadDatabase() const;
+    /** Builds a database from the JSON text and writes the binary cache. Worker thread. */
+    DatabasePtr BuildDatabase(const QByteArray& content, const Compat::SourceStamp& source) const;
+    Compat::SourceStamp GetSourceStamp() const;
+    DatabasePtr GetDatabase();
+    void SetDatabase(DatabasePtr database);
+    static QString NormalizeStatusString(const QString& value) {
         QString result = value;
 
         if (result.startsWith("status-"))
@@ -67,10 +88,12 @@ public:
     Compat::Status GetCompatibility(const std::string& title_id);
     /** Returns the data for the requested status */
     Compat::Status GetStatusData(const QString& status) const;
-    /** Reads database. If online set to true: Downloads and writes the database to file */
+    /** Loads the database in the background. If online set to true: Downloads and writes the
+     * database to file */
     void RequestCompatibility(bool online = false);
 
 Q_SIGNALS:
+    void DatabaseLoaded();
     void DownloadStarted();
     void DownloadFinished();
     void DownloadCanceled();
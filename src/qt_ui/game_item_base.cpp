@@ -6,12 +6,10 @@
 
 GameItemBase::GameItemBase() {
     m_icon_loading_aborted.reset(new std::atomic<bool>(false));
-    m_size_on_disk_loading_aborted.reset(new std::atomic<bool>(false));
 }
 
 GameItemBase::~GameItemBase() {
     waitForIconLoading(true);
-    waitForSizeOnDiskLoading(true);
 }
 
 void GameItemBase::getIconLoadFunc(int index) {
@@ -39,27 +37,9 @@ void GameItemBase::setIconLoadFunc(const icon_load_callback_t& func) {
     *m_icon_loading_aborted = false;
 }
 
-void GameItemBase::getSizeCalcFunc() {
-    if (!m_size_calc_callback || m_size_on_disk_loading || m_size_on_disk_loading_aborted->load()) {
-        return;
-    }
-
-    waitForSizeOnDiskLoading(true);
-
-    *m_size_on_disk_loading_aborted = false;
-    m_size_on_disk_loading = true;
-    m_size_calc_thread.reset(QThread::create([this]() {
-        if (m_size_calc_callback) {
-            m_size_calc_callback();
-        }
-    }));
-    m_size_calc_thread->start();
-}
-
-void GameItemBase::setSizeCalcFunc(const size_calc_callback_t& func) {
-    m_size_on_disk_loading = false;
-    m_size_calc_callback = func;
-    *m_size_on_disk_loading_aborted = false;
+void GameItemBase::resetIconLoading() {
+    waitForIconLoading(false);
+    m_icon_loading = false;
 }
 
 void GameItemBase::waitForIconLoading(bool abort) {
@@ -70,12 +50,3 @@ void GameItemBase::waitForIconLoading(bool abort) {
         m_icon_load_thread.reset();
     }
 }
-
-void GameItemBase::waitForSizeOnDiskLoading(bool abort) {
-    *m_size_on_disk_loading_aborted = abort;
-
-    if (m_size_calc_thread && m_size_calc_thread->isRunning()) {
-        m_size_calc_thread->wait();
-        m_size_calc_thread.reset();
-    }
-}
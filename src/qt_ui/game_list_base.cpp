@@ -23,6 +23,10 @@ void GameListBase::RepaintIcons(std::vector<game_info>& game_data, const QColor&
 
     for (game_info& game : game_data) {
         game->pxmap = placeholder;
+        if (m_icon_residency) {
+            // Only the decoded icon stays until the pixmap is painted again
+            m_icon_residency->Resized(game, IconResidency::GetPixmapBytes(game->icon));
+        }
 
         if (GameItemBase* item = game->item) {
             item->setIconLoadFunc(
@@ -51,10 +55,17 @@ void GameListBase::IconLoadFunction(game_info game, qreal device_pixel_ratio,
     }
 
     const QColor color = GetGridCompatibilityColor(game->compat.color);
+    u64 bytes = 0;
     {
         std::lock_guard lock(game->item->pixmap_mutex);
         game->pxmap = PaintedPixmap(game->icon, device_pixel_ratio, game->has_custom_config,
                                     game->has_custom_pad_config, color);
+        bytes = IconResidency::GetPixmapBytes(game->icon) +
+                IconResidency::GetPixmapBytes(game->pxmap);
+    }
+
+    if (m_icon_residency) {
+        m_icon_residency->Materialized(game, bytes);
     }
 
     if (!cancel || !cancel->load()) {
@@ -158,6 +169,16 @@ QColor GameListBase::GetGridCompatibilityColor(const QString& string) const {
     return QColor();
 }
 
+const QPixmap& GameListBase::ScaledBackground(const QImage& image, const QSize& size) {
+    if (image.cacheKey() != m_background_key || size != m_background_size) {
+        m_background = QPixmap::fromImage(image).scaled(size, Qt::KeepAspectRatioByExpanding,
+                                                        Qt::SmoothTransformation);
+        m_background_key = image.cacheKey();
+        m_background_size = size;
+    }
+    return m_background;
+}
+
 QIcon GameListBase::GetCustomConfigIcon(const game_info& game) {
     if (!game)
         return {};
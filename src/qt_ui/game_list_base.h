@@ -5,6 +5,7 @@
 #pragma once
 
 #include "gui_game_info.h"
+#include "icon_residency.h"
 
 #include <QIcon>
 #include <QWidget>
@@ -28,6 +29,9 @@ public:
     void SetDrawCompatStatusToGrid(bool enabled) {
         m_draw_compat_status_to_grid = enabled;
     }
+    void SetIconResidency(IconResidency* residency) {
+        m_icon_residency = residency;
+    }
 
     virtual void RepaintIcons(std::vector<game_info>& game_data, const QColor& icon_color,
                               const QSize& icon_size, qreal device_pixel_ratio);
@@ -42,10 +46,16 @@ protected:
                           bool paint_config_icon = false, bool paint_pad_config_icon = false,
                           const QColor& compatibility_color = {}) const;
     QColor GetGridCompatibilityColor(const QString& string) const;
+    /** The background image scaled to cover size, scaled again only when either one changes. */
+    const QPixmap& ScaledBackground(const QImage& image, const QSize& size);
 
     std::function<void(const game_info&, const GameItemBase*)> m_icon_ready_callback{};
+    IconResidency* m_icon_residency{};
     bool m_draw_compat_status_to_grid{};
     bool m_is_list_layout{};
     QSize m_icon_size{};
     QColor m_icon_color{};
+    QPixmap m_background{};
+    qint64 m_background_key{}; ///< cacheKey of the image m_background was scaled from
+    QSize m_background_size{};
 };
@@ -14,9 +14,8 @@ void GameListDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
                              const QModelIndex& index) const {
     TableItemDelegate::paint(painter, option, index);
 
-    // Find out if the icon or size items are visible
-    if (index.column() == static_cast<int>(GUI::GameListColumns::dir_size) ||
-        (m_has_icons && index.column() == static_cast<int>(GUI::GameListColumns::icon))) {
+    // Find out if the icon item is visible, sizes come from the GameSizeCache
+    if (m_has_icons && index.column() == static_cast<int>(GUI::GameListColumns::icon)) {
         if (const QTableWidget* table = static_cast<const QTableWidget*>(parent())) {
             // We need to remove the headers from our calculation. The visualItemRect starts at 0,0
             // while the visibleRegion doesn't.
@@ -29,15 +28,8 @@ void GameListDelegate::paint(QPainter* painter, const QStyleOptionViewItem& opti
                 visible_region.boundingRect().intersects(table->visualItemRect(current_item))) {
                 if (GameItem* item = static_cast<GameItem*>(
                         table->item(index.row(), static_cast<int>(GUI::GameListColumns::icon)))) {
-                    if (index.column() == static_cast<int>(GUI::GameListColumns::dir_size)) {
-                        if (!item->getSizeOnDiskLoading()) {
-                            item->getSizeCalcFunc();
-                        }
-                    } else if (m_has_icons &&
-                               index.column() == static_cast<int>(GUI::GameListColumns::icon)) {
-                        if (!item->getIconLoading()) {
-                            item->getIconLoadFunc(index.row());
-                        }
+                    if (!item->getIconLoading()) {
+                        item->getIconLoadFunc(index.row());
                     }
                 }
             }
@@ -20,23 +20,27 @@
 #include <QScrollBar>
 #include <QtConcurrent>
 #include <fmt/core.h>
+#include "background_art_loader.h"
 #include "background_music_player.h"
 #include "change_log_dialog.h"
 #include "common/singleton.h"
 #include "core/emulator_settings.h"
 #include "core/file_format/psf.h"
 #include "core/ipc/ipc_client.h"
+#include "game_item.h"
 #include "game_list_frame.h"
 #include "game_list_grid.h"
 #include "game_list_grid_item.h"
 #include "game_list_table.h"
 #include "gui_application.h"
 #include "gui_settings.h"
+#include "icon_residency.h"
 #include "localized.h"
 #include "npbind_dialog.h"
 #include "persistent_settings.h"
 #include "progress_dialog.h"
 #include "qt_utils.h"
+#include "trophy_viewer.h"
 
 #ifdef _WIN32
 #include <string>
@@ -66,6 +70,7 @@ GameListFrame::GameListFrame(std::shared_ptr<GUISettings> gui_settings,
       m_persistent_settings(std::move(persistent_settings)) {
 
     m_icon_size = GUI::game_list_icon_size_min; // ensure a valid size
+    m_collator.setCaseSensitivity(Qt::CaseInsensitive);
     m_is_list_layout = m_gui_settings->GetValue(GUI::game_list_listMode).toBool();
     m_margin_factor = m_gui_settings->GetValue(GUI::game_list_marginFactor).toReal();
     m_text_factor = m_gui_settings->GetValue(GUI::game_list_textFactor).toReal();
@@ -97,6 +102,17 @@ GameListFrame::GameListFrame(std::shared_ptr<GUISettings> gui_settings,
     m_game_list->verticalScrollBar()->installEventFilter(this);
 
     m_game_compat = new GameCompatibility(m_gui_settings, this);
+    m_art_loader = new BackgroundArtLoader(this);
+
+    m_icon_residency = new IconResidency(this);
+    m_icon_residency->SetBudget(
+        m_gui_settings->GetValue(GUI::game_list_iconMemoryBudget).toULongLong() * 1024 * 1024);
+    m_game_list->SetIconResidency(m_icon_residency);
+    m_game_grid->SetIconResidency(m_icon_residency);
+
+    // Loads of several icons usually finish together, trim once for all of them
+    m_icon_trim_timer.setSingleShot(true);
+    m_icon_trim_timer.setInterval(100);
 
     m_central_widget = new QStackedWidget(this);
     m_central_widget->addWidget(m_game_list);
@@ -170,7 +186,6 @@ GameListFrame::GameListFrame(std::shared_ptr<GUISettings> gui_settings,
 }
 
 GameListFrame::~GameListFrame() {
-    WaitAndAbortSizeCalcThreads();
     WaitAndAbortRepaintThreads();
     GUI::Utils::StopFutureWatcher(m_parsing_watcher, true);
     GUI::Utils::StopFutureWatcher(m_refresh_watcher, true);
@@ -224,7 +239,6 @@ void GameListFrame::CreateConnections() {
     connect(&m_parsing_watcher, &QFutureWatcher<void>::finished, this,
             &GameListFrame::OnParsingFinished);
     connect(&m_parsing_watcher, &QFutureWatcher<void>::canceled, this, [this]() {
-        WaitAndAbortSizeCalcThreads();
         WaitAndAbortRepaintThreads();
 
         m_path_entries.clear();
@@ -236,7 +250,6 @@ void GameListFrame::CreateConnections() {
     connect(&m_refresh_watcher, &QFutureWatcher<void>::finished, this,
             &GameListFrame::OnRefreshFinished);
     connect(&m_refresh_watcher, &QFutureWatcher<void>::canceled, this, [this]() {
-        WaitAndAbortSizeCalcThreads();
         WaitAndAbortRepaintThreads();
 
         m_path_entries.clear();
@@ -273,11 +286,7 @@ void GameListFrame::CreateConnections() {
             item && item->isSelected()) {
             game = GetGameInfoByMode(item);
             PlayBackgroundMusic(game);
-            QImage bg(QString::fromUtf8(game->info.pic_path.c_str()));
-            if (!bg.isNull()) {
-                backgroundImage = bg;
-                m_game_list->update();
-            }
+            RequestBackground(game);
         }
         Q_EMIT NotifyGameSelection(game);
     });
@@ -288,15 +297,33 @@ void GameListFrame::CreateConnections() {
             QOverload<const game_info&>::of(&GameListFrame::DoubleClickedSlot));
     connect(m_game_grid, &GameListGrid::ItemSelectionChanged, this, [this](game_info game) {
         PlayBackgroundMusic(game);
-        QImage bg(QString::fromUtf8(game->info.pic_path.c_str()));
-        if (!bg.isNull()) {
-            backgroundImage = bg;
-            m_game_grid->update();
-        }
+        RequestBackground(game);
         Q_EMIT NotifyGameSelection(game);
     });
 
+    connect(m_art_loader, &BackgroundArtLoader::ImageReady, this,
+            [this](const QString& path, const QImage& image) {
+                // A newer selection may have been made while this one was in the queue
+                if (path != m_background_path || image.isNull()) {
+                    return;
+                }
+                backgroundImage = image;
+                if (m_is_list_layout) {
+                    m_game_list->viewport()->update();
+                } else {
+                    m_game_grid->update();
+                }
+            });
+
+    connect(m_icon_residency, &IconResidency::OverBudget, this,
+            [this]() { m_icon_trim_timer.start(); });
+    connect(m_icon_residency, &IconResidency::UsageChanged, this,
+            &GameListFrame::IconMemoryChanged);
+    connect(&m_icon_trim_timer, &QTimer::timeout, this, &GameListFrame::TrimIcons);
+
     // compatibility list connections
+    connect(m_game_compat, &GameCompatibility::DatabaseLoaded, this,
+            &GameListFrame::OnCompatFinished);
     connect(m_game_compat, &GameCompatibility::DownloadStarted, this, [this]() {
         for (const auto& game : m_game_data) {
             game->compat = m_game_compat->GetStatusData("Download");
@@ -332,82 +359,170 @@ void GameListFrame::OnColumnClicked(int col) {
     m_gui_settings->SetValue(GUI::game_list_sortCol, col, true);
 
     m_game_list->sort(m_game_data.size(), m_sort_column, m_col_sort_order);
+    ApplySearchFilter(); // Hidden rows don't move with the sorted items
 }
 
-bool GameListFrame::SearchMatchesApp(const QString& name, const QString& serial,
-                                     bool fallback) const {
-    if (!m_search_text.isEmpty()) {
-        QString search_text = m_search_text.toLower();
-        QString title_name;
+bool GameListFrame::IsEntryHidden(const game_info& game) const {
+    return !m_show_hidden && m_hidden_list.contains(QString::fromStdString(game->info.serial));
+}
 
-        if (const auto it = m_titles.find(serial); it != m_titles.cend()) {
-            title_name = it->second.toLower();
-        } else {
-            title_name = name.toLower();
-        }
+bool GameListFrame::IsEntryVisible(const game_info& game) const {
+    return !IsEntryHidden(game) &&
+           (m_search_text.isEmpty() ||
+            m_search_matches.contains(QString::fromStdString(game->info.serial)));
+}
 
-        // Ignore trademarks when no search results have been yielded by unmodified search
-        static const QRegularExpression s_ignored_on_fallback(
-            reinterpret_cast<const char*>(u8"[:\\-®©™]+"));
+void GameListFrame::UpdateTitleSortKey(const game_info& game) {
+    const QString serial = QString::fromStdString(game->info.serial);
+    const auto title = m_titles.find(serial);
+    game->sort_keys.title = m_collator.sortKey(
+        title != m_titles.cend() ? title->second : QString::fromStdString(game->info.name));
+}
 
-        if (fallback) {
-            search_text = search_text.simplified();
-            title_name = title_name.simplified();
+void GameListFrame::UpdateSearchIndex(const game_info& game) {
+    const QString serial = QString::fromStdString(game->info.serial);
+    const auto title = m_titles.find(serial);
+    const auto note = m_notes.find(serial);
+    m_search_index.Update(serial, QString::fromStdString(game->info.name),
+                          title != m_titles.cend() ? title->second : QString(),
+                          note != m_notes.cend() ? note->second : QString());
+}
 
-            QString title_name_replaced_trademarks_with_spaces = title_name;
-            QString title_name_simplified = title_name;
+void GameListFrame::ApplySearchFilter() {
+    m_search_matches.clear();
+    if (!m_search_text.isEmpty()) {
+        // Substring and initials matches first, fuzzy matches only when there are none of them
+        const auto matches = m_search_index.Search(m_search_text);
+        const bool any_exact = !matches.empty() && matches.front().exact;
+        for (const auto& match : matches) {
+            if (match.exact == any_exact) {
+                m_search_matches.insert(match.serial);
+            }
+        }
+    }
 
-            search_text.remove(s_ignored_on_fallback);
-            title_name.remove(s_ignored_on_fallback);
-            title_name_replaced_trademarks_with_spaces.replace(s_ignored_on_fallback, " ");
+    for (const auto& game : m_game_data) {
+        if (!game->item) {
+            continue;
+        }
+        const bool visible = IsEntryVisible(game);
+        if (m_is_list_layout) {
+            m_game_list->setRowHidden(static_cast<GameItem*>(game->item)->row(), !visible);
+        } else {
+            static_cast<GameListGridItem*>(game->item)->setVisible(visible);
+        }
+    }
+}
 
-            // Before simplify to allow spaces in the beginning and end where ignored characters may
-            // have been
-            if (title_name_replaced_trademarks_with_spaces.contains(search_text)) {
-                return true;
-            }
+void GameListFrame::RequestBackground(const game_info& game) {
+    if (!game || game->info.pic_path.empty()) {
+        // Keep showing the current background
+        m_background_path.clear();
+        return;
+    }
 
-            title_name_replaced_trademarks_with_spaces =
-                title_name_replaced_trademarks_with_spaces.simplified();
+    m_background_path = QString::fromStdString(game->info.pic_path);
+    const QSize target_size =
+        m_is_list_layout ? m_game_list->viewport()->size() : m_game_grid->size();
+    m_art_loader->Request(game->info.pic_path, target_size, GetNeighbourPicPaths());
+}
 
-            if (title_name_replaced_trademarks_with_spaces.contains(search_text)) {
-                return true;
+std::vector<std::string> GameListFrame::GetNeighbourPicPaths() const {
+    // The entries one and two steps away, in the order they're shown
+    constexpr int Distance = 2;
+    std::vector<std::string> paths;
+
+    const auto collect = [&](int current, int count, const auto& get_game) {
+        for (const int direction : {1, -1}) {
+            int found = 0;
+            for (int index = current + direction; index >= 0 && index < count && found < Distance;
+                 index += direction) {
+                if (const game_info game = get_game(index)) {
+                    paths.push_back(game->info.pic_path);
+                    ++found;
+                }
             }
+        }
+    };
 
-            // Initials-only search
-            if (search_text.size() >= 2 &&
-                search_text.count(QRegularExpression(QStringLiteral("[a-z0-9]"))) >= 2 &&
-                !search_text.contains(QRegularExpression(QStringLiteral("[^a-z0-9 ]")))) {
-                QString initials = QStringLiteral("\\b");
+    if (m_is_list_layout) {
+        collect(m_game_list->currentRow(), m_game_list->rowCount(), [this](int row) -> game_info {
+            if (m_game_list->isRowHidden(row)) {
+                return nullptr;
+            }
+            return GetGameInfoFromItem(
+                m_game_list->item(row, static_cast<int>(GUI::GameListColumns::icon)));
+        });
+    } else {
+        const auto& items = m_game_grid->Items();
+        const auto selected = std::find(items.begin(), items.end(), m_game_grid->SelectedItem());
+        if (selected == items.end()) {
+            return paths;
+        }
+        collect(static_cast<int>(selected - items.begin()), static_cast<int>(items.size()),
+                [&items](int index) -> game_info {
+                    const auto* item = static_cast<const GameListGridItem*>(items[index]);
+                    return item->isHidden() ? nullptr : item->Game();
+                });
+    }
+    return paths;
+}
 
-                for (auto it = search_text.begin(); it != search_text.end(); it++) {
-                    if (it->isSpace()) {
-                        continue;
-                    }
+void GameListFrame::TrimIcons() {
+    // Keep what is on screen and one screen above and below it
+    std::function<bool(const game_info&)> keep;
+    if (m_is_list_layout) {
+        const int first = m_game_list->rowAt(0);
+        int last = m_game_list->rowAt(m_game_list->viewport()->height() - 1);
+        if (last < 0) {
+            last = m_game_list->rowCount() - 1;
+        }
+        const int margin = last - first + 1;
+        keep = [first, last, margin](const game_info& game) {
+            if (first < 0 || !game->item) {
+                return false;
+            }
+            const int row = static_cast<GameItem*>(game->item)->row();
+            return row >= first - margin && row <= last + margin;
+        };
+    } else {
+        QRect area = m_game_grid->ScrollArea()->widget()->visibleRegion().boundingRect();
+        area.adjust(0, -area.height(), 0, area.height());
+        keep = [area](const game_info& game) {
+            const auto* item = static_cast<const GameListGridItem*>(game->item);
+            return item && !item->isHidden() && area.intersects(item->geometry());
+        };
+    }
 
-                    initials += *it;
-                    initials += QStringLiteral("\\w*\\b ");
-                }
+    const std::vector<game_info> evicted = m_icon_residency->Trim(keep);
+    if (evicted.empty()) {
+        return;
+    }
 
-                initials += QChar('?');
+    const qreal device_pixel_ratio = devicePixelRatioF();
+    QPixmap placeholder(m_icon_size * device_pixel_ratio);
+    placeholder.setDevicePixelRatio(device_pixel_ratio);
+    placeholder.fill(Qt::transparent);
 
-                if (title_name_replaced_trademarks_with_spaces.contains(
-                        QRegularExpression(initials))) {
-                    return true;
-                }
-            }
+    for (const game_info& game : evicted) {
+        GameItemBase* item = game->item;
+        if (!item) {
+            game->icon = {};
+            continue;
         }
 
-        return title_name.contains(search_text) || serial.toLower().contains(search_text);
+        // The icon is reloaded from disk when the item comes into view again
+        item->resetIconLoading();
+        {
+            std::lock_guard lock(item->pixmap_mutex);
+            game->icon = {};
+            game->pxmap = placeholder;
+        }
+        item->getImageChangeCallback();
+        if (!m_is_list_layout) {
+            static_cast<GameListGridItem*>(item)->got_visible = false;
+        }
     }
-    return true;
-}
-
-bool GameListFrame::IsEntryVisible(const game_info& game, bool search_fallback) const {
-    const QString serial = QString::fromStdString(game->info.serial);
-    const bool is_visible = m_show_hidden || !m_hidden_list.contains(serial);
-    return is_visible &&
-           SearchMatchesApp(QString::fromStdString(game->info.name), serial, search_fallback);
 }
 
 void GameListFrame::SetShowHidden(bool show) {
@@ -469,14 +584,6 @@ void GameListFrame::WaitAndAbortRepaintThreads() {
     }
 }
 
-void GameListFrame::WaitAndAbortSizeCalcThreads() {
-    for (const game_info& game : m_game_data) {
-        if (game && game->item) {
-            game->item->waitForSizeOnDiskLoading(true);
-        }
-    }
-}
-
 void GameListFrame::ResizeIcons(const int& slider_pos) {
     m_icon_size_index = slider_pos;
     m_icon_size = GUISettings::GetSizeFromSlider(slider_pos);
@@ -538,7 +645,7 @@ void GameListFrame::SetListMode(const bool& is_list) {
 
 void GameListFrame::SetSearchText(const QString& text) {
     m_search_text = text;
-    Refresh();
+    ApplySearchFilter();
 }
 
 void GameListFrame::RepaintIcons(const bool& from_settings) {
@@ -753,6 +860,11 @@ void GameListFrame::OnParsingFinished() {
 
         m_serials.insert(serial);
 
+        const QDateTime last_played_date = PersistentSettings::ParseLastPlayed(last_played);
+        game.sort_keys.last_played =
+            last_played_date.isValid() ? last_played_date.toMSecsSinceEpoch() : 0;
+        game.sort_keys.playtime = playtime;
+
         if (QString note =
                 m_persistent_settings->GetValue(GUI::Persistent::notes, serial, "").toString();
             !note.isEmpty()) {
@@ -801,7 +913,6 @@ void GameListFrame::OnParsingFinished() {
 }
 
 void GameListFrame::OnRefreshFinished() {
-    WaitAndAbortSizeCalcThreads();
     WaitAndAbortRepaintThreads();
 
     // Move parsed results into main game data list
@@ -875,19 +986,20 @@ void GameListFrame::OnRefreshFinished() {
     m_game_data.swap(filtered_games);
 
     // Sort alphabetically by title (localized if available)
+    for (const game_info& game : m_game_data) {
+        UpdateTitleSortKey(game);
+    }
     std::sort(m_game_data.begin(), m_game_data.end(),
-              [&](const game_info& game1, const game_info& game2) {
-                  const QString serial1 = QString::fromStdString(game1->info.serial);
-                  const QString serial2 = QString::fromStdString(game2->info.serial);
-                  const QString& title1 = m_titles.contains(serial1)
-                                              ? m_titles.at(serial1)
-                                              : QString::fromStdString(game1->info.name);
-                  const QString& title2 = m_titles.contains(serial2)
-                                              ? m_titles.at(serial2)
-                                              : QString::fromStdString(game2->info.name);
-                  return title1.toLower() < title2.toLower();
+              [](const game_info& game1, const game_info& game2) {
+                  return game1->sort_keys.title->compare(*game2->sort_keys.title) < 0;
               });
 
+    // Index the library for the search bar
+    m_search_index.Clear();
+    for (const auto& game : m_game_data) {
+        UpdateSearchIndex(game);
+    }
+
     // Clean up hidden games list
     m_hidden_list.intersect(m_serials);
     m_gui_settings->SetValue(GUI::game_list_hidden_list, QStringList(m_hidden_list.values()));
@@ -1112,9 +1224,6 @@ QStringList GameListFrame::scanDirectories(const std::vector<std::filesystem::pa
 void GameListFrame::Refresh(const bool from_drive,
                             const std::vector<std::string>& serials_to_remove,
                             const bool scroll_after) {
-    if (from_drive) {
-        WaitAndAbortSizeCalcThreads();
-    }
     WaitAndAbortRepaintThreads();
     GUI::Utils::StopFutureWatcher(m_parsing_watcher, from_drive);
     GUI::Utils::StopFutureWatcher(m_refresh_watcher, from_drive);
@@ -1131,6 +1240,7 @@ void GameListFrame::Refresh(const bool from_drive,
         m_game_data.clear();
         m_notes.clear();
         m_games.pop_all();
+        m_icon_residency->Clear();
 
         if (m_progress_dialog) {
             m_progress_dialog->SetValue(0);
@@ -1192,29 +1302,22 @@ void GameListFrame::Refresh(const bool from_drive,
         game->item = nullptr;
     }
 
-    // Get list of matching apps
+    // Get list of apps that are not hidden. The search text only hides items, see
+    // ApplySearchFilter, so typing does not repopulate the list.
     std::vector<game_info> matching_apps;
 
     for (const auto& app : m_game_data) {
-        if (IsEntryVisible(app)) {
+        if (!IsEntryHidden(app)) {
             matching_apps.push_back(app);
         }
     }
 
-    // Fallback is not needed when at least one entry is visible
-    if (matching_apps.empty()) {
-        for (const auto& app : m_game_data) {
-            if (IsEntryVisible(app, true)) {
-                matching_apps.push_back(app);
-            }
-        }
-    }
-
     if (m_is_list_layout) {
         m_game_grid->ClearList();
         const int scroll_position = m_game_list->verticalScrollBar()->value();
         m_game_list->Populate(matching_apps, m_notes, m_titles, selected_item);
         m_game_list->sort(m_game_data.size(), m_sort_column, m_col_sort_order);
+        ApplySearchFilter();
         RepaintIcons();
 
         if (scroll_after) {
@@ -1225,6 +1328,7 @@ void GameListFrame::Refresh(const bool from_drive,
     } else {
         m_game_list->ClearList();
         m_game_grid->Populate(matching_apps, m_notes, m_titles, selected_item);
+        ApplySearchFilter();
         RepaintIcons();
     }
 }
@@ -1337,10 +1441,10 @@ void GameListFrame::ShowContextMenu(const QPoint& pos) {
                                   Common::FS::GetUserPath(Common::FS::PathType::UserDir) /
                                       "savedata" / "1" / gameinfo->info.serial);
 
-        // QString trophy_path;
-        // Common::FS::PathToQString(trophy_path,
-        //                           Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) /
-        //                               gameinfo->info.serial / "TrophyFiles");
+        QString trophy_path;
+        Common::FS::PathToQString(trophy_path,
+                                  Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) /
+                                      gameinfo->info.serial / "TrophyFiles");
 
         switch (type) {
         case DeleteType::Game:
@@ -1378,13 +1482,13 @@ void GameListFrame::ShowContextMenu(const QPoint& pos) {
             break;
 
         case DeleteType::Trophy:
-            //     if (!std::filesystem::exists(Common::FS::PathFromQString(trophy_path))) {
-            //         QMessageBox::critical(this, tr("Error"),
-            //                               tr("This game has no saved trophies to delete!"));
-            //         return;
-            //     }
-            //     folder_path = trophy_path;
-            //     message_type = tr("Trophy");
+            if (!std::filesystem::exists(Common::FS::PathFromQString(trophy_path))) {
+                QMessageBox::critical(this, tr("Error"),
+                                      tr("This game has no saved trophies to delete!"));
+                return;
+            }
+            folder_path = trophy_path;
+            message_type = tr("Trophy");
             break;
 
         case DeleteType::ShaderCache: {
@@ -1607,7 +1711,9 @@ void GameListFrame::ShowContextMenu(const QPoint& pos) {
             QString("%1 (ID: %2)").arg(QString::fromStdString(user.user_name)).arg(user.user_id);
         QAction* user_action = trophy_viewer->addAction(user_label);
         connect(user_action, &QAction::triggered, this, [this, user, current_game] {
-
+            auto* viewer =
+                new TrophyViewer(this, current_game, QString::fromStdString(user.user_name));
+            viewer->show();
         });
     }
 
@@ -1633,7 +1739,6 @@ void GameListFrame::ShowContextMenu(const QPoint& pos) {
     QAction* delete_DLC = delete_menu->addAction(tr("&Delete DLC "));
     QAction* delete_trophy = delete_menu->addAction(tr("&Delete Trophy"));
     QAction* delete_shader_cache = delete_menu->addAction(tr("&Delete Shader Cache"));
-    delete_trophy->setEnabled(false); // TODO
 
     // Compatibility
     QMenu* compatibility_menu = menu.addMenu(tr("&Compatibility"));
@@ -1755,7 +1860,7 @@ void GameListFrame::ShowContextMenu(const QPoint& pos) {
         m_gui_settings->SetValue(GUI::game_list_hidden_list, QStringList(m_hidden_list.values()));
         Refresh();
     });
-    connect(edit_notes, &QAction::triggered, this, [this, name, serial] {
+    connect(edit_notes, &QAction::triggered, this, [this, name, serial, gameinfo] {
         bool accepted;
         // fetch old notes from persistent storage
         const QString old_notes =
@@ -1778,6 +1883,7 @@ void GameListFrame::ShowContextMenu(const QPoint& pos) {
                 m_notes.insert_or_assign(serial, new_notes);
                 m_persistent_settings->SetValue(GUI::Persistent::notes, serial, new_notes);
             }
+            UpdateSearchIndex(gameinfo);
 
             Refresh();
         }
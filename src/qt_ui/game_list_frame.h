@@ -7,7 +7,9 @@
 #include "common/lf_queue.h"
 #include "custom_dock_widget.h"
 #include "game_list.h"
+#include "game_search_index.h"
 
+#include <QCollator>
 #include <QFutureWatcher>
 #include <QMainWindow>
 #include <QSet>
@@ -30,6 +32,8 @@ class EmulatorSettings;
 class PersistentSettings;
 class ProgressDialog;
 class IpcClient;
+class BackgroundArtLoader;
+class IconResidency;
 
 class GameListFrame : public CustomDockWidget {
     Q_OBJECT
@@ -57,7 +61,7 @@ public:
     void ResizeIcons(const int& slider_pos);
     void ShowCustomConfigIcon(const game_info& game);
     void SetShowHidden(bool show);
-    bool IsEntryVisible(const game_info& game, bool search_fallback = false) const;
+    bool IsEntryVisible(const game_info& game) const;
     const std::vector<game_info>& GetGameInfo() const;
     void CheckCompatibilityAtStartup();
     void PlayBackgroundMusic(game_info game);
@@ -94,6 +98,7 @@ Q_SIGNALS:
     void Refreshed();
     void NotifyGameSelection(const game_info& game);
     void RequestBoot(const game_info& game);
+    void IconMemoryChanged(u64 usage, u64 budget);
 
 protected:
     /** Override inherited method from Qt to allow signalling when close happened.*/
@@ -102,12 +107,24 @@ protected:
 private:
     void PushPath(const std::string& path, std::vector<std::string>& legit_paths);
     void CreateConnections();
-    bool SearchMatchesApp(const QString& name, const QString& serial, bool fallback = false) const;
+    bool IsEntryHidden(const game_info& game) const;
+    /** Collates the shown title (custom or localized) of a game for sorting */
+    void UpdateTitleSortKey(const game_info& game);
+    /** (Re)indexes the title, custom title, serial and notes of a game for the search bar */
+    void UpdateSearchIndex(const game_info& game);
+    /** Shows the entries matching the search text and hides the others, without repopulating */
+    void ApplySearchFilter();
+    /** Switches to the PIC1 of the selected game once it's decoded and prefetches the PIC1 of
+     * the entries around it */
+    void RequestBackground(const game_info& game);
+    std::vector<std::string> GetNeighbourPicPaths() const;
+    /** Drops the icons of the least recently shown games outside the visible area while the icons
+     * use more memory than the budget */
+    void TrimIcons();
     QStringList scanDirectories(const std::vector<std::filesystem::path>& baseDirs, int maxDepth,
                                 int currentDepth = 1);
     std::string CurrentSelectionPath();
     void WaitAndAbortRepaintThreads();
-    void WaitAndAbortSizeCalcThreads();
     game_info GetGameInfoByMode(const QTableWidgetItem* item) const;
     static game_info GetGameInfoFromItem(const QTableWidgetItem* item);
     // Settings
@@ -122,6 +139,8 @@ private:
     GameListTable* m_game_list = nullptr; // Game List
     GameCompatibility* m_game_compat = nullptr;
     ProgressDialog* m_progress_dialog = nullptr;
+    BackgroundArtLoader* m_art_loader = nullptr;
+    IconResidency* m_icon_residency = nullptr;
     // Data
     struct path_entry {
         std::string path;
@@ -148,14 +167,20 @@ private:
     int m_sort_column{};
     std::map<QString, QString> m_titles;
     std::map<QString, QString> m_notes;
+    QCollator m_collator; ///< UI language, case insensitive
     bool m_initial_refresh_done = false;
     // Search
     QString m_search_text;
+    GameSearchIndex m_search_index;
+    QSet<QString> m_search_matches; ///< Serials shown for a non-empty m_search_text
+    // Background
+    QString m_background_path; ///< PIC1 of the selection that backgroundImage is waiting for
     // Icon Size
     int m_icon_size_index = 0;
     // Icons
     QColor m_icon_color;
     QSize m_icon_size;
+    QTimer m_icon_trim_timer;
     qreal m_margin_factor;
     qreal m_text_factor;
     // Logger
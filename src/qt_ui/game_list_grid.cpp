@@ -148,8 +148,11 @@ void GameListGrid::RepaintIcons(std::vector<game_info>& game_data, const QColor&
 }
 
 void GameListGrid::FocusAndSelectFirstEntryIfNoneIs() {
-    if (!Items().empty()) {
-        Items().front()->setFocus();
+    for (FlowWidgetItem* item : Items()) {
+        if (item && !item->isHidden()) {
+            item->setFocus();
+            break;
+        }
     }
 }
 
@@ -193,9 +196,8 @@ void GameListGrid::paintEvent(QPaintEvent* event) {
     // Draw background first
     if (!m_game_list_frame->backgroundImage.isNull() &&
         m_gui_settings->GetValue(GUI::game_list_showBackgroundImage).toBool()) {
-        QPixmap scaledPixmap =
-            QPixmap::fromImage(m_game_list_frame->backgroundImage)
-                .scaled(rect().size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+        const QPixmap& scaledPixmap =
+            ScaledBackground(m_game_list_frame->backgroundImage, rect().size());
         int x = (rect().width() - scaledPixmap.width()) / 2;
         int y = (rect().height() - scaledPixmap.height()) / 2;
         painter.drawPixmap(x, y, scaledPixmap);
@@ -5,11 +5,11 @@
 #include <QHeaderView>
 #include <QScrollBar>
 #include <QStringBuilder>
-#include "common/fs_util.h"
 #include "custom_table_widget_item.h"
 #include "game_list_delegate.h"
 #include "game_list_frame.h"
 #include "game_list_table.h"
+#include "game_size_cache.h"
 #include "gui_settings.h"
 #include "localized.h"
 #include "persistent_settings.h"
@@ -41,20 +41,9 @@ GameListTable::GameListTable(GameListFrame* frame, std::shared_ptr<GUISettings>
     setColumnCount(static_cast<int>(GUI::GameListColumns::count));
     setMouseTracking(true);
 
-    connect(this, &GameListTable::sizeOnDiskReady, this,
-            [this](const game_info& game, GameItemBase* item) {
-                if (!game || !game->item || game->item != item)
-                    return;
-                if (QTableWidgetItem* size_item =
-                        this->item(static_cast<GameItem*>(game->item)->row(),
-                                   static_cast<int>(GUI::GameListColumns::dir_size))) {
-                    const u64& game_size = game->info.size_on_disk;
-                    size_item->setText(game_size != UINT64_MAX
-                                           ? GUI::Utils::FormatByteSize(game_size)
-                                           : tr("Unknown"));
-                    size_item->setData(Qt::UserRole, QVariant::fromValue<qulonglong>(game_size));
-                }
-            });
+    m_size_cache = new GameSizeCache(this);
+    connect(m_size_cache, &GameSizeCache::SizeReady, this, &GameListTable::SetSizeOnDisk,
+            Qt::QueuedConnection);
 
     connect(this, &GameList::IconReady, this,
             [this](const game_info& game, const GameItemBase* item) {
@@ -237,31 +226,12 @@ void GameListTable::Populate(const std::vector<game_info>& game_data,
             }
         });
 
-        icon_item->setSizeCalcFunc(
-            [this, game, cancel = icon_item->getSizeOnDiskLoadingAborted()]() {
-                if (!game || game->info.size_on_disk != UINT64_MAX || (cancel && cancel->load()))
-                    return;
-
-                // Calculate main game folder size
-                uint64_t total_size = FS::Utils::GetDirSize(game->info.path, 1, cancel.get());
-
-                // Check for "-UPDATE" and "-PATCH" folders
-                for (const auto& suffix : {"-UPDATE", "-patch"}) {
-                    std::filesystem::path extra_path = game->info.path;
-                    extra_path += suffix;
-
-                    if (std::filesystem::exists(extra_path) && (!cancel || !cancel->load())) {
-                        total_size += FS::Utils::GetDirSize(extra_path.string(), 1, cancel.get());
-                        break; // if update founds don't search for -patch
-                    }
-                }
-
-                game->info.size_on_disk = total_size;
-
-                if (!cancel || !cancel->load()) {
-                    Q_EMIT sizeOnDiskReady(game, game->item);
-                }
-            });
+        // Serve the size from the cache, the cache revalidates it in the background
+        if (game->info.size_on_disk == UINT64_MAX) {
+            if (const auto size = m_size_cache->Request(game)) {
+                game->info.size_on_disk = *size;
+            }
+        }
 
         icon_item->setData(Qt::UserRole, index, true);
         icon_item->setData(GUI::CustomRoles::game_role, QVariant::fromValue(game));
@@ -269,9 +239,11 @@ void GameListTable::Populate(const std::vector<game_info>& game_data,
         // Title
         CustomTableWidgetItem* title_item = new CustomTableWidgetItem(title);
         title_item->setIcon(GameListBase::GetCustomConfigIcon(game));
+        title_item->SetSortKey(game, GUI::GameListColumns::name);
 
         // Serial
         CustomTableWidgetItem* serial_item = new CustomTableWidgetItem(game->info.serial);
+        serial_item->SetSortKey(game, GUI::GameListColumns::serial);
 
         if (const auto it = notes_map.find(serial);
             it != notes_map.cend() && !it->second.isEmpty()) {
@@ -339,18 +311,8 @@ void GameListTable::Populate(const std::vector<game_info>& game_data,
         const quint64 elapsed_ms = m_persistent_settings->GetPlaytime(serial);
 
         // Last played (support outdated values)
-        QDateTime last_played;
-        const QString last_played_str = m_persistent_settings->GetLastPlayed(serial);
-
-        if (!last_played_str.isEmpty()) {
-            last_played =
-                QDateTime::fromString(last_played_str, GUI::Persistent::last_played_date_format);
-
-            if (!last_played.isValid()) {
-                last_played = QDateTime::fromString(last_played_str,
-                                                    GUI::Persistent::last_played_date_format_old);
-            }
-        }
+        const QDateTime last_played =
+            PersistentSettings::ParseLastPlayed(m_persistent_settings->GetLastPlayed(serial));
 
         const u64 game_size = game->info.size_on_disk;
 
@@ -369,21 +331,26 @@ void GameListTable::Populate(const std::vector<game_info>& game_data,
                                                    Qt::UserRole, QVariant(app_value));
         setItem(row, static_cast<int>(GUI::GameListColumns::version), app_item);
 
-        setItem(row, static_cast<int>(GUI::GameListColumns::last_play),
-                new CustomTableWidgetItem(
-                    locale.toString(last_played,
-                                    last_played >= QDateTime::currentDateTime().addDays(-7)
-                                        ? GUI::Persistent::last_played_date_with_time_of_day_format
-                                        : GUI::Persistent::last_played_date_format_new),
-                    Qt::UserRole, last_played));
-        setItem(row, static_cast<int>(GUI::GameListColumns::play_time),
-                new CustomTableWidgetItem(
-                    elapsed_ms == 0 ? tr("Never played") : localized.getVerboseTimeByMs(elapsed_ms),
-                    Qt::UserRole, elapsed_ms));
-        setItem(row, static_cast<int>(GUI::GameListColumns::dir_size),
-                new CustomTableWidgetItem(
-                    game_size != UINT64_MAX ? GUI::Utils::FormatByteSize(game_size) : tr("Unknown"),
-                    Qt::UserRole, QVariant::fromValue<qulonglong>(game_size)));
+        const QString last_played_format =
+            last_played >= QDateTime::currentDateTime().addDays(-7)
+                ? GUI::Persistent::last_played_date_with_time_of_day_format
+                : GUI::Persistent::last_played_date_format_new;
+        auto* last_played_item = new CustomTableWidgetItem(
+            locale.toString(last_played, last_played_format), Qt::UserRole, last_played);
+        last_played_item->SetSortKey(game, GUI::GameListColumns::last_play);
+        setItem(row, static_cast<int>(GUI::GameListColumns::last_play), last_played_item);
+
+        auto* play_time_item = new CustomTableWidgetItem(
+            elapsed_ms == 0 ? tr("Never played") : localized.getVerboseTimeByMs(elapsed_ms),
+            Qt::UserRole, elapsed_ms);
+        play_time_item->SetSortKey(game, GUI::GameListColumns::play_time);
+        setItem(row, static_cast<int>(GUI::GameListColumns::play_time), play_time_item);
+
+        auto* size_item = new CustomTableWidgetItem(
+            game_size != UINT64_MAX ? GUI::Utils::FormatByteSize(game_size) : tr("Unknown"),
+            Qt::UserRole, QVariant::fromValue<qulonglong>(game_size));
+        size_item->SetSortKey(game, GUI::GameListColumns::dir_size);
+        setItem(row, static_cast<int>(GUI::GameListColumns::dir_size), size_item);
         setItem(row, static_cast<int>(GUI::GameListColumns::path),
                 new CustomTableWidgetItem(game->info.path));
 
@@ -397,6 +364,21 @@ void GameListTable::Populate(const std::vector<game_info>& game_data,
     selectRow(selected_row);
 }
 
+void GameListTable::SetSizeOnDisk(const game_info& game, u64 size) {
+    game->info.size_on_disk = size;
+
+    // The result is queued, by now the game may be shown by the grid or by a newer table item
+    const auto* game_item = dynamic_cast<GameItem*>(game->item);
+    if (!game_item || game_item->tableWidget() != this) {
+        return;
+    }
+    if (QTableWidgetItem* size_item =
+            item(game_item->row(), static_cast<int>(GUI::GameListColumns::dir_size))) {
+        size_item->setText(GUI::Utils::FormatByteSize(size));
+        size_item->setData(Qt::UserRole, QVariant::fromValue<qulonglong>(size));
+    }
+}
+
 void GameListTable::RepaintIcons(std::vector<game_info>& game_data, const QColor& icon_color,
                                  const QSize& icon_size, qreal device_pixel_ratio) {
     GameListBase::RepaintIcons(game_data, icon_color, icon_size, device_pixel_ratio);
@@ -412,9 +394,8 @@ void GameListTable::paintEvent(QPaintEvent* event) {
     // Draw background first
     if (!m_game_list_frame->backgroundImage.isNull() &&
         m_gui_settings->GetValue(GUI::game_list_showBackgroundImage).toBool()) {
-        QPixmap scaledPixmap = QPixmap::fromImage(m_game_list_frame->backgroundImage)
-                                   .scaled(viewport()->size(), Qt::KeepAspectRatioByExpanding,
-                                           Qt::SmoothTransformation);
+        const QPixmap& scaledPixmap =
+            ScaledBackground(m_game_list_frame->backgroundImage, viewport()->size());
 
         int x = (viewport()->width() - scaledPixmap.width()) / 2;
         int y = (viewport()->height() - scaledPixmap.height()) / 2;
@@ -8,6 +8,7 @@
 
 class PersistentSettings;
 class GameListFrame;
+class GameSizeCache;
 
 class GameListTable : public GameList {
     Q_OBJECT
@@ -36,11 +37,11 @@ public:
     void RepaintIcons(std::vector<game_info>& game_data, const QColor& icon_color,
                       const QSize& icon_size, qreal device_pixel_ratio) override;
 
-Q_SIGNALS:
-    void sizeOnDiskReady(const game_info& game, GameItemBase* item);
-
 private:
+    void SetSizeOnDisk(const game_info& game, u64 size);
+
     GameListFrame* m_game_list_frame{};
+    GameSizeCache* m_size_cache{};
     std::shared_ptr<PersistentSettings> m_persistent_settings;
     std::shared_ptr<GUISettings> m_gui_settings;
 
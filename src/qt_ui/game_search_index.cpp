@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <QRegularExpression>
+#include <QStringList>
+
+#include "game_search_index.h"
+
+namespace {
+u64 TrigramKey(QChar a, QChar b, QChar c) {
+    return (u64{a.unicode()} << 32) | (u64{b.unicode()} << 16) | c.unicode();
+}
+
+// Trigrams of every word of a normalized text. Padded words ("  word ") also yield the word
+// start and end, which ranks fuzzy matches of whole words higher. Unpadded trigrams are the
+// ones any substring of a word has in common with the word.
+void CollectTrigrams(const QString& text, bool padded, std::vector<u64>& out) {
+    for (const QString& word : text.split(QChar(' '), Qt::SkipEmptyParts)) {
+        const QString source = padded ? QStringLiteral("  ") + word + QChar(' ') : word;
+        for (qsizetype i = 0; i + 2 < source.size(); ++i) {
+            out.push_back(TrigramKey(source[i], source[i + 1], source[i + 2]));
+        }
+    }
+}
+
+void SortUnique(std::vector<u64>& values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+}
+
+bool IsWordStart(const QString& text, qsizetype pos) {
+    return pos == 0 || text[pos - 1] == QChar(' ');
+}
+} // namespace
+
+QString GameSearchIndex::Normalize(const QString& text) {
+    static const QRegularExpression s_trademarks(reinterpret_cast<const char*>(u8"[®©™]"));
+    QString stripped = text;
+    stripped.remove(s_trademarks);
+
+    // Compatibility decomposition splits accented letters into base letter and combining mark.
+    const QString decomposed = stripped.normalized(QString::NormalizationForm_KD).toCaseFolded();
+    QString result;
+    result.reserve(decomposed.size());
+    for (const QChar c : decomposed) {
+        if (c.isMark() || c == QChar('\'') || c == QChar(u'\u2019')) {
+            continue;
+        }
+        result += c.isLetterOrNumber() ? c : QChar(' ');
+    }
+    return result.simplified();
+}
+
+void GameSearchIndex::Clear() {
+    m_documents.clear();
+    m_free_ids.clear();
+    m_ids.clear();
+    m_postings.clear();
+}
+
+void GameSearchIndex::Update(const QString& serial, const QString& title,
+                             const QString& custom_title, const QString& notes) {
+    Remove(serial);
+
+    u32 id;
+    if (!m_free_ids.empty()) {
+        id = m_free_ids.back();
+        m_free_ids.pop_back();
+    } else {
+        id = static_cast<u32>(m_documents.size());
+        m_documents.emplace_back();
+    }
+    m_ids.emplace(serial, id);
+
+    Document& document = m_documents[id];
+    document.serial = serial;
+    document.fields[Title] = Normalize(title);
+    document.fields[CustomTitle] = Normalize(custom_title);
+    document.fields[Serial] = Normalize(serial);
+    document.fields[Notes] = Normalize(notes);
+    document.alive = true;
+
+    const QString& shown_title = document.fields[CustomTitle].isEmpty()
+                                     ? document.fields[Title]
+                                     : document.fields[CustomTitle];
+    document.initials.clear();
+    for (const QString& word : shown_title.split(QChar(' '), Qt::SkipEmptyParts)) {
+        document.initials += word.front();
+    }
+
+    document.trigrams.clear();
+    for (const QString& field : document.fields) {
+        CollectTrigrams(field, true, document.trigrams);
+    }
+    SortUnique(document.trigrams);
+    for (const u64 trigram : document.trigrams) {
+        m_postings[trigram].push_back(id);
+    }
+}
+
+void GameSearchIndex::Remove(const QString& serial) {
+    const auto it = m_ids.find(serial);
+    if (it == m_ids.end()) {
+        return;
+    }
+    const u32 id = it->second;
+    m_ids.erase(it);
+
+    Document& document = m_documents[id];
+    for (const u64 trigram : document.trigrams) {
+        if (const auto posting = m_postings.find(trigram); posting != m_postings.end()) {
+            std::erase(posting->second, id);
+            if (posting->second.empty()) {
+                m_postings.erase(posting);
+            }
+        }
+    }
+    document = {};
+    m_free_ids.push_back(id);
+}
+
+float GameSearchIndex::MatchExact(const Document& document, const QString& query) const {
+    float best = 0.0f;
+    for (const Field field : {Title, CustomTitle}) {
+        const QString& text = document.fields[field];
+        if (const qsizetype pos = text.indexOf(query); pos >= 0) {
+            best = std::max(best, pos == 0 ? 3.0f : IsWordStart(text, pos) ? 2.5f : 2.0f);
+        }
+    }
+    if (document.fields[Serial].contains(query)) {
+        best = std::max(best, 2.0f);
+    }
+    if (document.fields[Notes].contains(query)) {
+        best = std::max(best, 1.0f);
+    }
+    return best;
+}
+
+std::vector<GameSearchIndex::Match> GameSearchIndex::Search(const QString& query) const {
+    std::vector<Match> matches;
+    const QString normalized = Normalize(query);
+    if (normalized.isEmpty() || m_ids.empty()) {
+        return matches;
+    }
+
+    // Substring matches. Every word of the query lies within one word of a matching field, so
+    // a match has all unpadded query trigrams. Start from the shortest posting list.
+    std::vector<u64> inner;
+    CollectTrigrams(normalized, false, inner);
+    SortUnique(inner);
+
+    std::vector<u8> matched(m_documents.size(), 0);
+    const auto check_exact = [&](u32 id) {
+        const Document& document = m_documents[id];
+        if (!document.alive) {
+            return;
+        }
+        if (const float score = MatchExact(document, normalized); score > 0.0f) {
+            matches.push_back({document.serial, score, true});
+            matched[id] = 1;
+        }
+    };
+
+    if (inner.empty()) {
+        for (u32 id = 0; id < m_documents.size(); ++id) {
+            check_exact(id);
+        }
+    } else {
+        const std::vector<u32>* shortest = nullptr;
+        for (const u64 trigram : inner) {
+            const auto it = m_postings.find(trigram);
+            if (it == m_postings.end()) {
+                shortest = nullptr;
+                break;
+            }
+            if (!shortest || it->second.size() < shortest->size()) {
+                shortest = &it->second;
+            }
+        }
+        if (shortest) {
+            for (const u32 id : *shortest) {
+                const auto& trigrams = m_documents[id].trigrams;
+                if (std::ranges::all_of(inner, [&](u64 trigram) {
+                        return std::binary_search(trigrams.begin(), trigrams.end(), trigram);
+                    })) {
+                    check_exact(id);
+                }
+            }
+        }
+    }
+
+    // Initials, "gta" for "Grand Theft Auto"
+    QString initials = normalized;
+    initials.remove(QChar(' '));
+    if (initials.size() >= 2) {
+        for (u32 id = 0; id < m_documents.size(); ++id) {
+            const Document& document = m_documents[id];
+            if (document.alive && !matched[id] && document.initials.contains(initials)) {
+                matches.push_back({document.serial, 1.5f, true});
+                matched[id] = 1;
+            }
+        }
+    }
+
+    // Fuzzy matches: share of the padded query trigrams a game contains
+    std::vector<u64> padded;
+    CollectTrigrams(normalized, true, padded);
+    SortUnique(padded);
+    std::vector<u16> hits(m_documents.size(), 0);
+    for (const u64 trigram : padded) {
+        if (const auto it = m_postings.find(trigram); it != m_postings.end()) {
+            for (const u32 id : it->second) {
+                ++hits[id];
+            }
+        }
+    }
+    for (u32 id = 0; id < m_documents.size(); ++id) {
+        if (hits[id] == 0 || matched[id]) {
+            continue;
+        }
+        const float score = static_cast<float>(hits[id]) / static_cast<float>(padded.size());
+        if (score >= FuzzyThreshold) {
+            matches.push_back({m_documents[id].serial, score, false});
+        }
+    }
+
+    std::sort(matches.begin(), matches.end(), [](const Match& a, const Match& b) {
+        return a.score != b.score ? a.score > b.score : a.serial < b.serial;
+    });
+    return matches;
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <QString>
+#include "common/types.h"
+
+/**
+ * In-memory search index over the game list. Titles, custom titles, serials and notes are
+ * normalized (case, diacritics, trademark signs) and split into word trigrams. Substring queries
+ * are answered from the trigram posting lists and verified, queries with typos are ranked by the
+ * share of their trigrams found in a game.
+ */
+class GameSearchIndex {
+public:
+    struct Match {
+        QString serial;
+        float score = 0.0f;
+        bool exact = false; ///< Substring or initials match, otherwise fuzzy
+    };
+
+    /// Minimum share of the query trigrams a fuzzy match has to contain.
+    static constexpr float FuzzyThreshold = 0.5f;
+
+    void Clear();
+    /// Adds the game or replaces its previous entry.
+    void Update(const QString& serial, const QString& title, const QString& custom_title,
+                const QString& notes);
+    void Remove(const QString& serial);
+
+    /// Matches sorted by descending score. Empty for an empty query.
+    std::vector<Match> Search(const QString& query) const;
+
+    size_t Size() const {
+        return m_ids.size();
+    }
+
+    static QString Normalize(const QString& text);
+
+private:
+    enum Field { Title, CustomTitle, Serial, Notes, FieldCount };
+
+    struct Document {
+        QString serial;
+        std::array<QString, FieldCount> fields; ///< Normalized
+        QString initials;                       ///< First letters of the title words
+        std::vector<u64> trigrams;              ///< Unique, sorted
+        bool alive = false;
+    };
+
+    float MatchExact(const Document& document, const QString& query) const;
+
+    std::vector<Document> m_documents;
+    std::vector<u32> m_free_ids;
+    std::unordered_map<QString, u32> m_ids;
+    std::unordered_map<u64, std::vector<u32>> m_postings;
+};
@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <QDebug>
+
+#include "common/fs_util.h"
+#include "common/io_file.h"
+#include "common/path_util.h"
+#include "game_size_cache.h"
+
+namespace {
+constexpr u32 CacheMagic = 0x535A4353; // "SCZS"
+constexpr u32 CacheVersion = 1;
+
+u64 Mix(u64 hash, u64 value) {
+    // FNV-1a over the bytes of value
+    for (int i = 0; i < 8; ++i) {
+        hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+u64 HashString(const std::string& text) {
+    u64 hash = 0xCBF29CE484222325ULL;
+    for (const char c : text) {
+        hash = (hash ^ static_cast<u8>(c)) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+// Order independent, directory iteration order is unspecified.
+u64 FingerprintDirectory(const std::filesystem::path& dir) {
+    std::error_code ec;
+    const auto dir_time = std::filesystem::last_write_time(dir, ec);
+    if (ec) {
+        return 0;
+    }
+
+    u64 entries_hash = 0;
+    u64 entry_count = 0;
+    for (std::filesystem::directory_iterator it(dir, ec), end; it != end && !ec;
+         it.increment(ec)) {
+        u64 hash = HashString(it->path().filename().string());
+        const bool is_dir = it->is_directory(ec);
+        hash = Mix(hash, is_dir);
+        if (!is_dir) {
+            hash = Mix(hash, it->file_size(ec));
+        }
+        hash = Mix(hash, it->last_write_time(ec).time_since_epoch().count());
+        entries_hash += hash;
+        ++entry_count;
+    }
+    return Mix(Mix(Mix(0xCBF29CE484222325ULL, dir_time.time_since_epoch().count()), entry_count),
+               entries_hash);
+}
+} // namespace
+
+GameSizeCache::GameSizeCache(QObject* parent) : QObject(parent) {
+    m_cache_path = Common::FS::GetUserPath(Common::FS::PathType::UserDir) / "game_sizes.bin";
+    Load();
+
+    m_thread.reset(QThread::create([this] { Run(); }));
+    m_thread->start(QThread::LowestPriority);
+}
+
+GameSizeCache::~GameSizeCache() {
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+        m_queue.clear();
+        m_pending.clear();
+    }
+    m_cv.notify_all();
+    m_thread->wait();
+    Save();
+}
+
+std::optional<u64> GameSizeCache::Request(const game_info& game) {
+    std::scoped_lock lock{m_mutex};
+    if (m_pending.insert(game->info.path).second) {
+        m_queue.push_back(game);
+        m_cv.notify_one();
+    } else {
+        // Already queued, validate it for the latest object of the game only
+        const auto path_of = [](const game_info& queued) -> auto& { return queued->info.path; };
+        const auto it = std::ranges::find(m_queue, game->info.path, path_of);
+        if (it != m_queue.end()) {
+            *it = game;
+        }
+    }
+
+    if (const auto it = m_entries.find(game->info.path); it != m_entries.end()) {
+        return it->second.size;
+    }
+    return std::nullopt;
+}
+
+std::filesystem::path GameSizeCache::GetExtraPath(const std::string& base) {
+    // Same precedence as the game list: an update folder hides a patch folder
+    for (const auto& suffix : {"-UPDATE", "-patch"}) {
+        std::filesystem::path extra_path = base;
+        extra_path += suffix;
+        if (std::filesystem::exists(extra_path)) {
+            return extra_path;
+        }
+    }
+    return {};
+}
+
+u64 GameSizeCache::ComputeStamp(const std::filesystem::path& base,
+                                const std::filesystem::path& extra) {
+    u64 stamp = FingerprintDirectory(base);
+    if (!extra.empty()) {
+        stamp = Mix(Mix(stamp, HashString(extra.filename().string())), FingerprintDirectory(extra));
+    }
+    return stamp;
+}
+
+void GameSizeCache::Run() {
+    while (true) {
+        game_info game;
+        {
+            std::unique_lock lock{m_mutex};
+            m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_stop) {
+                return;
+            }
+            game = std::move(m_queue.front());
+            m_queue.pop_front();
+            m_pending.erase(game->info.path);
+        }
+
+        const std::string& path = game->info.path;
+        const std::filesystem::path extra_path = GetExtraPath(path);
+        const u64 stamp = ComputeStamp(path, extra_path);
+
+        std::optional<Entry> cached;
+        {
+            std::scoped_lock lock{m_mutex};
+            if (const auto it = m_entries.find(path); it != m_entries.end()) {
+                cached = it->second;
+            }
+        }
+        if (cached && cached->stamp == stamp) {
+            continue;
+        }
+
+        u64 size = FS::Utils::GetDirSize(path, 1, &m_stop);
+        if (!extra_path.empty() && !m_stop) {
+            size += FS::Utils::GetDirSize(extra_path.string(), 1, &m_stop);
+        }
+        if (m_stop) {
+            return;
+        }
+
+        bool save = false;
+        {
+            std::scoped_lock lock{m_mutex};
+            m_entries.insert_or_assign(path, Entry{size, stamp});
+            m_dirty = true;
+            save = m_queue.empty();
+        }
+        if (save) {
+            Save();
+        }
+        if (!cached || cached->size != size) {
+            Q_EMIT SizeReady(game, size);
+        }
+    }
+}
+
+void GameSizeCache::Load() {
+    Common::FS::IOFile file(m_cache_path, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    u32 magic{};
+    u32 version{};
+    u32 count{};
+    if (!file.ReadObject(magic) || !file.ReadObject(version) || !file.ReadObject(count) ||
+        magic != CacheMagic || version != CacheVersion) {
+        qWarning() << "Ignoring invalid size cache";
+        return;
+    }
+
+    for (u32 i = 0; i < count; ++i) {
+        u32 path_size{};
+        Entry entry;
+        if (!file.ReadObject(path_size) || path_size > 4096) {
+            break;
+        }
+        std::string path(path_size, '\0');
+        if (file.ReadSpan(std::span<char>(path.data(), path.size())) != path.size() ||
+            !file.ReadObject(entry.size) || !file.ReadObject(entry.stamp)) {
+            break;
+        }
+        m_entries.insert_or_assign(std::move(path), entry);
+    }
+}
+
+void GameSizeCache::Save() {
+    std::scoped_lock lock{m_mutex};
+    if (!m_dirty) {
+        return;
+    }
+
+    auto temp_path = m_cache_path;
+    temp_path += ".tmp";
+    {
+        Common::FS::IOFile file(temp_path, Common::FS::FileAccessMode::Write);
+        if (!file.IsOpen()) {
+            qWarning() << "Could not write size cache";
+            return;
+        }
+        file.WriteObject(CacheMagic);
+        file.WriteObject(CacheVersion);
+        file.WriteObject(static_cast<u32>(m_entries.size()));
+        for (const auto& [path, entry] : m_entries) {
+            file.WriteObject(static_cast<u32>(path.size()));
+            file.WriteSpan(std::span<const char>(path.data(), path.size()));
+            file.WriteObject(entry.size);
+            file.WriteObject(entry.stamp);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, m_cache_path, ec);
+    if (ec) {
+        qWarning() << "Could not replace size cache:" << QString::fromStdString(ec.message());
+        return;
+    }
+    m_dirty = false;
+}
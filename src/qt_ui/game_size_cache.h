@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <QObject>
+#include <QThread>
+
+#include "gui_game_info.h"
+
+/**
+ * Sizes on disk of game folders including their -UPDATE or -patch folder, persisted across
+ * launches. A cached size is served right away. A single low priority worker then checks the
+ * change stamp of every requested game and walks the folders again only when it differs, so a
+ * library on a spinning disk isn't scanned in parallel at every startup.
+ *
+ * The stamp covers the top level of each folder (its mtime and the names, sizes and mtimes of
+ * its entries), which changes when an update is installed or files are added or removed there.
+ */
+class GameSizeCache : public QObject {
+    Q_OBJECT
+
+public:
+    explicit GameSizeCache(QObject* parent = nullptr);
+    ~GameSizeCache();
+
+    /** Returns the cached size of the game, if any, and queues it for validation */
+    std::optional<u64> Request(const game_info& game);
+
+Q_SIGNALS:
+    /** A validated size differs from what Request returned. Emitted from the worker thread. */
+    void SizeReady(const game_info& game, u64 size);
+
+private:
+    struct Entry {
+        u64 size = 0;
+        u64 stamp = 0;
+    };
+
+    void Run();
+    void Load();
+    void Save();
+    static u64 ComputeStamp(const std::filesystem::path& base, const std::filesystem::path& extra);
+    static std::filesystem::path GetExtraPath(const std::string& base);
+
+    std::filesystem::path m_cache_path;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::unordered_map<std::string, Entry> m_entries;
+    std::deque<game_info> m_queue;
+    std::unordered_set<std::string> m_pending; ///< Paths of the games in m_queue
+    bool m_dirty = false;
+    std::atomic<bool> m_stop{false};
+    std::unique_ptr<QThread> m_thread;
+};
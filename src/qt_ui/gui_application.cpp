@@ -11,6 +11,7 @@
 #include <qstyle.h>
 #include <qstylefactory.h>
 #include "common/key_manager.h"
+#include "common/logging/backend.h"
 #include "core/emulator_settings.h"
 #include "core/emulator_state.h"
 #include "core/ipc/ipc_client.h"
@@ -33,6 +34,9 @@ GUIApplication::~GUIApplication() {}
 
 bool GUIApplication::init(QString emulator_arg, QString game_arg) {
     m_gui_settings = std::make_shared<GUISettings>();
+    Common::Log::SetRotation(
+        m_gui_settings->GetValue(GUI::general_log_segment_size).toULongLong() * 1_MB,
+        m_gui_settings->GetValue(GUI::general_log_total_size_limit).toULongLong() * 1_MB);
     m_emu_settings = std::make_shared<EmulatorSettings>();
     m_emu_settings->Load();
     m_persistent_settings = std::make_shared<PersistentSettings>();
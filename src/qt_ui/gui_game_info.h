@@ -3,12 +3,23 @@
 
 #pragma once
 
+#include <optional>
+#include <QCollatorSortKey>
 #include "game_compatibility.h"
 #include "game_info.h"
 #include "game_item_base.h"
 
+/** Keys computed once per library load so that sorting the game list doesn't convert or
+ * allocate strings per comparison. Serial and size on disk are compared from GameInfo. */
+struct GameSortKeys {
+    std::optional<QCollatorSortKey> title; ///< Shown title, collated for the UI language
+    s64 last_played = 0;                   ///< Milliseconds since epoch, 0 if never played
+    u64 playtime = 0;                      ///< Milliseconds
+};
+
 struct GUIGameInfo {
     GameInfo info{};
+    GameSortKeys sort_keys;
     Compat::Status compat;
     QPixmap icon;
     QPixmap pxmap;
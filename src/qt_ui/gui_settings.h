@@ -71,6 +71,11 @@ const GUISave general_show_changelog = GUISave(general, "show_changelog", false)
 const GUISave general_check_gui_updates = GUISave(general, "check_gui_updates", false);
 const GUISave general_directory_depth_scanning = GUISave(general, "directory_depth_scanning", 1);
 const GUISave general_separate_update_folder = GUISave(general, "separate_update_folder", false);
+const GUISave general_pkg_catalog_dir = GUISave(general, "pkg_catalog_dir", "");
+const GUISave general_log_segment_size = GUISave(general, "log_segment_size", 16); // MiB
+const GUISave general_log_total_size_limit = GUISave(general, "log_total_size_limit", 128); // MiB
+const GUISave general_warm_start = GUISave(general, "warm_start", false);
+const GUISave general_warm_start_delay = GUISave(general, "warm_start_delay", 750); // ms
 
 // compatibility settings
 const GUISave compatibility_check_on_startup = GUISave(compatibility, "check_on_startup", true);
@@ -115,6 +120,7 @@ const GUISave game_list_play_bg = GUISave(game_list, "play_bg", true);
 const GUISave game_list_bg_volume = GUISave(game_list, "bg_volume", 100);
 const GUISave game_list_showBackgroundImage = GUISave(game_list, "showBackgroundImage", true);
 const GUISave game_list_backgroundImageOpacity = GUISave(game_list, "backgroundImageOpacity", 50);
+const GUISave game_list_iconMemoryBudget = GUISave(game_list, "iconMemoryBudget", 256); // MiB
 
 // meta settings
 const GUISave meta_enableUIColors = GUISave(meta, "enableUIColors", false);
@@ -0,0 +1,309 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include "common/key_manager.h"
+#include "common/path_util.h"
+#include "core/emulator_settings.h"
+#include "core/file_format/pkg.h"
+#include "core/file_format/psf.h"
+#include "core/loader.h"
+#include "core/pkg_install_target.h"
+#include "gui_settings.h"
+#include "headless_installer.h"
+#include "pkg_install_model.h"
+
+using json = nlohmann::json;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+constexpr auto ProgressInterval = std::chrono::milliseconds(500);
+
+struct InstallJob {
+    PkgInfo info;
+    std::unique_ptr<PKG> pkg;
+    std::atomic<bool> extracting{false};
+    Clock::time_point extract_start;
+};
+
+enum class InstallStatus {
+    Installed,
+    Skipped,
+    Failed,
+};
+
+const char* GetStatusName(InstallStatus status) {
+    switch (status) {
+    case InstallStatus::Installed:
+        return "installed";
+    case InstallStatus::Skipped:
+        return "skipped";
+    case InstallStatus::Failed:
+        return "failed";
+    }
+    return "unknown";
+}
+
+double Seconds(Clock::duration time) {
+    return std::chrono::duration<double>(time).count();
+}
+
+// Events of concurrent installs must not interleave within a line.
+class EventWriter {
+public:
+    void Write(const json& event) {
+        std::scoped_lock lock{mutex};
+        std::cout << event.dump() << '\n' << std::flush;
+    }
+
+private:
+    std::mutex mutex;
+};
+
+} // namespace
+
+HeadlessInstaller::HeadlessInstaller(std::shared_ptr<GUISettings> gui_settings,
+                                     std::shared_ptr<EmulatorSettings> emu_settings)
+    : m_gui_settings(std::move(gui_settings)), m_emu_settings(std::move(emu_settings)) {}
+
+int HeadlessInstaller::Run(const HeadlessInstallOptions& options) {
+    EventWriter events;
+    const auto run_start = Clock::now();
+
+    if (!KeyManager::GetInstance()->isPkgDerivedKey3KeysetValid() ||
+        !KeyManager::GetInstance()->IsFakeKeysetValid()) {
+        events.Write({{"event", "error"},
+                      {"reason", "No valid PKG decryption keys found. Please set them up in the "
+                                 "Crypto Key Manager."}});
+        return 1;
+    }
+    if (options.dest.empty()) {
+        events.Write({{"event", "error"}, {"reason", "No install directory given or configured"}});
+        return 1;
+    }
+
+    std::atomic<u32> installed{0};
+    std::atomic<u32> skipped{0};
+    std::atomic<u32> failed{0};
+
+    const auto finish = [&](const std::filesystem::path& file, InstallStatus status,
+                            const std::string& reason, Clock::duration time) {
+        json event = {{"event", "done"},
+                      {"pkg", Common::FS::PathToUTF8String(file)},
+                      {"status", GetStatusName(status)},
+                      {"seconds", Seconds(time)}};
+        if (!reason.empty()) {
+            event["reason"] = reason;
+        }
+        events.Write(event);
+        (status == InstallStatus::Installed ? installed
+         : status == InstallStatus::Skipped ? skipped
+                                            : failed)++;
+    };
+
+    // ---- Collect PKG info ----
+    std::vector<PkgInfo> pkg_infos;
+    pkg_infos.reserve(options.pkgs.size());
+    for (const auto& file : options.pkgs) {
+        std::string failreason = "Not a PKG file";
+        PKG pkg;
+        PSF psf;
+        if (Loader::DetectFileType(file) != Loader::FileTypes::Pkg ||
+            !pkg.Open(file, failreason) || !psf.Open(pkg.sfo)) {
+            finish(file, InstallStatus::Failed, failreason, {});
+            continue;
+        }
+
+        const auto to_qstring = [&](std::string_view key) {
+            const auto value = psf.GetString(key).value_or(std::string_view{});
+            return QString::fromUtf8(value.data(), static_cast<qsizetype>(value.size()));
+        };
+        PkgInfo info;
+        info.title = to_qstring("TITLE");
+        info.serial = to_qstring("TITLE_ID");
+        info.category = to_qstring("CATEGORY");
+        info.app_version = to_qstring("APP_VER");
+        info.filepath = file;
+        pkg_infos.push_back(std::move(info));
+    }
+    SortPkgsForInstall(pkg_infos);
+
+    // One group per title, in install order.
+    std::vector<std::unique_ptr<InstallJob>> jobs;
+    std::vector<std::vector<InstallJob*>> groups;
+    std::unordered_map<std::string, size_t> group_index;
+    for (auto& info : pkg_infos) {
+        auto& job = jobs.emplace_back(std::make_unique<InstallJob>());
+        job->info = std::move(info);
+        const auto [it, inserted] =
+            group_index.try_emplace(job->info.serial.toStdString(), groups.size());
+        if (inserted) {
+            groups.emplace_back();
+        }
+        groups[it->second].push_back(job.get());
+    }
+
+    QThreadPool extract_pool;
+    extract_pool.setMaxThreadCount(options.jobs > 0
+                                       ? static_cast<int>(options.jobs)
+                                       : static_cast<int>(std::thread::hardware_concurrency()));
+
+    const auto addon_dir = m_emu_settings->GetAddonInstallDir();
+    const bool separate_update_folder =
+        m_gui_settings->GetValue(GUI::general_separate_update_folder).toBool();
+
+    const auto install = [&](InstallJob& job) {
+        const auto& file = job.info.filepath;
+        const auto start = Clock::now();
+        std::string failreason;
+
+        auto& pkg = *(job.pkg = std::make_unique<PKG>());
+        PSF psf;
+        if (!pkg.Open(file, failreason)) {
+            finish(file, InstallStatus::Failed, failreason, Clock::now() - start);
+            return;
+        }
+        if (!psf.Open(pkg.sfo)) {
+            finish(file, InstallStatus::Failed, "Could not read SFO", Clock::now() - start);
+            return;
+        }
+
+        PkgInstallTarget target;
+        if (!ResolvePkgInstallTarget(pkg, psf, options.dest, addon_dir, separate_update_folder,
+                                     target, failreason)) {
+            finish(file, InstallStatus::Failed, failreason, Clock::now() - start);
+            return;
+        }
+        if (target.NeedsBaseGame()) {
+            finish(file, InstallStatus::Failed, "PKG is a patch or DLC, install the game first",
+                   Clock::now() - start);
+            return;
+        }
+
+        // Where the GUI asks, the headless installer only proceeds with --overwrite.
+        if (!options.overwrite && target.game_installed) {
+            std::string reason;
+            switch (target.kind) {
+            case PkgInstallTarget::Kind::Patch:
+                if (CompareAppVersions(target.pkg_app_version, target.installed_app_version) <= 0) {
+                    reason = "Installed version " + target.installed_app_version +
+                             " is not older than " + target.pkg_app_version;
+                }
+                break;
+            case PkgInstallTarget::Kind::Addon:
+                if (target.addon_installed) {
+                    reason = "DLC already installed";
+                }
+                break;
+            case PkgInstallTarget::Kind::Game:
+                reason = "Game already installed";
+                break;
+            }
+            if (!reason.empty()) {
+                finish(file, InstallStatus::Skipped, reason, Clock::now() - start);
+                return;
+            }
+        }
+
+        events.Write({{"event", "start"},
+                      {"pkg", Common::FS::PathToUTF8String(file)},
+                      {"title_id", job.info.serial.toStdString()},
+                      {"category", job.info.category.toStdString()},
+                      {"dest", Common::FS::PathToUTF8String(target.extract_path)}});
+
+        if (!pkg.Extract(file, target.extract_path, failreason)) {
+            finish(file, InstallStatus::Failed, failreason, Clock::now() - start);
+            return;
+        }
+
+        QVector<int> indices(static_cast<qsizetype>(pkg.GetNumberOfFiles()));
+        std::iota(indices.begin(), indices.end(), 0);
+
+        std::mutex error_mutex;
+        std::string extract_error;
+        job.extract_start = Clock::now();
+        job.extracting = true;
+        QtConcurrent::blockingMap(&extract_pool, indices, [&](int index) {
+            try {
+                pkg.ExtractFiles(index);
+            } catch (const std::exception& e) {
+                std::scoped_lock lock{error_mutex};
+                if (extract_error.empty()) {
+                    extract_error = e.what();
+                }
+            }
+        });
+        job.extracting = false;
+
+        if (!extract_error.empty()) {
+            finish(file, InstallStatus::Failed, extract_error, Clock::now() - start);
+            return;
+        }
+        finish(file, InstallStatus::Installed, {}, Clock::now() - start);
+    };
+
+    // ---- Install ----
+    // A fixed set of workers takes the title groups in order, so only that many PKGs hold their
+    // PFS buffers at once however many are queued
+    const size_t worker_count =
+        std::min(groups.size(), static_cast<size_t>(std::max(extract_pool.maxThreadCount(), 1)));
+    std::atomic<size_t> next_group{0};
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    size_t workers_left = worker_count;
+
+    std::vector<std::jthread> workers;
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i) {
+        workers.emplace_back([&] {
+            for (size_t g = next_group++; g < groups.size(); g = next_group++) {
+                for (InstallJob* job : groups[g]) {
+                    install(*job);
+                }
+            }
+            std::scoped_lock lock{done_mutex};
+            --workers_left;
+            done_cv.notify_one();
+        });
+    }
+
+    std::unique_lock lock{done_mutex};
+    while (!done_cv.wait_for(lock, ProgressInterval, [&] { return workers_left == 0; })) {
+        for (const auto& job : jobs) {
+            if (!job->extracting) {
+                continue;
+            }
+            const auto& stats = job->pkg->GetStats();
+            const u64 written = stats.GetBytes(PKGInstallStats::Stage::Write);
+            events.Write(
+                {{"event", "progress"},
+                 {"pkg", Common::FS::PathToUTF8String(job->info.filepath)},
+                 {"bytes", written},
+                 {"total", stats.GetTotalBytes()},
+                 {"bytes_per_second",
+                  written / std::max(Seconds(Clock::now() - job->extract_start), 0.001)}});
+        }
+    }
+    lock.unlock();
+    workers.clear();
+
+    events.Write({{"event", "summary"},
+                  {"installed", installed.load()},
+                  {"skipped", skipped.load()},
+                  {"failed", failed.load()},
+                  {"seconds", Seconds(Clock::now() - run_start)}});
+    return failed > 0 ? 1 : 0;
+}
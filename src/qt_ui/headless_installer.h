@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "common/types.h"
+
+class EmulatorSettings;
+class GUISettings;
+
+struct HeadlessInstallOptions {
+    std::vector<std::filesystem::path> pkgs;
+    std::filesystem::path dest;
+    bool overwrite = false; ///< Reinstall games/DLC that exist and patches that are not newer
+    u32 jobs = 0;           ///< Extraction threads and titles installed at once, 0 = all cores
+};
+
+/**
+ * Installs PKGs without a MainWindow, for scripts and CI. Progress is written to stdout as one
+ * JSON object per line ("start", "progress", "done" and a final "summary" event).
+ *
+ * PKGs of different titles are installed concurrently. The PKGs of one title run in order
+ * (game, then patches, then DLC) since they depend on each other's placement.
+ */
+class HeadlessInstaller {
+public:
+    HeadlessInstaller(std::shared_ptr<GUISettings> gui_settings,
+                      std::shared_ptr<EmulatorSettings> emu_settings);
+
+    /// @returns the process exit code, non-zero if any PKG failed to install
+    int Run(const HeadlessInstallOptions& options);
+
+private:
+    std::shared_ptr<GUISettings> m_gui_settings;
+    std::shared_ptr<EmulatorSettings> m_emu_settings;
+};
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "icon_residency.h"
+
+IconResidency::IconResidency(QObject* parent) : QObject(parent) {}
+
+void IconResidency::SetBudget(u64 bytes) {
+    bool over_budget = false;
+    {
+        std::scoped_lock lock{m_mutex};
+        m_budget = bytes;
+        over_budget = m_budget != 0 && m_usage > m_budget;
+    }
+    Q_EMIT UsageChanged(GetUsage(), bytes);
+    if (over_budget) {
+        Q_EMIT OverBudget();
+    }
+}
+
+u64 IconResidency::GetBudget() const {
+    std::scoped_lock lock{m_mutex};
+    return m_budget;
+}
+
+u64 IconResidency::GetUsage() const {
+    std::scoped_lock lock{m_mutex};
+    return m_usage;
+}
+
+void IconResidency::Materialized(const game_info& game, u64 bytes) {
+    if (!game) {
+        return;
+    }
+
+    u64 usage = 0;
+    u64 budget = 0;
+    {
+        std::scoped_lock lock{m_mutex};
+        if (const auto it = m_lookup.find(game.get()); it != m_lookup.end()) {
+            Erase(it->second);
+        }
+        m_entries.push_front(Entry{game.get(), game, bytes});
+        m_lookup.emplace(game.get(), m_entries.begin());
+        m_usage += bytes;
+        usage = m_usage;
+        budget = m_budget;
+    }
+
+    Q_EMIT UsageChanged(usage, budget);
+    if (budget != 0 && usage > budget) {
+        Q_EMIT OverBudget();
+    }
+}
+
+void IconResidency::Resized(const game_info& game, u64 bytes) {
+    u64 usage = 0;
+    u64 budget = 0;
+    {
+        std::scoped_lock lock{m_mutex};
+        const auto it = m_lookup.find(game.get());
+        if (it == m_lookup.end()) {
+            return;
+        }
+        m_usage = m_usage - it->second->bytes + bytes;
+        it->second->bytes = bytes;
+        usage = m_usage;
+        budget = m_budget;
+    }
+    Q_EMIT UsageChanged(usage, budget);
+}
+
+void IconResidency::Clear() {
+    u64 budget = 0;
+    {
+        std::scoped_lock lock{m_mutex};
+        m_entries.clear();
+        m_lookup.clear();
+        m_usage = 0;
+        budget = m_budget;
+    }
+    Q_EMIT UsageChanged(0, budget);
+}
+
+std::vector<game_info> IconResidency::Trim(const std::function<bool(const game_info&)>& keep) {
+    std::vector<game_info> evicted;
+    u64 usage = 0;
+    u64 budget = 0;
+    {
+        std::scoped_lock lock{m_mutex};
+
+        // Games that were removed from the list no longer hold their icons
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            const auto current = it++;
+            if (current->game.expired()) {
+                Erase(current);
+            }
+        }
+
+        if (m_budget != 0 && m_usage > m_budget) {
+            std::list<Entry> kept;
+            for (auto it = m_entries.begin(); it != m_entries.end();) {
+                const auto current = it++;
+                if (const game_info game = current->game.lock(); game && keep(game)) {
+                    kept.splice(kept.end(), m_entries, current);
+                }
+            }
+
+            while (m_usage > m_budget && !m_entries.empty()) {
+                const auto oldest = std::prev(m_entries.end());
+                if (game_info game = oldest->game.lock()) {
+                    evicted.push_back(std::move(game));
+                }
+                Erase(oldest);
+            }
+            m_entries.splice(m_entries.begin(), kept);
+        }
+        usage = m_usage;
+        budget = m_budget;
+    }
+
+    Q_EMIT UsageChanged(usage, budget);
+    return evicted;
+}
+
+u64 IconResidency::GetPixmapBytes(const QPixmap& pixmap) {
+    if (pixmap.isNull()) {
+        return 0;
+    }
+    return static_cast<u64>(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+void IconResidency::Erase(std::list<Entry>::iterator it) {
+    m_usage -= it->bytes;
+    m_lookup.erase(it->key);
+    m_entries.erase(it);
+}
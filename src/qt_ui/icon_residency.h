@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <QObject>
+
+#include "common/types.h"
+#include "gui_game_info.h"
+
+/**
+ * Accounts for the memory held by the decoded ICON0 of each game and the pixmap painted from it,
+ * in the order they were last on screen. Once the total exceeds the budget, Trim picks the least
+ * recently shown games outside the visible area for eviction. Their icons are loaded from disk
+ * again the next time they come into view.
+ */
+class IconResidency : public QObject {
+    Q_OBJECT
+
+public:
+    explicit IconResidency(QObject* parent = nullptr);
+
+    /** 0 keeps every icon */
+    void SetBudget(u64 bytes);
+    u64 GetBudget() const;
+    u64 GetUsage() const;
+
+    /** Records the bytes held for the game after its icon was loaded. Thread safe. */
+    void Materialized(const game_info& game, u64 bytes);
+    /** Changes the bytes of a game that is accounted for without marking it as used */
+    void Resized(const game_info& game, u64 bytes);
+    void Clear();
+
+    /**
+     * Marks the games for which keep returns true as most recently used, then removes and returns
+     * the least recently used of the others until the usage fits into the budget. Games removed
+     * from the list are dropped here, keep is only called with live games.
+     */
+    std::vector<game_info> Trim(const std::function<bool(const game_info&)>& keep);
+
+    static u64 GetPixmapBytes(const QPixmap& pixmap);
+
+Q_SIGNALS:
+    /** The usage went over the budget. May be emitted from an icon loading thread. */
+    void OverBudget();
+    void UsageChanged(u64 usage, u64 budget);
+
+private:
+    struct Entry {
+        const GUIGameInfo* key = nullptr;
+        std::weak_ptr<GUIGameInfo> game;
+        u64 bytes = 0;
+    };
+
+    void Erase(std::list<Entry>::iterator it);
+
+    mutable std::mutex m_mutex;
+    std::list<Entry> m_entries; ///< Most recently used first
+    std::unordered_map<const GUIGameInfo*, std::list<Entry>::iterator> m_lookup;
+    u64 m_usage = 0;
+    u64 m_budget = 0;
+};
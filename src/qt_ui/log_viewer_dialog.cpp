@@ -0,0 +1,325 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <QComboBox>
+#include <QDateTimeEdit>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPlainTextEdit>
+#include <QPushButton>
+#include <QTextBlock>
+#include <QTimeEdit>
+#include <QVBoxLayout>
+#include <QtConcurrent>
+#include "common/io_file.h"
+#include "common/logging/binary_log.h"
+#include "common/path_util.h"
+#include "log_viewer_dialog.h"
+#include "qt_utils.h"
+
+namespace {
+
+std::optional<std::string> ReadLog(const std::filesystem::path& path) {
+    if (path.extension() == Common::Log::BinaryLogExtension) {
+        return Common::Log::BinaryLogDecoder::DecodeToText(path);
+    }
+    const Common::FS::IOFile file(path, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        return std::nullopt;
+    }
+    return file.ReadString(file.GetSize());
+}
+
+/// The segment index of a text log, if it is a rotating log.
+std::optional<Common::Log::LogSegmentIndex> LoadSegmentIndex(const std::filesystem::path& path) {
+    if (path.extension() == Common::Log::BinaryLogExtension) {
+        return std::nullopt;
+    }
+    Common::Log::LogSegmentIndex index(path);
+    if (!index.IsValid() || index.GetSegments().empty()) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+QString SegmentLabel(const Common::Log::LogSegment& segment) {
+    if (segment.active) {
+        return QObject::tr("Current segment");
+    }
+    const QDateTime first = QDateTime::fromMSecsSinceEpoch(segment.first_time / 1000);
+    const QDateTime last = QDateTime::fromMSecsSinceEpoch(segment.last_time / 1000);
+    return QString("%1 - %2 (%3)")
+        .arg(first.toString("yyyy-MM-dd hh:mm:ss"), last.toString("hh:mm:ss"),
+             GUI::Utils::FormatByteSize(segment.size));
+}
+
+} // namespace
+
+LogViewerDialog::LogViewerDialog(QWidget* parent) : QDialog(parent) {
+    setAttribute(Qt::WA_DeleteOnClose);
+    setWindowTitle(tr("Log Viewer"));
+    resize(1000, 600);
+
+    auto* layout = new QVBoxLayout(this);
+    auto* top = new QHBoxLayout();
+    m_logs = new QComboBox(this);
+    m_logs->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    auto* reload = new QPushButton(tr("Reload"), this);
+    top->addWidget(m_logs, 1);
+    top->addWidget(reload);
+    layout->addLayout(top);
+
+    m_segment_bar = new QWidget(this);
+    auto* segment_layout = new QHBoxLayout(m_segment_bar);
+    segment_layout->setContentsMargins(0, 0, 0, 0);
+    m_segments = new QComboBox(m_segment_bar);
+    m_time = new QDateTimeEdit(QDateTime::currentDateTime(), m_segment_bar);
+    m_time->setCalendarPopup(true);
+    m_time->setDisplayFormat("yyyy-MM-dd hh:mm:ss");
+    auto* go_to_time = new QPushButton(tr("Go to Time"), m_segment_bar);
+    segment_layout->addWidget(new QLabel(tr("Segment:"), m_segment_bar));
+    segment_layout->addWidget(m_segments, 1);
+    segment_layout->addWidget(m_time);
+    segment_layout->addWidget(go_to_time);
+    m_segment_bar->hide();
+    layout->addWidget(m_segment_bar);
+
+    m_session_bar = new QWidget(this);
+    auto* session_layout = new QHBoxLayout(m_session_bar);
+    session_layout->setContentsMargins(0, 0, 0, 0);
+    m_levels = new QComboBox(m_session_bar);
+    m_levels->addItem(tr("All Levels"), ~0u);
+    for (const auto& [level, name] :
+         {std::pair{Common::Log::Level::Info, tr("Info and Above")},
+          std::pair{Common::Log::Level::Warning, tr("Warnings and Above")},
+          std::pair{Common::Log::Level::Error, tr("Errors and Above")}}) {
+        m_levels->addItem(name, ~0u << static_cast<u32>(level));
+    }
+    m_classes = new QComboBox(m_session_bar);
+    m_session_time = new QTimeEdit(m_session_bar);
+    m_session_time->setDisplayFormat("hh:mm:ss");
+    m_session_time->setToolTip(tr("Time since the start of the session"));
+    auto* go_to_session_time = new QPushButton(tr("Go to Time"), m_session_bar);
+    session_layout->addWidget(m_levels);
+    session_layout->addWidget(m_classes, 1);
+    session_layout->addWidget(m_session_time);
+    session_layout->addWidget(go_to_session_time);
+    m_session_bar->hide();
+    layout->addWidget(m_session_bar);
+
+    m_text = new QPlainTextEdit(this);
+    m_text->setReadOnly(true);
+    m_text->setLineWrapMode(QPlainTextEdit::NoWrap);
+    m_text->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    layout->addWidget(m_text);
+
+    m_status = new QLabel(this);
+    layout->addWidget(m_status);
+
+    connect(m_logs, &QComboBox::currentIndexChanged, this, [this](int index) {
+        if (index >= 0) {
+            Open(Common::FS::PathFromQString(m_logs->itemData(index).toString()));
+        }
+    });
+    connect(reload, &QPushButton::clicked, this,
+            [this] { ListLogs(m_logs->currentData().toString()); });
+    connect(m_segments, &QComboBox::currentIndexChanged, this, &LogViewerDialog::OpenSegment);
+    connect(go_to_time, &QPushButton::clicked, this, &LogViewerDialog::GoToSegmentTime);
+    connect(m_levels, &QComboBox::currentIndexChanged, this, &LogViewerDialog::ShowSessionLines);
+    connect(m_classes, &QComboBox::currentIndexChanged, this, &LogViewerDialog::ShowSessionLines);
+    connect(go_to_session_time, &QPushButton::clicked, this, &LogViewerDialog::GoToSessionTime);
+    connect(&m_watcher, &QFutureWatcher<std::optional<std::string>>::finished, this, [this] {
+        const auto text = m_watcher.result();
+        if (!text) {
+            m_text->clear();
+            m_status->setText(tr("The log could not be read."));
+            return;
+        }
+        m_text->setPlainText(QString::fromStdString(*text));
+        m_text->moveCursor(QTextCursor::End);
+        if (m_session_index) {
+            m_status->setText(tr("%1 of %2 lines")
+                                  .arg(m_session_lines.size())
+                                  .arg(m_session_index->GetLines().size()));
+        } else {
+            m_status->setText(tr("%1 lines").arg(m_text->blockCount()));
+        }
+    });
+
+    ListLogs({});
+}
+
+void LogViewerDialog::ListLogs(const QString& selected) {
+    const auto& log_dir = Common::FS::GetUserPath(Common::FS::PathType::LogDir);
+    std::vector<std::filesystem::path> logs;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(log_dir, ec)) {
+        const auto extension = entry.path().extension();
+        if (entry.is_regular_file(ec) &&
+            (extension == ".txt" || extension == ".log" ||
+             extension == Common::Log::BinaryLogExtension)) {
+            logs.push_back(entry.path());
+        }
+    }
+    const auto session_dir = log_dir / "sessions";
+    for (const auto& entry : std::filesystem::directory_iterator(session_dir, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".log") {
+            logs.push_back(entry.path());
+        }
+    }
+
+    // Rotated segments are opened through the log they belong to
+    std::set<std::filesystem::path> segment_files;
+    for (const auto& log : logs) {
+        if (const auto index = LoadSegmentIndex(log)) {
+            for (const auto& segment : index->GetSegments()) {
+                if (!segment.active) {
+                    segment_files.insert(index->GetSegmentPath(segment));
+                }
+            }
+        }
+    }
+    std::erase_if(logs, [&](const auto& log) { return segment_files.contains(log); });
+
+    // The launcher log first, whichever backend wrote it, the sessions last and newest first
+    const auto rank = [&](const std::filesystem::path& log) {
+        if (log.stem() == std::filesystem::path(Common::FS::LOG_FILE).stem()) {
+            return 0;
+        }
+        return log.parent_path() == session_dir ? 2 : 1;
+    };
+    std::ranges::sort(logs, [&](const auto& a, const auto& b) {
+        const int a_rank = rank(a);
+        const int b_rank = rank(b);
+        if (a_rank != b_rank) {
+            return a_rank < b_rank;
+        }
+        return a_rank == 2 ? a.filename() > b.filename() : a.filename() < b.filename();
+    });
+
+    const QSignalBlocker blocker(m_logs);
+    m_logs->clear();
+    for (const auto& log : logs) {
+        QString path;
+        Common::FS::PathToQString(path, log);
+        QString name;
+        Common::FS::PathToQString(name, log.lexically_relative(log_dir));
+        m_logs->addItem(name, path);
+    }
+    if (m_logs->count() == 0) {
+        m_segment_index.reset();
+        m_session_index.reset();
+        m_segment_bar->hide();
+        m_session_bar->hide();
+        m_text->clear();
+        m_status->setText(tr("There are no logs yet."));
+        return;
+    }
+    const int index = std::max(m_logs->findData(selected), 0);
+    m_logs->setCurrentIndex(index);
+    Open(logs[index]);
+}
+
+void LogViewerDialog::Open(const std::filesystem::path& path) {
+    m_segment_index.reset();
+    m_session_index.reset();
+    if (auto session = std::make_shared<Common::SessionLogIndex>(path); session->IsValid()) {
+        m_session_index = std::move(session);
+    } else {
+        m_segment_index = LoadSegmentIndex(path);
+    }
+    m_segment_bar->setVisible(m_segment_index.has_value());
+    m_session_bar->setVisible(m_session_index != nullptr);
+
+    if (m_session_index) {
+        const QSignalBlocker blocker(m_classes);
+        m_classes->clear();
+        m_classes->addItem(tr("All Classes"), -1);
+        m_classes->addItem(tr("Without Class"), 0);
+        const auto& class_names = m_session_index->GetClassNames();
+        for (size_t id = 1; id < class_names.size(); ++id) {
+            m_classes->addItem(QString::fromStdString(class_names[id]), static_cast<int>(id));
+        }
+        ShowSessionLines();
+        return;
+    }
+    if (!m_segment_index) {
+        m_status->setText(tr("Loading..."));
+        m_watcher.setFuture(QtConcurrent::run([path] { return ReadLog(path); }));
+        return;
+    }
+
+    // Opens on the newest segment, like a log that isn't rotated
+    const QSignalBlocker blocker(m_segments);
+    m_segments->clear();
+    for (const auto& segment : m_segment_index->GetSegments()) {
+        m_segments->addItem(SegmentLabel(segment));
+    }
+    m_segments->setCurrentIndex(m_segments->count() - 1);
+    OpenSegment(m_segments->count() - 1);
+}
+
+void LogViewerDialog::OpenSegment(int index) {
+    if (!m_segment_index || index < 0) {
+        return;
+    }
+    m_status->setText(tr("Loading..."));
+    m_watcher.setFuture(QtConcurrent::run([segment_index = *m_segment_index, index] {
+        return segment_index.Read(segment_index.GetSegments()[index]);
+    }));
+}
+
+void LogViewerDialog::GoToSegmentTime() {
+    if (!m_segment_index) {
+        return;
+    }
+    const std::chrono::system_clock::time_point time{
+        std::chrono::milliseconds{m_time->dateTime().toMSecsSinceEpoch()}};
+    const Common::Log::LogSegment* segment = m_segment_index->Find(time);
+    if (!segment) {
+        m_status->setText(tr("The log has no messages at or after that time."));
+        return;
+    }
+    m_segments->setCurrentIndex(static_cast<int>(segment - m_segment_index->GetSegments().data()));
+}
+
+void LogViewerDialog::ShowSessionLines() {
+    if (!m_session_index) {
+        return;
+    }
+    std::vector<u16> classes;
+    if (const int id = m_classes->currentData().toInt(); id >= 0) {
+        classes.push_back(static_cast<u16>(id));
+    }
+    m_session_lines = m_session_index->Filter(m_levels->currentData().toUInt(), classes);
+
+    m_status->setText(tr("Loading..."));
+    m_watcher.setFuture(
+        QtConcurrent::run([session_index = m_session_index, lines = m_session_lines] {
+            std::string text;
+            for (const std::string& line : session_index->ReadLines(lines)) {
+                text.append(line).append(1, '\n');
+            }
+            return std::optional<std::string>{std::move(text)};
+        }));
+}
+
+void LogViewerDialog::GoToSessionTime() {
+    if (!m_session_index || m_watcher.isRunning()) {
+        return;
+    }
+    const u32 line = m_session_index->FindTime(
+        static_cast<u32>(m_session_time->time().msecsSinceStartOfDay()));
+    const auto it = std::ranges::lower_bound(m_session_lines, line);
+    if (it == m_session_lines.end()) {
+        m_status->setText(tr("No line shown is at or after that time."));
+        return;
+    }
+    const int block = static_cast<int>(it - m_session_lines.begin());
+    m_text->setTextCursor(QTextCursor(m_text->document()->findBlockByNumber(block)));
+    m_text->centerCursor();
+}
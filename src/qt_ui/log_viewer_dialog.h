@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include <QDialog>
+#include <QFutureWatcher>
+#include "common/logging/log_segments.h"
+#include "common/session_log.h"
+
+class QComboBox;
+class QDateTimeEdit;
+class QLabel;
+class QPlainTextEdit;
+class QTimeEdit;
+class QWidget;
+
+/**
+ * Shows the logs in the log folder and the archived emulator sessions. Binary logs (.blog) are
+ * decoded into the text the text backend would have written; every log is read on a worker so a
+ * large one doesn't block the UI. A rotating log is shown one segment at a time, picked from its
+ * segment index or by a point in time. A session is filtered by level and class through its line
+ * index, which also finds the line shown at a time of the session.
+ */
+class LogViewerDialog : public QDialog {
+    Q_OBJECT
+public:
+    explicit LogViewerDialog(QWidget* parent = nullptr);
+
+private:
+    /// Fills the log list with the logs in the log folder, the launcher log first, and opens the
+    /// selected one if it is still there or else the first.
+    void ListLogs(const QString& selected);
+    void Open(const std::filesystem::path& path);
+    void OpenSegment(int index);
+    void GoToSegmentTime();
+    /// Reads the lines of the session that pass the level and class filters.
+    void ShowSessionLines();
+    void GoToSessionTime();
+
+    QComboBox* m_logs = nullptr;
+    QWidget* m_segment_bar = nullptr;
+    QComboBox* m_segments = nullptr;
+    QDateTimeEdit* m_time = nullptr;
+    std::optional<Common::Log::LogSegmentIndex> m_segment_index;
+    QWidget* m_session_bar = nullptr;
+    QComboBox* m_levels = nullptr;
+    QComboBox* m_classes = nullptr;
+    QTimeEdit* m_session_time = nullptr;
+    std::shared_ptr<const Common::SessionLogIndex> m_session_index; ///< Shared with the reader
+    std::vector<u32> m_session_lines; ///< The lines shown, one per text block
+    QLabel* m_status = nullptr;
+    QPlainTextEdit* m_text = nullptr;
+    QFutureWatcher<std::optional<std::string>> m_watcher;
+};
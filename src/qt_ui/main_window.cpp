@@ -1,34 +1,44 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <QTime>
+#include <QTimer>
 #include <QtConcurrent>
 #include <common/scm_rev.h>
 #include <common/string_util.h>
+#include <common/version_store.h>
 #include <common/versions.h>
 #include <core/file_format/pkg.h>
 #include <core/file_format/psf.h>
 
 #include "background_music_player.h"
 #include "common/input.h"
+#include "common/logging/log.h"
 #include "common/path_util.h"
 #include "control_settings.h"
 #include "core/emulator_settings.h"
 #include "core/emulator_state.h"
 #include "core/loader.h"
+#include "core/pkg_install_target.h"
 #include "crypto_key_dialog.h"
 #include "game_list_exporter.h"
 #include "game_list_frame.h"
 #include "gui_settings.h"
 #include "hotkeys.h"
 #include "kbm_gui.h"
+#include "log_viewer_dialog.h"
 #include "main_window.h"
+#include "persistent_settings.h"
+#include "pkg_catalog_dialog.h"
 #include "pkg_install_dir_select_dialog.h"
 #include "pkg_install_model.h"
 #include "progress_dialog.h"
+#include "qt_utils.h"
 #ifdef ENABLE_UPDATER
 #include "qt_ui/check_update.h"
 #endif
 #include "settings_dialog.h"
+#include "telemetry_graph.h"
 #include "ui_main_window.h"
 #include "user_manager_dialog.h"
 #include "version.h"
@@ -47,10 +57,22 @@ MainWindow::MainWindow(std::shared_ptr<GUISettings> gui_settings,
 
     setAttribute(Qt::WA_DeleteOnClose);
 
-    std::shared_ptr<IpcClient> m_ipc_client = std::make_shared<IpcClient>();
     m_ipc_client->gameClosedFunc = [this]() { onGameClosed(); };
     m_ipc_client->restartEmulatorFunc = [this]() { RestartEmulator(); };
     m_ipc_client->startGameFunc = [this]() { RunGame(); };
+    m_ipc_client->parkedFunc = [this]() {
+        UploadPatches(m_parked_game_info);
+        m_patches_uploaded = true;
+    };
+    m_ipc_client->parkedClosedFunc = [this]() {
+        m_parked_game_info = nullptr;
+        m_patches_uploaded = false;
+    };
+
+    m_warm_start_timer = new QTimer(this);
+    m_warm_start_timer->setSingleShot(true);
+    connect(m_warm_start_timer, &QTimer::timeout, this,
+            [this]() { ParkEmulator(std::exchange(m_warm_start_candidate, nullptr)); });
 }
 
 MainWindow::~MainWindow() {}
@@ -179,6 +201,12 @@ void MainWindow::createConnects() {
         m_save_slider_pos = true;
         resizeIcons(idx);
     });
+    connect(m_game_list_frame, &GameListFrame::IconMemoryChanged, this,
+            [this](u64 usage, u64 budget) {
+                ui->sizeSlider->setToolTip(tr("Icon memory: %1 of %2 MiB")
+                                               .arg(usage / (1024 * 1024))
+                                               .arg(budget / (1024 * 1024)));
+            });
     connect(m_game_list_frame, &GameListFrame::GameListFrameClosed, this, [this]() {
         if (ui->showGameListAct->isChecked()) {
             ui->showGameListAct->setChecked(false);
@@ -322,12 +350,38 @@ void MainWindow::createConnects() {
         CryptoManagerDialog dialog(this);
         dialog.exec();
     });
+    connect(ui->logViewerAct, &QAction::triggered, this,
+            [this] { (new LogViewerDialog(this))->show(); });
 
     connect(ui->install_pkg_act, &QAction::triggered, this, &MainWindow::InstallPkg);
+    connect(ui->pkg_catalog_act, &QAction::triggered, this, [this] {
+        PkgCatalogDialog catalog(m_gui_settings, this);
+        if (catalog.exec() == QDialog::Accepted) {
+            InstallDragDropPkgs(catalog.GetPkgsToInstall());
+        }
+    });
 
     connect(this, &MainWindow::ExtractionFinished, this,
             [this]() { m_game_list_frame->Refresh(true); });
 
+    connect(m_game_list_frame, &GameListFrame::NotifyGameSelection, this,
+            &MainWindow::WarmStartSelection);
+    connect(ui->perfGraphAct, &QAction::triggered, this, [this] {
+        auto* dialog = new QDialog(this);
+        dialog->setAttribute(Qt::WA_DeleteOnClose);
+        dialog->setWindowTitle(tr("Performance"));
+        auto* layout = new QVBoxLayout(dialog);
+        layout->addWidget(new TelemetryGraph(m_ipc_client, dialog));
+        dialog->show();
+    });
+    connect(ui->warmStartAct, &QAction::triggered, this, [this](bool checked) {
+        m_gui_settings->SetValue(GUI::general_warm_start, checked);
+        if (!checked) {
+            m_warm_start_timer->stop();
+            DiscardParkedEmulator();
+        }
+    });
+
     connect(m_game_list_frame, &GameListFrame::RequestBoot, this,
             [this](game_info game) { StartGameWithArgs(game, {}); });
 
@@ -423,10 +477,10 @@ void MainWindow::LoadVersionComboBox() {
             QString rootFolder = QCoreApplication::applicationDirPath();
             QString destExe = rootFolder + "/shadPS4.exe";
 
+            // Usually a link swap, but a copy when the version is on another volume
             auto future = QtConcurrent::run([fullPath, destExe]() {
-                if (QFile::exists(destExe))
-                    QFile::remove(destExe);
-                return QFile::copy(fullPath, destExe);
+                return VersionManager::ActivateExecutable(Common::FS::PathFromQString(fullPath),
+                                                          Common::FS::PathFromQString(destExe));
             });
 
             auto watcher = new QFutureWatcher<bool>();
@@ -438,7 +492,7 @@ void MainWindow::LoadVersionComboBox() {
                     QMessageBox::information(nullptr, QObject::tr("Version Activated"),
                                              QObject::tr("The selected version is now active."));
                 } else {
-                    QMessageBox::critical(nullptr, QObject::tr("Copy Failed"),
+                    QMessageBox::critical(nullptr, QObject::tr("Activation Failed"),
                                           QObject::tr("Unable to activate selected version."));
                 }
             });
@@ -566,6 +620,7 @@ void MainWindow::configureGuiFromSettings() {
             ->isChecked()); // prevent GetValue in m_game_list_frame->LoadSettings
 
     ui->showLogAct->setChecked(m_gui_settings->GetValue(GUI::main_window_showLog).toBool());
+    ui->warmStartAct->setChecked(m_gui_settings->GetValue(GUI::general_warm_start).toBool());
 
     ui->showCompatibilityInGridAct->setChecked(
         m_gui_settings->GetValue(GUI::game_list_draw_compat).toBool());
@@ -611,6 +666,7 @@ void MainWindow::saveWindowState() const {
 }
 
 void MainWindow::closeEvent(QCloseEvent* closeEvent) {
+    DiscardParkedEmulator();
     saveWindowState();
 }
 
@@ -643,52 +699,6 @@ void MainWindow::InstallPkg() {
     }
 }
 
-static int PkgCategoryPriority(const QString& category) {
-    const QString c = category.toLower();
-
-    if (c.contains("game"))
-        return 0; // base game
-    if (c.contains("patch"))
-        return 1;  // patch
-    if (c == "ac") // DLC
-        return 2;
-
-    return 3; // unknown / others
-}
-
-static int CompareAppVersion(const QString& a, const QString& b) {
-    const auto pa = a.split('.', Qt::SkipEmptyParts);
-    const auto pb = b.split('.', Qt::SkipEmptyParts);
-
-    const int maxParts = std::max(pa.size(), pb.size());
-
-    for (int i = 0; i < maxParts; ++i) {
-        int va = (i < pa.size()) ? pa[i].toInt() : 0;
-        int vb = (i < pb.size()) ? pb[i].toInt() : 0;
-
-        if (va != vb)
-            return va < vb ? -1 : 1;
-    }
-    return 0;
-}
-
-static void SortPkgsForInstall(std::vector<PkgInfo>& pkgs) {
-    std::sort(pkgs.begin(), pkgs.end(), [](const PkgInfo& a, const PkgInfo& b) {
-        // Group by title
-        if (a.serial != b.serial)
-            return a.serial < b.serial;
-
-        // GAME then PATCH then DLC
-        int pa = PkgCategoryPriority(a.category);
-        int pb = PkgCategoryPriority(b.category);
-        if (pa != pb)
-            return pa < pb;
-
-        // Version smaller to larger
-        return CompareAppVersion(a.app_version, b.app_version) < 0;
-    });
-}
-
 void MainWindow::InstallDragDropPkgs(const std::vector<std::filesystem::path>& files) {
     if (files.empty()) {
         return;
@@ -785,8 +795,6 @@ void MainWindow::InstallDragDropPkgs(const std::vector<std::filesystem::path>& f
 void MainWindow::InstallSinglePkg(std::filesystem::path file, int pkgNum, int nPkg) {
     if (Loader::DetectFileType(file) == Loader::FileTypes::Pkg) {
         std::string failreason;
-        QElapsedTimer timer;
-        timer.start();
         PKG pkg = PKG();
         PSF psf;
         if (!pkg.Open(file, failreason)) {
@@ -798,101 +806,37 @@ void MainWindow::InstallSinglePkg(std::filesystem::path file, int pkgNum, int nP
                                   "Could not read SFO. Check log for details");
             return;
         }
-        auto category = psf.GetString("CATEGORY");
-
         // No dialog logic here - all dialog logic is in InstallDragDropPkgs
 
-        std::filesystem::path game_install_dir = last_install_dir;
-
-        QString pkgType = QString::fromStdString(pkg.GetPkgFlags());
-        bool use_game_update =
-            pkgType.contains("PATCH") &&
-            m_gui_settings->GetValue(GUI::general_separate_update_folder).toBool();
-
-        // Default paths
-        auto game_folder_path = game_install_dir / pkg.GetTitleID();
-        auto game_update_path = use_game_update ? game_folder_path.parent_path() /
-                                                      (std::string{pkg.GetTitleID()} + "-patch")
-                                                : game_folder_path;
-        const int max_depth = 5;
-
-        if (pkgType.contains("PATCH")) {
-            // For patches, try to find the game recursively
-            auto found_game = Common::FS::FindGameByID(game_install_dir,
-                                                       std::string{pkg.GetTitleID()}, max_depth);
-            if (found_game.has_value()) {
-                game_folder_path = found_game.value().parent_path();
-                game_update_path = use_game_update ? game_folder_path.parent_path() /
-                                                         (std::string{pkg.GetTitleID()} + "-patch")
-                                                   : game_folder_path;
-            }
-        } else {
-            // For base games, we check if the game is already installed
-            auto found_game = Common::FS::FindGameByID(game_install_dir,
-                                                       std::string{pkg.GetTitleID()}, max_depth);
-            if (found_game.has_value()) {
-                game_folder_path = found_game.value().parent_path();
-            }
-            // If the game is not found, we install it in the game install directory
-            else {
-                game_folder_path = game_install_dir / pkg.GetTitleID();
-            }
-            game_update_path = use_game_update ? game_folder_path.parent_path() /
-                                                     (std::string{pkg.GetTitleID()} + "-patch")
-                                               : game_folder_path;
+        PkgInstallTarget target;
+        if (!ResolvePkgInstallTarget(
+                pkg, psf, last_install_dir, m_emu_settings->GetAddonInstallDir(),
+                m_gui_settings->GetValue(GUI::general_separate_update_folder).toBool(), target,
+                failreason)) {
+            QMessageBox::critical(this, tr("PKG ERROR"), QString::fromStdString(failreason));
+            return;
         }
+        const auto& game_folder_path = target.game_folder;
 
         QString gameDirPath;
         Common::FS::PathToQString(gameDirPath, game_folder_path);
-        QDir game_dir(gameDirPath);
-        if (game_dir.exists()) {
+        if (target.game_installed) {
             QMessageBox msgBox;
             msgBox.setWindowTitle(tr("PKG Extraction"));
 
-            std::string content_id;
-            if (auto value = psf.GetString("CONTENT_ID"); value.has_value()) {
-                content_id = std::string{*value};
-            } else {
-                QMessageBox::critical(this, tr("PKG ERROR"), "PSF file there is no CONTENT_ID");
-                return;
-            }
-            std::string entitlement_label = Common::SplitString(content_id, '-')[2];
-
-            auto addon_extract_path =
-                m_emu_settings->GetAddonInstallDir() / pkg.GetTitleID() / entitlement_label;
-            QString addonDirPath;
-            Common::FS::PathToQString(addonDirPath, addon_extract_path);
-            QDir addon_dir(addonDirPath);
-
-            if (pkgType.contains("PATCH")) {
-                QString pkg_app_version;
-                if (auto app_ver = psf.GetString("APP_VER"); app_ver.has_value()) {
-                    pkg_app_version = QString::fromStdString(std::string{*app_ver});
-                } else {
-                    QMessageBox::critical(this, tr("PKG ERROR"), "PSF file there is no APP_VER");
-                    return;
-                }
-                std::filesystem::path sce_folder_path =
-                    std::filesystem::exists(game_update_path / "sce_sys" / "param.sfo")
-                        ? game_update_path / "sce_sys" / "param.sfo"
-                        : game_folder_path / "sce_sys" / "param.sfo";
-                psf.Open(sce_folder_path);
-                QString game_app_version;
-                if (auto app_ver = psf.GetString("APP_VER"); app_ver.has_value()) {
-                    game_app_version = QString::fromStdString(std::string{*app_ver});
-                } else {
-                    QMessageBox::critical(this, tr("PKG ERROR"), "PSF file there is no APP_VER");
-                    return;
-                }
-                double appD = game_app_version.toDouble();
-                double pkgD = pkg_app_version.toDouble();
-                if (pkgD == appD) {
+            if (target.kind == PkgInstallTarget::Kind::Patch) {
+                const QString pkg_app_version = QString::fromStdString(target.pkg_app_version);
+                const QString game_app_version =
+                    QString::fromStdString(target.installed_app_version);
+                const int version_cmp =
+                    CompareAppVersions(target.pkg_app_version, target.installed_app_version);
+                if (version_cmp == 0) {
                     msgBox.setText(QString(tr("Patch detected!") + "\n" +
                                            tr("PKG and Game versions match: ") + pkg_app_version +
                                            "\n" + tr("Would you like to overwrite?")));
                     msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
                     msgBox.setDefaultButton(QMessageBox::No);
-                } else if (pkgD < appD) {
+                } else if (version_cmp < 0) {
                     msgBox.setText(QString(tr("Patch detected!") + "\n" +
                                            tr("PKG Version %1 is older than installed version: ")
                                                .arg(pkg_app_version) +
@@ -914,30 +858,28 @@ void MainWindow::InstallSinglePkg(std::filesystem::path file, int pkgNum, int nP
                 } else {
                     return;
                 }
-            } else if (category == "ac") {
-                if (!addon_dir.exists()) {
+            } else if (target.kind == PkgInstallTarget::Kind::Addon) {
+                if (!target.addon_installed) {
                     QMessageBox addonMsgBox;
                     addonMsgBox.setWindowTitle(tr("DLC Installation"));
                     addonMsgBox.setText(QString(tr("Would you like to install DLC: %1?"))
-                                            .arg(QString::fromStdString(entitlement_label)));
+                                            .arg(QString::fromStdString(target.entitlement_label)));
 
                     addonMsgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
                     addonMsgBox.setDefaultButton(QMessageBox::No);
                     int result = addonMsgBox.exec();
-                    if (result == QMessageBox::Yes) {
-                        game_update_path = addon_extract_path;
-                    } else {
+                    if (result != QMessageBox::Yes) {
                         return;
                     }
                 } else {
+                    QString addonDirPath;
+                    Common::FS::PathToQString(addonDirPath, target.extract_path);
                     msgBox.setText(QString(tr("DLC already installed:") + "\n" + addonDirPath +
                                            "\n\n" + tr("Would you like to overwrite?")));
                     msgBox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
                     msgBox.setDefaultButton(QMessageBox::No);
                     int result = msgBox.exec();
-                    if (result == QMessageBox::Yes) {
-                        game_update_path = addon_extract_path;
-                    } else {
+                    if (result != QMessageBox::Yes) {
                         return;
                     }
                 }
@@ -953,16 +895,12 @@ void MainWindow::InstallSinglePkg(std::filesystem::path file, int pkgNum, int nP
                     return;
                 }
             }
-        } else {
-            // Do nothing;
-            if (pkgType.contains("PATCH") || category == "ac") {
-                QMessageBox::information(
-                    this, tr("PKG Extraction"),
-                    tr("PKG is a patch or DLC, please install the game first!"));
-                return;
-            }
-            // what else?
+        } else if (target.NeedsBaseGame()) {
+            QMessageBox::information(this, tr("PKG Extraction"),
+                                     tr("PKG is a patch or DLC, please install the game first!"));
+            return;
         }
+        const auto& game_update_path = target.extract_path;
         if (!pkg.Extract(file, game_update_path, failreason)) {
             QMessageBox::critical(this, tr("PKG ERROR"), QString::fromStdString(failreason));
         } else {
@@ -974,22 +912,61 @@ void MainWindow::InstallSinglePkg(std::filesystem::path file, int pkgNum, int nP
                     indices.append(i);
                 }
 
+                constexpr int ProgressSteps = 1000;
                 QProgressDialog dialog;
                 dialog.setWindowTitle(tr("PKG Extraction"));
                 dialog.setWindowModality(Qt::WindowModal);
                 QString extractmsg = QString(tr("Extracting PKG %1/%2")).arg(pkgNum).arg(nPkg);
                 dialog.setLabelText(extractmsg);
                 dialog.setAutoClose(true);
-                dialog.setRange(0, nfiles);
+                dialog.setRange(0, ProgressSteps);
 
                 dialog.setGeometry(QStyle::alignedRect(Qt::LeftToRight, Qt::AlignCenter,
                                                        dialog.size(), this->geometry()));
 
+                // Progress follows the bytes written rather than the number of files, so a
+                // single large file no longer stalls the bar.
+                QTimer progress_timer;
+                QElapsedTimer extract_timer;
+                extract_timer.start();
+                connect(&progress_timer, &QTimer::timeout, &dialog, [&] {
+                    const auto& stats = pkg.GetStats();
+                    const u64 total = stats.GetTotalBytes();
+                    const u64 written = stats.GetBytes(PKGInstallStats::Stage::Write);
+                    if (total == 0) {
+                        return;
+                    }
+                    const double seconds = std::max(extract_timer.elapsed() / 1000.0, 0.001);
+                    const double rate = written / seconds;
+                    QString eta = tr("calculating...");
+                    if (rate > 0.0 && written < total) {
+                        eta = QTime(0, 0)
+                                  .addSecs(static_cast<int>((total - written) / rate))
+                                  .toString("hh:mm:ss");
+                    }
+                    // The last step is left to the finished handler, reaching it auto-closes
+                    // the dialog.
+                    dialog.setValue(
+                        static_cast<int>(std::min(written * ProgressSteps / total,
+                                                  static_cast<u64>(ProgressSteps - 1))));
+                    dialog.setLabelText(
+                        extractmsg + "\n" +
+                        tr("%1 / %2 (%3/s) - ETA %4")
+                            .arg(GUI::Utils::FormatByteSize(written))
+                            .arg(GUI::Utils::FormatByteSize(total))
+                            .arg(GUI::Utils::FormatByteSize(static_cast<u64>(rate)))
+                            .arg(eta));
+                });
+                progress_timer.start(200);
+
                 QFutureWatcher<void> futureWatcher;
-                connect(&futureWatcher, &QFutureWatcher<void>::finished, this, [=, this]() {
-                    qint64 elapsed = timer.elapsed(); // milliseconds
-                    qDebug() << "Total extraction took:" << elapsed << "ms (" << elapsed / 1000.0
-                             << "s)"; // TODO to be removed
+                connect(&futureWatcher, &QFutureWatcher<void>::finished, this, [&, this]() {
+                    progress_timer.stop();
+                    dialog.setValue(ProgressSteps);
+                    LOG_INFO(Loader, "PKG install {}: {}",
+                             Common::FS::PathToUTF8String(file.filename()),
+                             pkg.GetStats().Report(
+                                 std::chrono::milliseconds(extract_timer.elapsed())));
 
                     if (pkgNum == nPkg) {
                         QString path;
@@ -1023,8 +1000,6 @@ void MainWindow::InstallSinglePkg(std::filesystem::path file, int pkgNum, int nP
                     }
                 });
                 connect(&dialog, &QProgressDialog::canceled, [&]() { futureWatcher.cancel(); });
-                connect(&futureWatcher, &QFutureWatcher<void>::progressValueChanged, &dialog,
-                        &QProgressDialog::setValue);
                 futureWatcher.setFuture(
                     QtConcurrent::map(indices, [&](int index) { pkg.ExtractFiles(index); }));
                 dialog.exec();
@@ -1074,6 +1049,19 @@ void MainWindow::StartEmulator(std::filesystem::path path, QStringList args) {
         return;
     }
 
+    m_warm_start_timer->stop();
+    if (m_parked_game_info) {
+        // The parked emulator was started with no extra arguments
+        const auto parkedPath = std::filesystem::path(m_parked_game_info->info.path) / "eboot.bin";
+        if (args.isEmpty() && m_ipc_client->isParked() && path == parkedPath) {
+            EmulatorState::GetInstance()->SetGameRunning(true);
+            last_game_info = std::exchange(m_parked_game_info, nullptr);
+            m_ipc_client->launchParked();
+            return;
+        }
+        DiscardParkedEmulator();
+    }
+
     QString selectedVersion =
         m_gui_settings->GetValue(GUI::version_manager_versionSelected).toString();
     if (selectedVersion.isEmpty()) {
@@ -1105,7 +1093,13 @@ void MainWindow::StartEmulator(std::filesystem::path path, QStringList args) {
 }
 
 void MainWindow::RunGame() {
-    auto info = last_game_info;
+    if (!std::exchange(m_patches_uploaded, false)) {
+        UploadPatches(last_game_info);
+    }
+    m_ipc_client->startGame();
+}
+
+void MainWindow::UploadPatches(const game_info& info) {
     auto appVersion = info->info.app_ver;
     auto gameSerial = info->info.serial;
     auto patches = MemoryPatcher::readPatches(gameSerial, appVersion);
@@ -1114,14 +1108,60 @@ void MainWindow::RunGame() {
                                         patch.size, patch.maskOffset, patch.littleEndian,
                                         patch.mask, patch.maskOffset);
     }
+}
 
-    m_ipc_client->startGame();
+void MainWindow::WarmStartSelection(const game_info& game) {
+    m_warm_start_timer->stop();
+    m_warm_start_candidate = nullptr;
+    if (m_parked_game_info && game != m_parked_game_info) {
+        DiscardParkedEmulator();
+    }
+    if (!game || m_parked_game_info || !ui->warmStartAct->isChecked() ||
+        EmulatorState::GetInstance()->IsGameRunning()) {
+        return;
+    }
+    m_warm_start_candidate = game;
+    m_warm_start_timer->start(m_gui_settings->GetValue(GUI::general_warm_start_delay).toInt());
+}
+
+void MainWindow::ParkEmulator(const game_info& game) {
+    // Skipped quietly, starting the game normally reports what is missing
+    if (!game || m_parked_game_info || EmulatorState::GetInstance()->IsGameRunning()) {
+        return;
+    }
+    const QFileInfo fileInfo(
+        m_gui_settings->GetValue(GUI::version_manager_versionSelected).toString());
+    const auto ebootPath = std::filesystem::path(game->info.path) / "eboot.bin";
+    if (!fileInfo.exists() || !std::filesystem::exists(ebootPath)) {
+        return;
+    }
+
+    m_parked_game_info = game;
+    m_patches_uploaded = false;
+    const QStringList args{"--game", QString::fromStdWString(ebootPath.wstring())};
+    m_ipc_client->parkEmulator(fileInfo, args, QDir::currentPath());
+    m_ipc_client->setActiveController(GamepadSelect::GetSelectedGamepad());
+}
+
+void MainWindow::DiscardParkedEmulator() {
+    if (!m_parked_game_info) {
+        return;
+    }
+    m_parked_game_info = nullptr;
+    m_patches_uploaded = false;
+    m_ipc_client->discardParked();
 }
 
 void MainWindow::onGameClosed() {
     EmulatorState::GetInstance()->SetGameRunning(false);
     is_paused = false;
 
+    const TelemetrySummary& summary = m_ipc_client->getTelemetrySummary();
+    if (last_game_info && summary.samples != 0) {
+        m_persistent_settings->AddPerformanceSummary(
+            QString::fromStdString(last_game_info->info.serial), summary, true);
+    }
+
     /* TODO
     // clear dialogs when game closed
     skylander_dialog* sky_diag = skylander_dialog::get_dlg(this, m_ipc_client);
@@ -1208,6 +1248,8 @@ void MainWindow::StartEmulatorExecutable(QString emulatorArg, QString gameArg) {
                               QString(tr("Emulator is already running!")));
         return;
     }
+    m_warm_start_timer->stop();
+    DiscardParkedEmulator();
 
     std::filesystem::path gamePath;
     bool gameFound = false;
@@ -9,6 +9,7 @@
 #include <QList>
 #include <QMainWindow>
 #include <QMimeData>
+#include <QTimer>
 #include <QUrl>
 
 #include "core/ipc/ipc_client.h"
@@ -78,8 +79,12 @@ private:
     void updateLanguageActions(const QStringList& language_codes, const QString& language_code);
     void InstallPkg();
     void RunGame();
+    void UploadPatches(const game_info& game);
     void onGameClosed();
     void RestartEmulator();
+    void WarmStartSelection(const game_info& game);
+    void ParkEmulator(const game_info& game);
+    void DiscardParkedEmulator();
 
     std::shared_ptr<GUISettings> m_gui_settings;
     std::shared_ptr<EmulatorSettings> m_emu_settings;
@@ -93,4 +98,10 @@ private:
     std::shared_ptr<IpcClient> m_ipc_client;
     game_info last_game_info;
     bool is_paused;
+
+    // Warm start: the selected game is started and held before RUN until it is launched
+    QTimer* m_warm_start_timer = nullptr;
+    game_info m_warm_start_candidate;
+    game_info m_parked_game_info;
+    bool m_patches_uploaded = false; ///< While parked, RunGame only has to send START
 };
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include "common/path_util.h"
+#include "network_service.h"
+
+NetworkService& NetworkService::instance() {
+    // Owned by the application, so the manager goes away before Qt does
+    static NetworkService* service = new NetworkService(QCoreApplication::instance());
+    return *service;
+}
+
+NetworkService::NetworkService(QObject* parent)
+    : QObject(parent), m_manager(new QNetworkAccessManager(this)) {
+    QString cache_dir;
+    Common::FS::PathToQString(cache_dir,
+                              Common::FS::GetUserPath(Common::FS::PathType::CacheDir) / "http");
+    auto* cache = new QNetworkDiskCache(m_manager);
+    cache->setCacheDirectory(cache_dir);
+    cache->setMaximumCacheSize(MaxCacheSize);
+    m_manager->setCache(cache);
+}
+
+QNetworkRequest NetworkService::CreateRequest(const QUrl& url) {
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                         QNetworkRequest::PreferNetwork);
+    return request;
+}
+
+void NetworkService::Fetch(const QUrl& url, QObject* context, Callback callback) {
+    std::vector<Waiter>& waiters = m_waiters[url.toString()];
+    waiters.push_back(Waiter{context, std::move(callback)});
+    if (waiters.size() == 1) {
+        m_queue.push_back(url);
+        StartQueued();
+    }
+}
+
+void NetworkService::StartQueued() {
+    while (m_running < MaxRunningRequests && !m_queue.empty()) {
+        const QUrl url = m_queue.front();
+        m_queue.pop_front();
+        ++m_running;
+
+        QNetworkReply* reply = m_manager->get(CreateRequest(url));
+        connect(reply, &QNetworkReply::finished, this,
+                [this, reply, key = url.toString()] { OnFinished(reply, key); });
+    }
+}
+
+void NetworkService::OnFinished(QNetworkReply* reply, const QString& key) {
+    --m_running;
+    reply->deleteLater();
+
+    Response response;
+    response.status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    response.from_cache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+    if (reply->error() != QNetworkReply::NoError) {
+        response.error = reply->errorString();
+    } else if (response.status >= 400) {
+        response.error = QString("HTTP error %1").arg(response.status);
+    } else {
+        response.data = reply->readAll();
+    }
+
+    // Taken first, a callback may fetch the same URL again
+    const std::vector<Waiter> waiters = m_waiters.take(key);
+    StartQueued();
+    for (const Waiter& waiter : waiters) {
+        if (waiter.context) {
+            waiter.callback(response);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <vector>
+#include <QByteArray>
+#include <QHash>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * The network access of the launcher. Every request goes through one QNetworkAccessManager, so
+ * they share its connection pool (HTTP/2 connections are multiplexed) and an on-disk HTTP cache
+ * that revalidates stale responses with If-None-Match / If-Modified-Since. Fetch also caps the
+ * requests running at once and merges requests for a URL that is already being fetched.
+ */
+class NetworkService : public QObject {
+    Q_OBJECT
+public:
+    struct Response {
+        QByteArray data;
+        int status = 0;
+        QString error; ///< Empty on success
+        bool from_cache = false;
+    };
+    using Callback = std::function<void(const Response&)>;
+
+    /// Matches the connections QNetworkAccessManager opens to one HTTP/1.1 host
+    static constexpr int MaxRunningRequests = 6;
+    static constexpr qint64 MaxCacheSize = 64 * 1024 * 1024;
+
+    static NetworkService& instance();
+
+    QNetworkAccessManager* GetManager() const {
+        return m_manager;
+    }
+
+    /// A request with the redirect, HTTP/2 and cache policy of the launcher.
+    static QNetworkRequest CreateRequest(const QUrl& url);
+
+    /// GETs url and calls callback with the response, unless context was destroyed by then.
+    void Fetch(const QUrl& url, QObject* context, Callback callback);
+
+private:
+    explicit NetworkService(QObject* parent);
+
+    struct Waiter {
+        QPointer<QObject> context;
+        Callback callback;
+    };
+
+    void StartQueued();
+    void OnFinished(QNetworkReply* reply, const QString& key);
+
+    QNetworkAccessManager* m_manager;
+    std::deque<QUrl> m_queue;
+    QHash<QString, std::vector<Waiter>> m_waiters; ///< By URL, one entry per request
+    int m_running = 0;
+};
@@ -20,13 +20,14 @@
 #include <QTextCursor>
 #include <QTimer>
 #include <QVBoxLayout>
+#include "common/path_util.h"
 
 NpBindDialog::NpBindDialog(QWidget* parent, const QString& filePath)
     : QDialog(parent), m_filePath(filePath) {
     setWindowTitle(tr("npbind.dat Viewer"));
     resize(900, 600);
 
-    if (!m_npfile.Load(filePath.toStdString())) {
+    if (!m_npfile.Load(Common::FS::PathFromQString(filePath))) {
         QMessageBox::critical(this, tr("Error"), tr("Failed to parse npbind.dat"));
         reject();
         return;
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "core/ipc/telemetry.h"
 #include "persistent_settings.h"
 
 PersistentSettings::PersistentSettings(QObject* parent) : Settings(parent) {
@@ -34,3 +35,40 @@ void PersistentSettings::SetLastPlayed(const QString& serial, const QString& dat
 QString PersistentSettings::GetLastPlayed(const QString& serial) {
     return m_last_played[serial];
 }
+
+void PersistentSettings::AddPerformanceSummary(const QString& serial,
+                                               const TelemetrySummary& summary, bool sync) {
+    QVariantList summaries = GetPerformanceSummaries(serial);
+    summaries.append(QVariantMap{
+        {"date", QDateTime::currentDateTime().toString(GUI::Persistent::last_played_date_format)},
+        {"duration_ms", summary.duration_ms},
+        {"samples", static_cast<quint64>(summary.samples)},
+        {"avg_fps", summary.AverageFps()},
+        {"min_fps", summary.min_fps},
+        {"avg_frame_time_p99", summary.AverageFrameTimeP99()},
+        {"worst_frame_time_p99", summary.worst_frame_time_p99},
+        {"avg_cpu_util", summary.AverageCpuUtil()},
+        {"avg_gpu_util", summary.AverageGpuUtil()},
+        {"peak_memory_mib", summary.peak_memory_mib},
+    });
+    while (summaries.size() > GUI::Persistent::performance_summaries_kept) {
+        summaries.removeFirst();
+    }
+    SetValue(GUI::Persistent::performance, serial, summaries, sync);
+}
+
+QVariantList PersistentSettings::GetPerformanceSummaries(const QString& serial) const {
+    return GetValue(GUI::Persistent::performance, serial, QVariantList()).toList();
+}
+
+QDateTime PersistentSettings::ParseLastPlayed(const QString& date) {
+    if (date.isEmpty()) {
+        return {};
+    }
+
+    QDateTime last_played = QDateTime::fromString(date, GUI::Persistent::last_played_date_format);
+    if (!last_played.isValid()) {
+        last_played = QDateTime::fromString(date, GUI::Persistent::last_played_date_format_old);
+    }
+    return last_played;
+}
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <QDateTime>
 #include "settings.h"
 
 namespace GUI {
@@ -16,6 +17,10 @@ const QString playtime = "Playtime";
 const QString last_played = "LastPlayed";
 const QString notes = "Notes";
 const QString titles = "Titles";
+const QString performance = "Performance";
+
+// Performance summaries kept per game, the oldest are dropped
+const int performance_summaries_kept = 10;
 
 // Date format
 const QString last_played_date_format_old = "MMMM d yyyy";
@@ -25,6 +30,9 @@ const Qt::DateFormat last_played_date_format = Qt::DateFormat::ISODate;
 
 } // namespace Persistent
 } // namespace GUI
+
+struct TelemetrySummary;
+
 class PersistentSettings : public Settings {
     Q_OBJECT
 
@@ -39,6 +47,14 @@ public Q_SLOTS:
     void SetLastPlayed(const QString& serial, const QString& date, bool sync);
     QString GetLastPlayed(const QString& serial);
 
+    /** Stores the performance summary of a session that just ended, latest last. */
+    void AddPerformanceSummary(const QString& serial, const TelemetrySummary& summary, bool sync);
+    QVariantList GetPerformanceSummaries(const QString& serial) const;
+
+public:
+    /** Parses a stored last played date, also in the outdated format. Invalid if empty. */
+    static QDateTime ParseLastPlayed(const QString& date);
+
 private:
     std::map<QString, quint64> m_playtime;
     std::map<QString, QString> m_last_played;
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <QCryptographicHash>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtDebug>
+
+#include "common/io_file.h"
+#include "common/path_util.h"
+#include "core/file_format/pkg.h"
+#include "core/file_format/psf.h"
+#include "pkg_catalog.h"
+
+namespace {
+
+constexpr auto CatalogFileName = "catalog.json";
+constexpr u32 PicEntryId = 0x1006;  // pic1.png
+constexpr u32 IconEntryId = 0x1200; // icon0.png
+
+QString PsfString(const PSF& psf, std::string_view key) {
+    const auto value = psf.GetString(key).value_or(std::string_view{});
+    return QString::fromUtf8(value.data(), static_cast<qsizetype>(value.size()));
+}
+
+QString ToQString(const std::filesystem::path& path) {
+    QString result;
+    Common::FS::PathToQString(result, path);
+    return result;
+}
+
+} // namespace
+
+PkgCatalog::PkgCatalog(std::filesystem::path cache_dir) : m_cache_dir(std::move(cache_dir)) {}
+
+void PkgCatalog::LoadCache() {
+    QFile file(ToQString(m_cache_dir / CatalogFileName));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    const QJsonArray records = QJsonDocument::fromJson(file.readAll()).array();
+
+    std::scoped_lock lock{m_mutex};
+    m_entries.clear();
+    for (const QJsonValue& value : records) {
+        const QJsonObject obj = value.toObject();
+
+        PkgCatalogEntry entry;
+        entry.filepath = Common::FS::PathFromQString(obj["path"].toString());
+        entry.file_size = obj["size"].toString().toULongLong();
+        entry.mtime = obj["mtime"].toString().toLongLong();
+        entry.title = obj["title"].toString();
+        entry.serial = obj["serial"].toString();
+        entry.category = obj["category"].toString();
+        entry.app_version = obj["app_version"].toString();
+        entry.content_id = obj["content_id"].toString();
+        entry.pkg_flags = obj["pkg_flags"].toString();
+        entry.icon_path = Common::FS::PathFromQString(obj["icon"].toString());
+        entry.pic_path = Common::FS::PathFromQString(obj["pic"].toString());
+
+        m_entries.insert_or_assign(Common::FS::PathToUTF8String(entry.filepath), std::move(entry));
+    }
+}
+
+void PkgCatalog::SaveCache() const {
+    std::filesystem::create_directories(m_cache_dir);
+
+    QJsonArray records;
+    {
+        std::scoped_lock lock{m_mutex};
+        for (const auto& [key, entry] : m_entries) {
+            QJsonObject obj;
+            obj["path"] = ToQString(entry.filepath);
+            // 64-bit values are stored as strings, QJsonValue only keeps doubles
+            obj["size"] = QString::number(entry.file_size);
+            obj["mtime"] = QString::number(entry.mtime);
+            obj["title"] = entry.title;
+            obj["serial"] = entry.serial;
+            obj["category"] = entry.category;
+            obj["app_version"] = entry.app_version;
+            obj["content_id"] = entry.content_id;
+            obj["pkg_flags"] = entry.pkg_flags;
+            obj["icon"] = ToQString(entry.icon_path);
+            obj["pic"] = ToQString(entry.pic_path);
+            records.append(obj);
+        }
+    }
+
+    QFile file(ToQString(m_cache_dir / CatalogFileName));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "PkgCatalog: Failed to write cache" << file.fileName();
+        return;
+    }
+    file.write(QJsonDocument(records).toJson(QJsonDocument::Compact));
+}
+
+std::vector<std::filesystem::path> PkgCatalog::ScanFolder(const std::filesystem::path& dir,
+                                                          int max_depth) {
+    std::vector<std::filesystem::path> pkgs;
+
+    std::error_code ec;
+    auto it = std::filesystem::recursive_directory_iterator(
+        dir, std::filesystem::directory_options::skip_permission_denied, ec);
+    if (ec) {
+        return pkgs;
+    }
+
+    for (const auto end = std::filesystem::recursive_directory_iterator(); it != end;
+         it.increment(ec)) {
+        if (ec) {
+            break;
+        }
+        if (it->is_directory(ec)) {
+            if (it.depth() + 1 >= max_depth) {
+                it.disable_recursion_pending();
+            }
+            continue;
+        }
+
+        auto ext = it->path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext == ".pkg" && it->is_regular_file(ec)) {
+            pkgs.push_back(it->path());
+        }
+    }
+
+    std::sort(pkgs.begin(), pkgs.end());
+    return pkgs;
+}
+
+std::optional<PkgCatalogEntry> PkgCatalog::IndexPkg(const std::filesystem::path& pkg_path) {
+    std::error_code ec;
+    const u64 file_size = std::filesystem::file_size(pkg_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const s64 mtime = std::filesystem::last_write_time(pkg_path, ec).time_since_epoch().count();
+    if (ec) {
+        return std::nullopt;
+    }
+
+    const std::string key = Common::FS::PathToUTF8String(pkg_path);
+    {
+        std::scoped_lock lock{m_mutex};
+        if (const auto it = m_entries.find(key); it != m_entries.end() &&
+                                                 it->second.file_size == file_size &&
+                                                 it->second.mtime == mtime) {
+            return it->second;
+        }
+    }
+
+    std::string failreason;
+    PKG pkg;
+    if (!pkg.Open(pkg_path, failreason) || pkg.sfo.empty()) {
+        qWarning() << "PkgCatalog: Skipping" << ToQString(pkg_path) << ":"
+                   << QString::fromStdString(failreason);
+        return std::nullopt;
+    }
+
+    PSF psf;
+    if (!psf.Open(pkg.sfo)) {
+        qWarning() << "PkgCatalog: Could not read SFO of" << ToQString(pkg_path);
+        return std::nullopt;
+    }
+
+    PkgCatalogEntry entry;
+    entry.filepath = pkg_path;
+    entry.file_size = file_size;
+    entry.mtime = mtime;
+    entry.title = PsfString(psf, "TITLE");
+    entry.serial = PsfString(psf, "TITLE_ID");
+    entry.category = PsfString(psf, "CATEGORY");
+    entry.app_version = PsfString(psf, "APP_VER");
+    entry.content_id = PsfString(psf, "CONTENT_ID");
+    entry.pkg_flags = QString::fromStdString(pkg.GetPkgFlags());
+
+    const auto store_image = [&](u32 id, std::string_view name) -> std::filesystem::path {
+        std::vector<u8> data;
+        if (!pkg.ReadEntry(id, data) || data.empty()) {
+            return {};
+        }
+        const auto path = GetImagePath(key, name);
+        if (Common::FS::IOFile::WriteBytes(path, data) != data.size()) {
+            return {};
+        }
+        return path;
+    };
+
+    std::filesystem::create_directories(m_cache_dir, ec);
+    entry.icon_path = store_image(IconEntryId, "icon0.png");
+    entry.pic_path = store_image(PicEntryId, "pic1.png");
+
+    std::scoped_lock lock{m_mutex};
+    m_entries.insert_or_assign(key, entry);
+    return entry;
+}
+
+void PkgCatalog::Prune() {
+    std::scoped_lock lock{m_mutex};
+    std::error_code ec;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (std::filesystem::exists(it->second.filepath, ec)) {
+            ++it;
+            continue;
+        }
+        std::filesystem::remove(it->second.icon_path, ec);
+        std::filesystem::remove(it->second.pic_path, ec);
+        it = m_entries.erase(it);
+    }
+}
+
+std::filesystem::path PkgCatalog::GetImagePath(const std::string& key,
+                                               std::string_view name) const {
+    const QByteArray hash =
+        QCryptographicHash::hash(QByteArray::fromStdString(key), QCryptographicHash::Sha1)
+            .toHex();
+    return m_cache_dir / fmt::format("{}_{}", hash.toStdString(), name);
+}
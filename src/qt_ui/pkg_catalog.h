@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <QString>
+
+#include "common/types.h"
+
+struct PkgCatalogEntry {
+    std::filesystem::path filepath;
+    u64 file_size = 0;
+    s64 mtime = 0;
+
+    QString title;
+    QString serial;
+    QString category;
+    QString app_version;
+    QString content_id;
+    QString pkg_flags;
+
+    // Files inside the catalog cache, empty if the PKG does not ship them
+    std::filesystem::path icon_path;
+    std::filesystem::path pic_path;
+};
+
+/**
+ * Indexes folders of uninstalled PKGs. Only the header, the entry table and the unencrypted
+ * sce_sys entries (param.sfo, icon0.png, pic1.png) are read, the PFS image is never touched.
+ * Results are cached on disk and reused as long as the PKG size and mtime are unchanged.
+ */
+class PkgCatalog {
+public:
+    explicit PkgCatalog(std::filesystem::path cache_dir);
+
+    void LoadCache();
+    void SaveCache() const;
+
+    /** Collects all PKGs below dir, up to max_depth levels deep. */
+    static std::vector<std::filesystem::path> ScanFolder(const std::filesystem::path& dir,
+                                                         int max_depth);
+
+    /** Returns the catalog entry for a PKG, from the cache if it is still valid. Thread-safe. */
+    std::optional<PkgCatalogEntry> IndexPkg(const std::filesystem::path& pkg_path);
+
+    /** Drops cache records (and their images) of PKGs that do not exist anymore. */
+    void Prune();
+
+private:
+    std::filesystem::path GetImagePath(const std::string& key, std::string_view name) const;
+
+    std::filesystem::path m_cache_dir;
+    mutable std::mutex m_mutex;
+    std::map<std::string, PkgCatalogEntry> m_entries; // keyed by UTF-8 PKG path
+};
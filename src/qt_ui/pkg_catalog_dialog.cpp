@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "custom_table_widget_item.h"
+#include "gui_settings.h"
+#include "pkg_catalog_dialog.h"
+#include "qt_utils.h"
+
+#include "common/path_util.h"
+
+#include <QDialogButtonBox>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QLabel>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTableWidget>
+#include <QtConcurrent>
+#include <QVBoxLayout>
+
+namespace {
+constexpr int PkgIndexRole = Qt::UserRole;
+constexpr int CatalogScanDepth = 4;
+const QSize CatalogIconSize = QSize(48, 48);
+} // namespace
+
+PkgCatalogDialog::PkgCatalogDialog(std::shared_ptr<GUISettings> gui_settings, QWidget* parent)
+    : QDialog(parent), m_gui_settings(std::move(gui_settings)),
+      m_catalog(Common::FS::GetUserPath(Common::FS::PathType::CacheDir) / "pkg_catalog") {
+
+    auto* main_layout = new QVBoxLayout(this);
+
+    // Folder selection
+    auto* folder_layout = new QHBoxLayout();
+    m_folder_edit =
+        new QLineEdit(m_gui_settings->GetValue(GUI::general_pkg_catalog_dir).toString());
+    m_folder_edit->setReadOnly(true);
+    auto* browse_button = new QPushButton(tr("Browse"));
+    m_refresh_button = new QPushButton(tr("Refresh"));
+    folder_layout->addWidget(new QLabel(tr("PKG Folder:")));
+    folder_layout->addWidget(m_folder_edit, 1);
+    folder_layout->addWidget(browse_button);
+    folder_layout->addWidget(m_refresh_button);
+    main_layout->addLayout(folder_layout);
+
+    m_filter_edit = new QLineEdit();
+    m_filter_edit->setPlaceholderText(tr("Search..."));
+    m_filter_edit->setClearButtonEnabled(true);
+    main_layout->addWidget(m_filter_edit);
+
+    // Package list and pic1 preview
+    m_table = new QTableWidget(0, ColumnCount);
+    m_table->setHorizontalHeaderLabels({tr("Icon"), tr("Name"), tr("Serial"), tr("App Version"),
+                                        tr("Category"), tr("Type"), tr("Size"), tr("Path")});
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setIconSize(CatalogIconSize);
+    m_table->verticalHeader()->setVisible(false);
+    m_table->verticalHeader()->setDefaultSectionSize(CatalogIconSize.height() + 4);
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    m_table->setColumnWidth(Icon, CatalogIconSize.width() + 8);
+    m_table->setColumnWidth(Name, 260);
+    m_table->setAlternatingRowColors(true);
+
+    m_preview = new QLabel();
+    m_preview->setAlignment(Qt::AlignCenter);
+    m_preview->setMinimumWidth(320);
+
+    auto* splitter = new QSplitter(Qt::Horizontal);
+    splitter->addWidget(m_table);
+    splitter->addWidget(m_preview);
+    splitter->setStretchFactor(0, 3);
+    splitter->setStretchFactor(1, 1);
+    main_layout->addWidget(splitter, 1);
+
+    // Status and actions
+    auto* bottom_layout = new QHBoxLayout();
+    m_status = new QLabel();
+    auto* buttons = new QDialogButtonBox(QDialogButtonBox::Close);
+    m_install_button = buttons->addButton(tr("Install Selected"), QDialogButtonBox::ActionRole);
+    m_install_button->setEnabled(false);
+    bottom_layout->addWidget(m_status, 1);
+    bottom_layout->addWidget(buttons);
+    main_layout->addLayout(bottom_layout);
+
+    connect(browse_button, &QPushButton::clicked, this, [this] {
+        const QString dir = QFileDialog::getExistingDirectory(this, tr("Select PKG Folder"),
+                                                              m_folder_edit->text());
+        if (dir.isEmpty()) {
+            return;
+        }
+        m_folder_edit->setText(dir);
+        m_gui_settings->SetValue(GUI::general_pkg_catalog_dir, dir);
+        StartIndexing();
+    });
+    connect(m_refresh_button, &QPushButton::clicked, this, &PkgCatalogDialog::StartIndexing);
+    connect(m_filter_edit, &QLineEdit::textChanged, this, &PkgCatalogDialog::ApplyFilter);
+    connect(m_table, &QTableWidget::itemSelectionChanged, this,
+            &PkgCatalogDialog::OnSelectionChanged);
+    connect(m_install_button, &QPushButton::clicked, this, [this] {
+        m_pkgs_to_install = SelectedPkgs();
+        if (!m_pkgs_to_install.empty()) {
+            accept();
+        }
+    });
+    connect(buttons, &QDialogButtonBox::rejected, this, &QDialog::reject);
+    connect(&m_scan_watcher, &QFutureWatcher<std::vector<std::filesystem::path>>::finished, this,
+            &PkgCatalogDialog::OnScanFinished);
+    connect(&m_watcher, &QFutureWatcher<std::optional<IndexedPkg>>::progressValueChanged, this,
+            [this](int value) {
+                m_status->setText(
+                    tr("Indexing %1/%2...").arg(value).arg(m_watcher.progressMaximum()));
+            });
+    connect(&m_watcher, &QFutureWatcher<std::optional<IndexedPkg>>::finished, this,
+            &PkgCatalogDialog::OnIndexingFinished);
+
+    setWindowTitle(tr("shadLauncher4 - PKG Library"));
+    setWindowIcon(QIcon(":images/shadLauncher4.ico"));
+    resize(1100, 600);
+
+    m_catalog.LoadCache();
+    StartIndexing();
+}
+
+PkgCatalogDialog::~PkgCatalogDialog() {
+    GUI::Utils::StopFutureWatcher(m_scan_watcher, true);
+    GUI::Utils::StopFutureWatcher(m_watcher, true);
+}
+
+void PkgCatalogDialog::StartIndexing() {
+    const QString folder = m_folder_edit->text();
+    if (folder.isEmpty()) {
+        m_status->setText(tr("Select a folder containing PKG files."));
+        return;
+    }
+
+    GUI::Utils::StopFutureWatcher(m_scan_watcher, true);
+    GUI::Utils::StopFutureWatcher(m_watcher, true);
+    m_refresh_button->setEnabled(false);
+    m_table->setRowCount(0);
+    m_pkgs.clear();
+
+    const auto dir = Common::FS::PathFromQString(folder);
+    m_status->setText(tr("Scanning folder..."));
+    m_scan_watcher.setFuture(
+        QtConcurrent::run([dir] { return PkgCatalog::ScanFolder(dir, CatalogScanDepth); }));
+}
+
+void PkgCatalogDialog::OnScanFinished() {
+    if (m_scan_watcher.isCanceled()) {
+        return;
+    }
+
+    m_watcher.setFuture(QtConcurrent::mapped(
+        m_scan_watcher.result(),
+        [this](const std::filesystem::path& file) -> std::optional<IndexedPkg> {
+            auto entry = m_catalog.IndexPkg(file);
+            if (!entry) {
+                return std::nullopt;
+            }
+            QImage icon;
+            if (!entry->icon_path.empty()) {
+                QString icon_path;
+                Common::FS::PathToQString(icon_path, entry->icon_path);
+                icon = QImage(icon_path).scaled(CatalogIconSize, Qt::KeepAspectRatio,
+                                                Qt::SmoothTransformation);
+            }
+            return IndexedPkg{std::move(*entry), std::move(icon)};
+        }));
+}
+
+void PkgCatalogDialog::OnIndexingFinished() {
+    if (m_watcher.isCanceled()) {
+        return;
+    }
+
+    for (const auto& result : m_watcher.future().results()) {
+        if (result) {
+            m_pkgs.push_back(*result);
+        }
+    }
+
+    m_table->setSortingEnabled(false);
+    m_table->setRowCount(static_cast<int>(m_pkgs.size()));
+    for (int row = 0; row < static_cast<int>(m_pkgs.size()); ++row) {
+        const auto& pkg = m_pkgs[row].entry;
+
+        auto* icon_item = new QTableWidgetItem();
+        icon_item->setIcon(QPixmap::fromImage(m_pkgs[row].icon));
+        icon_item->setData(PkgIndexRole, row);
+
+        QString path;
+        Common::FS::PathToQString(path, pkg.filepath);
+
+        m_table->setItem(row, Icon, icon_item);
+        m_table->setItem(row, Name, new QTableWidgetItem(pkg.title));
+        m_table->setItem(row, Serial, new QTableWidgetItem(pkg.serial));
+        m_table->setItem(row, AppVersion, new QTableWidgetItem(pkg.app_version));
+        m_table->setItem(row, Category, new QTableWidgetItem(pkg.category));
+        m_table->setItem(row, Flags, new QTableWidgetItem(pkg.pkg_flags));
+        m_table->setItem(row, Size,
+                         new CustomTableWidgetItem(GUI::Utils::FormatByteSize(pkg.file_size),
+                                                   Qt::UserRole,
+                                                   QVariant::fromValue<qulonglong>(pkg.file_size)));
+        m_table->setItem(row, Path, new QTableWidgetItem(path));
+    }
+    m_table->setSortingEnabled(true);
+    m_table->sortByColumn(Name, Qt::AscendingOrder);
+
+    ApplyFilter(m_filter_edit->text());
+    m_refresh_button->setEnabled(true);
+    m_status->setText(tr("%n package(s)", nullptr, static_cast<int>(m_pkgs.size())));
+
+    m_catalog.Prune();
+    m_catalog.SaveCache();
+}
+
+void PkgCatalogDialog::OnSelectionChanged() {
+    const auto selected = m_table->selectionModel()->selectedRows(Icon);
+    m_install_button->setEnabled(!selected.isEmpty());
+
+    m_preview->clear();
+    if (selected.size() != 1) {
+        return;
+    }
+
+    const auto& pkg = m_pkgs[selected.front().data(PkgIndexRole).toInt()].entry;
+    if (pkg.pic_path.empty()) {
+        return;
+    }
+
+    QString pic_path;
+    Common::FS::PathToQString(pic_path, pkg.pic_path);
+    const QPixmap pic(pic_path);
+    if (!pic.isNull()) {
+        m_preview->setPixmap(pic.scaled(m_preview->size(), Qt::KeepAspectRatio,
+                                        Qt::SmoothTransformation));
+    }
+}
+
+void PkgCatalogDialog::ApplyFilter(const QString& text) {
+    for (int row = 0; row < m_table->rowCount(); ++row) {
+        const bool match = text.isEmpty() ||
+                           m_table->item(row, Name)->text().contains(text, Qt::CaseInsensitive) ||
+                           m_table->item(row, Serial)->text().contains(text, Qt::CaseInsensitive);
+        m_table->setRowHidden(row, !match);
+    }
+}
+
+std::vector<std::filesystem::path> PkgCatalogDialog::SelectedPkgs() const {
+    std::vector<std::filesystem::path> pkgs;
+    for (const auto& index : m_table->selectionModel()->selectedRows(Icon)) {
+        pkgs.push_back(m_pkgs[index.data(PkgIndexRole).toInt()].entry.filepath);
+    }
+    return pkgs;
+}
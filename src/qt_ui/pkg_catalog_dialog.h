@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <QDialog>
+#include <QFutureWatcher>
+#include <QImage>
+
+#include "pkg_catalog.h"
+
+class GUISettings;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QTableWidget;
+
+class PkgCatalogDialog final : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit PkgCatalogDialog(std::shared_ptr<GUISettings> gui_settings,
+                              QWidget* parent = nullptr);
+    ~PkgCatalogDialog() override;
+
+    /** PKGs the user picked with "Install Selected", valid once the dialog was accepted. */
+    const std::vector<std::filesystem::path>& GetPkgsToInstall() const {
+        return m_pkgs_to_install;
+    }
+
+private:
+    struct IndexedPkg {
+        PkgCatalogEntry entry;
+        QImage icon; // already scaled down on the worker thread
+    };
+
+    enum Columns { Icon = 0, Name, Serial, AppVersion, Category, Flags, Size, Path, ColumnCount };
+
+    void StartIndexing();
+    void OnScanFinished();
+    void OnIndexingFinished();
+    void OnSelectionChanged();
+    void ApplyFilter(const QString& text);
+    std::vector<std::filesystem::path> SelectedPkgs() const;
+
+    std::shared_ptr<GUISettings> m_gui_settings;
+    PkgCatalog m_catalog;
+    std::vector<IndexedPkg> m_pkgs;
+    std::vector<std::filesystem::path> m_pkgs_to_install;
+    QFutureWatcher<std::vector<std::filesystem::path>> m_scan_watcher;
+    QFutureWatcher<std::optional<IndexedPkg>> m_watcher;
+
+    QLineEdit* m_folder_edit = nullptr;
+    QLineEdit* m_filter_edit = nullptr;
+    QPushButton* m_refresh_button = nullptr;
+    QPushButton* m_install_button = nullptr;
+    QTableWidget* m_table = nullptr;
+    QLabel* m_preview = nullptr;
+    QLabel* m_status = nullptr;
+};
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include "core/pkg_install_target.h"
 #include "pkg_install_model.h"
 
 PkgInstallModel::PkgInstallModel(QObject* parent) : QAbstractTableModel(parent) {}
@@ -100,3 +102,33 @@ std::vector<PkgInfo> PkgInstallModel::selectedPkgs() const {
             out.push_back(m_pkgs[i]);
     return out;
 }
+
+static int PkgCategoryPriority(const QString& category) {
+    const QString c = category.toLower();
+
+    if (c.contains("game"))
+        return 0; // base game
+    if (c.contains("patch"))
+        return 1;  // patch
+    if (c == "ac") // DLC
+        return 2;
+
+    return 3; // unknown / others
+}
+
+void SortPkgsForInstall(std::vector<PkgInfo>& pkgs) {
+    std::sort(pkgs.begin(), pkgs.end(), [](const PkgInfo& a, const PkgInfo& b) {
+        // Group by title
+        if (a.serial != b.serial)
+            return a.serial < b.serial;
+
+        // GAME then PATCH then DLC
+        int pa = PkgCategoryPriority(a.category);
+        int pb = PkgCategoryPriority(b.category);
+        if (pa != pb)
+            return pa < pb;
+
+        // Version smaller to larger
+        return CompareAppVersions(a.app_version.toStdString(), b.app_version.toStdString()) < 0;
+    });
+}
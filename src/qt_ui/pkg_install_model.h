@@ -15,6 +15,10 @@ struct PkgInfo {
     std::filesystem::path filepath;
 };
 
+// Orders PKGs so a title's base game is installed before its patches and DLC, patches in
+// ascending version order.
+void SortPkgsForInstall(std::vector<PkgInfo>& pkgs);
+
 class PkgInstallModel final : public QAbstractTableModel {
     Q_OBJECT
 public:
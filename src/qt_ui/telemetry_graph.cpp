@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <QPainter>
+#include <QPolygonF>
+
+#include "core/ipc/ipc_client.h"
+#include "telemetry_graph.h"
+
+namespace {
+const QColor fps_color = QColor(80, 200, 80);
+const QColor frame_time_color = QColor(255, 160, 0);
+} // namespace
+
+TelemetryGraph::TelemetryGraph(std::shared_ptr<IpcClient> ipc_client, QWidget* parent)
+    : QWidget(parent), m_ipc_client(std::move(ipc_client)) {
+    connect(m_ipc_client.get(), &IpcClient::TelemetryUpdated, this,
+            QOverload<>::of(&QWidget::update));
+}
+
+QSize TelemetryGraph::sizeHint() const {
+    return QSize(640, 240);
+}
+
+void TelemetryGraph::paintEvent(QPaintEvent* event) {
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    painter.setPen(palette().text().color());
+
+    const TelemetryRing& ring = m_ipc_client->getTelemetry();
+    if (ring.Size() == 0) {
+        painter.drawText(rect(), Qt::AlignCenter | Qt::TextWordWrap,
+                         tr("No performance data. It is shown while a game runs on an emulator "
+                            "version that streams telemetry."));
+        return;
+    }
+
+    const TelemetrySample& last = ring[ring.Size() - 1];
+    const int line_height = fontMetrics().height();
+    painter.drawText(QRect(6, 4, width() - 12, line_height), Qt::AlignLeft | Qt::AlignVCenter,
+                     tr("%1 FPS | frame time p50 %2 ms, p95 %3 ms, p99 %4 ms | CPU %5% | "
+                        "GPU %6% | %7 MiB")
+                         .arg(last.fps, 0, 'f', 1)
+                         .arg(last.frame_time_p50, 0, 'f', 1)
+                         .arg(last.frame_time_p95, 0, 'f', 1)
+                         .arg(last.frame_time_p99, 0, 'f', 1)
+                         .arg(last.cpu_thread_util)
+                         .arg(last.gpu_thread_util)
+                         .arg(last.memory_mib));
+
+    const QRect plot = rect().adjusted(6, line_height * 2 + 12, -6, -6);
+    if (plot.width() <= 1 || plot.height() <= 1) {
+        return;
+    }
+
+    // One sample per pixel, the latest on the right. The scales start at 60 FPS and 33.3 ms.
+    const size_t count = std::min<size_t>(ring.Size(), plot.width());
+    const size_t first = ring.Size() - count;
+    float max_fps = 60.0f;
+    float max_frame_time = 1000.0f / 30.0f;
+    for (size_t i = first; i < ring.Size(); ++i) {
+        max_fps = std::max(max_fps, ring[i].fps);
+        max_frame_time = std::max(max_frame_time, ring[i].frame_time_p99);
+    }
+
+    painter.setPen(palette().mid().color());
+    for (int i = 0; i <= 4; ++i) {
+        const int y = plot.top() + plot.height() * i / 4;
+        painter.drawLine(plot.left(), y, plot.right(), y);
+    }
+
+    QPolygonF fps;
+    QPolygonF frame_time;
+    fps.reserve(count);
+    frame_time.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const TelemetrySample& sample = ring[first + i];
+        const qreal x = plot.right() - static_cast<qreal>(count - 1 - i);
+        fps.append(QPointF(x, plot.bottom() - sample.fps / max_fps * plot.height()));
+        frame_time.append(
+            QPointF(x, plot.bottom() - sample.frame_time_p99 / max_frame_time * plot.height()));
+    }
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(fps_color, 1.5));
+    painter.drawPolyline(fps);
+    painter.drawText(QRect(6, line_height + 8, width() / 2, line_height),
+                     Qt::AlignLeft | Qt::AlignVCenter,
+                     tr("FPS (top: %1)").arg(max_fps, 0, 'f', 0));
+    painter.setPen(QPen(frame_time_color, 1.5));
+    painter.drawPolyline(frame_time);
+    painter.drawText(QRect(width() / 2, line_height + 8, width() / 2 - 6, line_height),
+                     Qt::AlignRight | Qt::AlignVCenter,
+                     tr("p99 frame time (top: %1 ms)").arg(max_frame_time, 0, 'f', 1));
+}
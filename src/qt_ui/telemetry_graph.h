@@ -0,0 +1,25 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <memory>
+#include <QWidget>
+
+class IpcClient;
+
+/** Graph of the FPS and frame times streamed by the running emulator, with its latest sample. */
+class TelemetryGraph : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit TelemetryGraph(std::shared_ptr<IpcClient> ipc_client, QWidget* parent = nullptr);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    std::shared_ptr<IpcClient> m_ipc_client;
+};
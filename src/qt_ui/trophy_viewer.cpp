@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <QFile>
+#include <QHeaderView>
+#include <QLabel>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+#include <QXmlStreamReader>
+#include <QtConcurrent>
+#include "common/path_util.h"
+#include "core/file_format/trp.h"
+#include "trophy_viewer.h"
+
+namespace {
+
+QString TrophyTypeName(QStringView type) {
+    if (type == u"P") {
+        return QObject::tr("Platinum");
+    }
+    if (type == u"G") {
+        return QObject::tr("Gold");
+    }
+    if (type == u"S") {
+        return QObject::tr("Silver");
+    }
+    if (type == u"B") {
+        return QObject::tr("Bronze");
+    }
+    return type.toString();
+}
+
+} // namespace
+
+TrophyViewer::TrophyViewer(QWidget* parent, const GameInfo& game, const QString& userName)
+    : QDialog(parent) {
+    setAttribute(Qt::WA_DeleteOnClose);
+    setWindowTitle(tr("Trophy Viewer") + QString(" - %1 (%2)")
+                                             .arg(QString::fromStdString(game.name), userName));
+    resize(800, 600);
+
+    auto* layout = new QVBoxLayout(this);
+    m_status = new QLabel(tr("Extracting trophies..."), this);
+    layout->addWidget(m_status);
+
+    m_tree = new QTreeWidget(this);
+    m_tree->setColumnCount(4);
+    m_tree->setHeaderLabels({tr("Trophy"), tr("Type"), tr("Description"), tr("ID")});
+    m_tree->setIconSize(QSize(48, 48));
+    m_tree->setRootIsDecorated(false);
+    m_tree->header()->setSectionResizeMode(2, QHeaderView::Stretch);
+    layout->addWidget(m_tree);
+
+    // The update carries the trophy sets of the patched game when it has any
+    std::filesystem::path trophyPath =
+        Common::FS::PathFromQString(QString::fromStdString(game.update_path));
+    std::error_code ec;
+    if (game.update_path.empty() ||
+        !std::filesystem::exists(trophyPath / "sce_sys" / "trophy", ec)) {
+        trophyPath = Common::FS::PathFromQString(QString::fromStdString(game.path));
+    }
+    const std::string serial = game.serial;
+    const auto trophyFilesDir =
+        Common::FS::GetUserPath(Common::FS::PathType::MetaDataDir) / serial / "TrophyFiles";
+
+    connect(&m_watcher, &QFutureWatcher<bool>::finished, this, [this, trophyFilesDir] {
+        const int count = Populate(trophyFilesDir);
+        if (!m_watcher.result()) {
+            m_status->setText(tr("Some trophy files could not be extracted."));
+        } else if (count == 0) {
+            m_status->setText(tr("This game has no trophies."));
+        } else {
+            m_status->setText(tr("%1 trophies").arg(count));
+        }
+    });
+    m_watcher.setFuture(QtConcurrent::run([trophyPath, serial] {
+        TRP trp;
+        return trp.Extract(trophyPath, serial);
+    }));
+}
+
+int TrophyViewer::Populate(const std::filesystem::path& trophyFilesDir) {
+    std::error_code ec;
+    int count = 0;
+    for (const auto& set : std::filesystem::directory_iterator(trophyFilesDir, ec)) {
+        QString xmlPath;
+        Common::FS::PathToQString(xmlPath, set.path() / "Xml" / "TROP.XML");
+        QFile xmlFile(xmlPath);
+        if (!xmlFile.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        QXmlStreamReader xml(&xmlFile);
+        QTreeWidgetItem* item = nullptr;
+        while (!xml.atEnd()) {
+            if (!xml.readNextStartElement()) {
+                continue;
+            }
+            if (xml.name() == u"trophy") {
+                const QString id = xml.attributes().value("id").toString();
+                item = new QTreeWidgetItem(m_tree);
+                item->setText(1, TrophyTypeName(xml.attributes().value("ttype")));
+                item->setText(3, id);
+
+                QString iconPath;
+                Common::FS::PathToQString(iconPath, set.path() / "Icons" /
+                                                        ("TROP" + id.toStdString() + ".PNG"));
+                item->setIcon(0, QIcon(iconPath));
+                ++count;
+            } else if (item && xml.name() == u"name") {
+                item->setText(0, xml.readElementText());
+            } else if (item && xml.name() == u"detail") {
+                item->setText(2, xml.readElementText());
+            }
+        }
+    }
+    m_tree->resizeColumnToContents(0);
+    return count;
+}
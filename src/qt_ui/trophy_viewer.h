@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: Copyright 2025-2026 shadLauncher4 Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <QDialog>
+#include <QFutureWatcher>
+#include "game_info.h"
+
+class QLabel;
+class QTreeWidget;
+
+/**
+ * Lists the trophies of a game with their icons. The trophy sets are extracted by TRP::Extract on
+ * a worker when the viewer opens; sets extracted before with the same TRP digest are skipped.
+ */
+class TrophyViewer : public QDialog {
+    Q_OBJECT
+public:
+    TrophyViewer(QWidget* parent, const GameInfo& game, const QString& userName);
+
+private:
+    /// Adds the trophies of every extracted set, returns how many there are.
+    int Populate(const std::filesystem::path& trophyFilesDir);
+
+    QLabel* m_status = nullptr;
+    QTreeWidget* m_tree = nullptr;
+    QFutureWatcher<bool> m_watcher;
+};
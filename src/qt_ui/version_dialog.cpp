@@ -17,17 +17,42 @@
 #include <QRegularExpression>
 #include <QTextBrowser>
 #include <QTextStream>
+#include <QThreadPool>
 #include <QTimer>
 #include <QVBoxLayout>
+#include <QtConcurrent>
 #include <common/path_util.h>
+#include <common/version_store.h>
 #include <common/versions.h>
 #include <common/zip_util.h>
 #include "gui_settings.h"
+#include "network_service.h"
 #include "qt_ui/main_window.h"
 #include "qt_utils.h"
 #include "ui_version_dialog.h"
 #include "version_dialog.h"
 
+namespace {
+
+// GitHub publishes the digest of release assets as "sha256:<hex>"
+QByteArray AssetSha256(const QJsonObject& asset) {
+    const QString digest = asset["digest"].toString();
+    return digest.startsWith("sha256:") ? digest.mid(7).toLatin1() : QByteArray();
+}
+
+// Runs the store passes and collections of every dialog one at a time, in the order they were
+// queued. Quitting waits for the queued work.
+QThreadPool* VersionStorePool() {
+    static QThreadPool* pool = [] {
+        auto* pool = new QThreadPool(qApp);
+        pool->setMaxThreadCount(1);
+        return pool;
+    }();
+    return pool;
+}
+
+} // namespace
+
 VersionDialog::VersionDialog(std::shared_ptr<GUISettings> gui_settings, QWidget* parent)
     : QDialog(parent), ui(new Ui::VersionDialog), m_gui_settings(std::move(gui_settings)) {
     ui->setupUi(this);
@@ -51,7 +76,7 @@ VersionDialog::VersionDialog(std::shared_ptr<GUISettings> gui_settings, QWidget*
 
     connect(this, &VersionDialog::WindowResized, this, &VersionDialog::HandleResize);
 
-    networkManager = new QNetworkAccessManager(this);
+    networkManager = NetworkService::instance().GetManager();
 
     if (m_gui_settings->GetValue(GUI::version_manager_versionPath).toString() == "") {
         QString versionDir = QString::fromStdString(
@@ -142,6 +167,8 @@ VersionDialog::VersionDialog(std::shared_ptr<GUISettings> gui_settings, QWidget*
 
         QString destFolder = QDir(versionsRoot).filePath(version_name);
         QDir().mkpath(destFolder);
+        // A queued store pass may still walk a removed version of the same name
+        VersionStorePool()->waitForDone();
 
         QFileInfo srcInfo(exePath);
         QString destExePath = QDir(destFolder).filePath(srcInfo.fileName());
@@ -174,14 +201,8 @@ VersionDialog::VersionDialog(std::shared_ptr<GUISettings> gui_settings, QWidget*
         QString appExePath = appDir + "/shadPS4.app/Contents/MacOS/shadPS4";
 #endif
 
-        if (QFile::exists(appExePath)) {
-            QString backupPath = appExePath + ".backup";
-            if (QFile::exists(backupPath))
-                QFile::remove(backupPath);
-            QFile::rename(appExePath, backupPath);
-        }
-
-        if (!QFile::copy(destExePath, appExePath)) {
+        if (!VersionManager::ActivateExecutable(Common::FS::PathFromQString(destExePath),
+                                                Common::FS::PathFromQString(appExePath))) {
             QMessageBox::warning(this, tr("Warning"),
                                  tr("Failed to install executable into application directory.\n"
                                     "The custom build is still available under:\n%1")
@@ -194,6 +215,7 @@ VersionDialog::VersionDialog(std::shared_ptr<GUISettings> gui_settings, QWidget*
                                 QFile::ExeOther);
 #endif
         }
+        AddToVersionStore(destFolder);
 
         VersionManager::Version new_version{
             .name = version_name.toStdString(),
@@ -279,6 +301,10 @@ VersionDialog::VersionDialog(std::shared_ptr<GUISettings> gui_settings, QWidget*
                                           QString("\n \"%1\"").arg(folderPath));
                 return;
             }
+            // Blobs only the deleted version linked to, queued like AddToVersionStore
+            (void)QtConcurrent::run(VersionStorePool(), [store_dir = VersionStorePath()] {
+                VersionManager::CollectStoreGarbage(store_dir);
+            });
         }
 
         VersionManager::RemoveVersion(versionName.toStdString());
@@ -307,6 +333,23 @@ void VersionDialog::HandleResize(QResizeEvent* event) {
     this->ui->versionTab->resize(this->size());
 }
 
+std::filesystem::path VersionDialog::VersionStorePath() const {
+    // Beside the versions, hard links cannot cross volumes
+    return Common::FS::PathFromQString(
+               m_gui_settings->GetValue(GUI::version_manager_versionPath).toString()) /
+           ".store";
+}
+
+void VersionDialog::AddToVersionStore(const QString& versionFolder) {
+    // Hashes every file of the version, so it is queued on the store worker. Only the next
+    // install into a version folder waits for it.
+    (void)QtConcurrent::run(VersionStorePool(),
+                            [version_dir = Common::FS::PathFromQString(versionFolder),
+                             store_dir = VersionStorePath()] {
+                                VersionManager::AddToStore(version_dir, store_dir);
+                            });
+}
+
 bool VersionDialog::CopyExecutableToAppDir(const QString& sourceExe, QWidget* parent) {
     if (sourceExe.isEmpty() || !QFile::exists(sourceExe)) {
         QMessageBox::warning(parent, QObject::tr("Error"),
@@ -324,13 +367,8 @@ bool VersionDialog::CopyExecutableToAppDir(const QString& sourceExe, QWidget* pa
     QString appExePath = appDir + "/shadPS4.app/Contents/MacOS/shadPS4";
 #endif
 
-    if (QFile::exists(appExePath)) {
-        QString backupPath = appExePath + ".backup";
-        QFile::remove(backupPath);
-        QFile::rename(appExePath, backupPath);
-    }
-
-    if (!QFile::copy(sourceExe, appExePath)) {
+    if (!VersionManager::ActivateExecutable(Common::FS::PathFromQString(sourceExe),
+                                            Common::FS::PathFromQString(appExePath))) {
         QMessageBox::warning(parent, QObject::tr("Error"),
                              QObject::tr("Failed to copy executable to application directory."));
         return false;
@@ -429,7 +467,7 @@ tr("First you need to choose a location to save the versions in\n'Path to save v
                 return;
             }
 
-            QNetworkAccessManager* manager = new QNetworkAccessManager(this);
+            QNetworkAccessManager* manager = NetworkService::instance().GetManager();
             QNetworkRequest request(apiUrl);
             QNetworkReply* reply = manager->get(request);
 
@@ -459,10 +497,14 @@ tr("First you need to choose a location to save the versions in\n'Path to save v
                 }
 
                 QString downloadUrl;
+                QByteArray sha256;
+                qint64 size = -1;
                 for (const QJsonValue& val : assets) {
                     QJsonObject obj = val.toObject();
                     if (obj["name"].toString().contains(platform)) {
                         downloadUrl = obj["browser_download_url"].toString();
+                        sha256 = AssetSha256(obj);
+                        size = obj["size"].toInteger(-1);
                         break;
                     }
                 }
@@ -478,9 +520,6 @@ tr("First you need to choose a location to save the versions in\n'Path to save v
                 QString zipPath = QDir(userPath).filePath("temp_download_update.zip");
 
                 disconnect(m_downloader, nullptr, this, nullptr);
-                m_downloader->DownloadJSONWithCache(downloadUrl.toStdString(), zipPath, true,
-                                                    tr("Downloading") + " " + versionName, 0);
-
                 connect(m_downloader, &Downloader::SignalDownloadError, this,
                         [this](const QString& err) {
                             QMessageBox::warning(this, tr("Error"),
@@ -522,7 +561,8 @@ tr("First you need to choose a location to save the versions in\n'Path to save v
                             QString appExePath = appDir + "/shadPS4.app/Contents/MacOS/shadPS4";
 #endif
 
-                        // extract ZIP to version folder
+                        // extract ZIP to version folder, after the store passes still walking it
+                        VersionStorePool()->waitForDone();
                         try {
                             Zip::Extract(zipPath, destFolder);
                             QFile::remove(zipPath);
@@ -567,16 +607,9 @@ tr("First you need to choose a location to save the versions in\n'Path to save v
                         // Copy to application directory
                         bool copySuccess = false;
 
-                        if (QFile::exists(appExePath)) {
-                            // Create backup of old executable
-                            QString backupPath = appExePath + ".backup";
-                            if (QFile::exists(backupPath)) {
-                                QFile::remove(backupPath);
-                            }
-                            QFile::rename(appExePath, backupPath);
-                        }
-
-                        if (QFile::copy(versionExePath, appExePath)) {
+                        if (VersionManager::ActivateExecutable(
+                                Common::FS::PathFromQString(versionExePath),
+                                Common::FS::PathFromQString(appExePath))) {
                             copySuccess = true;
 #ifdef Q_OS_LINUX
                             // Set executable permissions
@@ -587,6 +620,7 @@ tr("First you need to choose a location to save the versions in\n'Path to save v
                                                 QFile::ExeOther);
 #endif
                         }
+                        AddToVersionStore(destFolder);
 
                         if (!copySuccess) {
                             QMessageBox::warning(this, tr("Error"),
@@ -644,6 +678,9 @@ tr("Failed to copy executable to application directory.\nThe version has been sa
                         LoadInstalledList();
                     });
 
+                m_downloader->DownloadFile(downloadUrl.toStdString(), zipPath, sha256, size,
+                                           true, tr("Downloading") + " " + versionName);
+
                 reply->deleteLater();
             });
         });
@@ -852,7 +889,7 @@ void VersionDialog::checkUpdatePre(const bool showMessage) {
         return;
     }
 
-    QNetworkAccessManager* manager = new QNetworkAccessManager(this);
+    QNetworkAccessManager* manager = NetworkService::instance().GetManager();
     QNetworkRequest request(QUrl("https://api.github.com/repos/shadps4-emu/shadPS4/releases"));
     QNetworkReply* reply = manager->get(request);
 
@@ -1063,7 +1100,7 @@ void VersionDialog::installPreReleaseByTag(const QString& tagName) {
     QString apiUrl =
         QString("https://api.github.com/repos/shadps4-emu/shadPS4/releases/tags/%1").arg(tagName);
 
-    QNetworkAccessManager* mgr = new QNetworkAccessManager(this);
+    QNetworkAccessManager* mgr = NetworkService::instance().GetManager();
     QNetworkRequest req(apiUrl);
     QNetworkReply* reply = mgr->get(req);
 
@@ -1080,6 +1117,7 @@ void VersionDialog::installPreReleaseByTag(const QString& tagName) {
         QJsonArray assets = obj["assets"].toArray();
 
         QString downloadUrl;
+        QByteArray sha256;
         QString platformStr;
 #ifdef Q_OS_WIN
         platformStr = "win64-sdl";
@@ -1092,6 +1130,7 @@ void VersionDialog::installPreReleaseByTag(const QString& tagName) {
             QJsonObject aobj = av.toObject();
             if (aobj["name"].toString().contains(platformStr)) {
                 downloadUrl = aobj["browser_download_url"].toString();
+                sha256 = AssetSha256(aobj);
                 break;
             }
         }
@@ -1101,13 +1140,14 @@ void VersionDialog::installPreReleaseByTag(const QString& tagName) {
             reply->deleteLater();
             return;
         }
-        showDownloadDialog(tagName, downloadUrl);
+        showDownloadDialog(tagName, downloadUrl, sha256);
 
         reply->deleteLater();
     });
 }
 
-void VersionDialog::showDownloadDialog(const QString& tagName, const QString& downloadUrl) {
+void VersionDialog::showDownloadDialog(const QString& tagName, const QString& downloadUrl,
+                                       const QByteArray& sha256) {
     QString userPath = m_gui_settings->GetValue(GUI::version_manager_versionPath).toString();
     QString zipPath = QDir(userPath).filePath("temp_pre_release_download.zip");
     QString appDir = QCoreApplication::applicationDirPath();
@@ -1122,9 +1162,6 @@ void VersionDialog::showDownloadDialog(const QString& tagName, const QString& do
 
     disconnect(m_downloader, nullptr, this, nullptr);
 
-    m_downloader->DownloadJSONWithCache(downloadUrl.toStdString(), zipPath, true,
-                                        tr("Downloading Pre-release (Nightly)"), 0);
-
     connect(m_downloader, &Downloader::SignalDownloadError, this, [this](const QString& err) {
         QMessageBox::warning(this, tr("Error"),
                              tr("Network error while downloading") + ":\n" + err);
@@ -1135,6 +1172,8 @@ void VersionDialog::showDownloadDialog(const QString& tagName, const QString& do
         [this, userPath, zipPath, appExePath, tagName]() {
             QString destFolder = QDir(userPath).filePath("Pre-release");
 
+            // After the store passes still walking the previous pre-release
+            VersionStorePool()->waitForDone();
             try {
                 Zip::Extract(zipPath, destFolder);
                 QFile::remove(zipPath);
@@ -1189,17 +1228,10 @@ void VersionDialog::showDownloadDialog(const QString& tagName, const QString& do
                 return;
             }
 
-            if (QFile::exists(appExePath)) {
-                // Create backup of old executable
-                QString backupPath = appExePath + ".backup";
-                if (QFile::exists(backupPath)) {
-                    QFile::remove(backupPath);
-                }
-                QFile::rename(appExePath, backupPath);
-            }
-
-            // Copy to application directory
-            bool copySuccess = QFile::copy(versionExePath, appExePath);
+            // Link into the application directory
+            bool copySuccess =
+                VersionManager::ActivateExecutable(Common::FS::PathFromQString(versionExePath),
+                                                   Common::FS::PathFromQString(appExePath));
 
 #ifdef Q_OS_LINUX
             // Set executable permissions
@@ -1210,6 +1242,7 @@ void VersionDialog::showDownloadDialog(const QString& tagName, const QString& do
                                     QFile::ExeOther);
             }
 #endif
+            AddToVersionStore(destFolder);
 
             if (!copySuccess) {
                 QMessageBox::warning(this, tr("Error"),
@@ -1246,4 +1279,7 @@ tr("Failed to copy executable to application directory.\nThe pre-release version
 
                 LoadInstalledList();
             });
+
+    m_downloader->DownloadFile(downloadUrl.toStdString(), zipPath, sha256, -1, true,
+                               tr("Downloading Pre-release (Nightly)"));
 }
\ No newline at end of file
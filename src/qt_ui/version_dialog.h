@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <filesystem>
 #include <QDialog>
 #include <QTextBrowser>
 #include <QTreeWidget>
@@ -44,8 +45,12 @@ private:
     void requestChangelog(const QString& localHash, const QString& latestHash,
                           const QString& latestTag, QTextBrowser* outputView);
     void installPreReleaseByTag(const QString& tagName);
-    void showDownloadDialog(const QString& tagName, const QString& downloadUrl);
+    void showDownloadDialog(const QString& tagName, const QString& downloadUrl,
+                            const QByteArray& sha256 = {});
     bool CopyExecutableToAppDir(const QString& sourceExe, QWidget* parent);
+    std::filesystem::path VersionStorePath() const;
+    /// Queues sharing the files of an installed version with the other versions, see AddToStore
+    void AddToVersionStore(const QString& versionFolder);
     Downloader* m_downloader = nullptr;
 
 protected: